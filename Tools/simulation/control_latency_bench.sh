@@ -0,0 +1,57 @@
+#!/bin/bash
+# Run the control_latency benchmark (gyro to actuator output latency) headless in SITL with SIH.
+# It assumes px4 is already built without lockstep, with 'make px4_sitl_nolockstep'
+#
+# usage: control_latency_bench.sh [duration_s] [load_percent] [load_work_queue]
+# e.g.   control_latency_bench.sh 30 40 rate_ctrl
+#
+# Set ARM=1 to arm the vehicle during the measurement.
+
+duration=${1:-20}
+load=${2:-0}
+load_wq=${3:-rate_ctrl}
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+src_path="$SCRIPT_DIR/../.."
+
+build_path=${BUILD_PATH:-${src_path}/build/px4_sitl_nolockstep}
+
+if [ ! -x "$build_path/bin/px4" ]; then
+	echo "px4 binary not found in $build_path, build with 'make px4_sitl_nolockstep'"
+	exit 1
+fi
+
+working_dir="$build_path/control_latency_bench"
+mkdir -p "$working_dir"
+
+export PX4_SIM_MODEL=sihsim_quadx
+export HEADLESS=1
+
+pushd "$working_dir" &>/dev/null
+echo "starting px4 (SIH) in $(pwd)"
+"$build_path/bin/px4" -d "$build_path/etc" >out.log 2>err.log &
+px4_pid=$!
+popd &>/dev/null
+
+trap 'kill $px4_pid 2>/dev/null; wait $px4_pid 2>/dev/null' EXIT
+
+# wait for the system to boot and the estimator to converge
+sleep 10
+
+if [ "$ARM" = "1" ]; then
+	"$build_path/bin/px4-commander" arm -f
+	sleep 1
+fi
+
+"$build_path/bin/px4-control_latency" start -d "$duration" -l "$load" -q "$load_wq" || exit 1
+
+sleep $((duration + 1))
+
+"$build_path/bin/px4-control_latency" status
+"$build_path/bin/px4-pwm_out_sim" status
+
+if [ "$ARM" = "1" ]; then
+	"$build_path/bin/px4-commander" disarm -f
+fi
+
+"$build_path/bin/px4-control_latency" stop
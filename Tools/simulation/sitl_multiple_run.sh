@@ -1,16 +1,27 @@
 #!/bin/bash
-# run multiple instances of the 'px4' binary, but w/o starting the simulator.
+# run multiple instances of the 'px4' binary
 # It assumes px4 is already built, with 'make px4_sitl_default'
+#
+# Usage: sitl_multiple_run.sh [num_instances] [model]
 
-# The simulator is expected to send to TCP port 4560+i for i in [0, N-1]
+# For external simulator models (default: gazebo-classic_iris) the simulator is not
+# started, it is expected to send to TCP port 4560+i for i in [0, N-1]
 # For example jmavsim can be run like this:
 #./Tools/simulation/jmavsim/jmavsim_run.sh -p 4561 -l
 
+# SIH models (sihsim_quadx, sihsim_airplane, sihsim_xvert) simulate inside every instance,
+# each instance steps its own vehicle in lockstep in parallel. No external simulator is needed
+# and the swarm can run faster than realtime, e.g.
+# PX4_SIM_SPEED_FACTOR=4 ./Tools/simulation/sitl_multiple_run.sh 8 sihsim_quadx
+
 sitl_num=2
 [ -n "$1" ] && sitl_num="$1"
 
+sim_model=gazebo-classic_iris
+[ -n "$2" ] && sim_model="$2"
+
 SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
-src_path="$SCRIPT_DIR/.."
+src_path="$SCRIPT_DIR/../.."
 
 build_path=${src_path}/build/px4_sitl_default
 
@@ -19,7 +30,11 @@ pkill -x px4 || true
 
 sleep 1
 
-export PX4_SIM_MODEL=gazebo-classic_iris
+export PX4_SIM_MODEL=$sim_model
+
+if [[ $sim_model == sihsim_* ]]; then
+	export PX4_SIMULATOR=sihsim
+fi
 
 n=0
 while [ $n -lt $sitl_num ]; do
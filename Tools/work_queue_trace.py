@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+
+"""
+Convert the work queue trace of a ULog file (work_item_trace topic, logged with
+SDLOG_PROFILE bit 11 on a build with CONFIG_WORK_QUEUE_TRACE) into the Chrome
+trace event format (JSON), which can be opened in chrome://tracing or
+https://ui.perfetto.dev.
+
+Each work queue is shown as a thread, each WorkItem run as a slice. The
+scheduling latency (start time - schedule time) is added as slice argument and
+as a flow event from the schedule to the start time.
+
+Install: pip install pyulog
+"""
+
+import argparse
+import json
+import sys
+
+try:
+    from pyulog import ULog
+except ImportError as e:
+    print("Failed to import pyulog: " + str(e))
+    print("")
+    print("You may need to install it with:")
+    print("    pip3 install --user pyulog")
+    print("")
+    sys.exit(1)
+
+
+def parse_names(ulog):
+    """ parse the 'wq_trace_names' info messages into work queue and item name maps """
+    wq_names = {}
+    item_names = {}
+
+    for entries in ulog.msg_info_multiple_dict.get('wq_trace_names', []):
+        for entry in entries:
+            fields = entry.strip().split(' ', 3)
+
+            if fields[0] == 'q' and len(fields) >= 3:
+                wq_names[int(fields[1])] = ' '.join(fields[2:])
+
+            elif fields[0] == 'i' and len(fields) >= 4:
+                item_names[int(fields[1])] = fields[3]
+
+    return wq_names, item_names
+
+
+def convert(ulog, flows, start_time, end_time):
+    wq_names, item_names = parse_names(ulog)
+
+    try:
+        trace = ulog.get_dataset('work_item_trace').data
+    except (KeyError, IndexError, ValueError):
+        print("no work_item_trace data in log")
+        sys.exit(1)
+
+    events = []
+    dropped = {}
+    latency = {}
+
+    for wq_index, name in wq_names.items():
+        events.append({'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': wq_index, 'args': {'name': name}})
+
+    flow_id = 0
+
+    for msg_index, timestamp in enumerate(trace['timestamp']):
+        wq_index = int(trace['wq_index'][msg_index])
+        dropped[wq_index] = dropped.get(wq_index, 0) + int(trace['dropped'][msg_index])
+
+        for i in range(int(trace['count'][msg_index])):
+            item_id = int(trace['item_id[%i]' % i][msg_index])
+            scheduled = int(timestamp) + int(trace['schedule_offset[%i]' % i][msg_index])
+            start_delay = int(trace['start_delay[%i]' % i][msg_index])
+            start = scheduled + start_delay
+            run_time = int(trace['run_time[%i]' % i][msg_index])
+
+            if start < start_time or start > end_time:
+                continue
+
+            name = item_names.get(item_id, 'item %i' % item_id)
+            latency.setdefault(name, []).append(start_delay)
+
+            events.append({'name': name, 'cat': 'work_item', 'ph': 'X', 'pid': 0, 'tid': wq_index,
+                           'ts': start, 'dur': run_time,
+                           'args': {'schedule_latency_us': start_delay, 'item_id': item_id}})
+
+            if flows and start_delay > 0:
+                flow_id += 1
+                events.append({'name': 'schedule', 'cat': 'schedule', 'ph': 's', 'id': flow_id, 'pid': 0,
+                               'tid': wq_index, 'ts': scheduled})
+                events.append({'name': 'schedule', 'cat': 'schedule', 'ph': 'f', 'bp': 'e', 'id': flow_id, 'pid': 0,
+                               'tid': wq_index, 'ts': start})
+
+    return events, dropped, latency, wq_names
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a ULog work queue trace to Chrome trace (JSON) format')
+    parser.add_argument('ulog_file', help='ULog file')
+    parser.add_argument('-o', '--output', help='output file (default: <ulog_file>.trace.json)')
+    parser.add_argument('--flows', action='store_true', help='add schedule -> start flow events')
+    parser.add_argument('--start', type=float, default=0, help='start time (seconds since boot)')
+    parser.add_argument('--end', type=float, default=float('inf'), help='end time (seconds since boot)')
+    args = parser.parse_args()
+
+    ulog = ULog(args.ulog_file, ['work_item_trace'])
+
+    events, dropped, latency, wq_names = convert(ulog, args.flows, args.start * 1e6, args.end * 1e6)
+
+    output = args.output if args.output else args.ulog_file + '.trace.json'
+
+    with open(output, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ms'}, f)
+
+    print("wrote {:} events to {:}".format(len(events), output))
+
+    for wq_index, count in sorted(dropped.items()):
+        if count > 0:
+            print("WARNING: {:} dropped {:} records".format(wq_names.get(wq_index, wq_index), count))
+
+    print("{:<40} {:>8} {:>10} {:>10}".format('work item', 'runs', 'mean [us]', 'max [us]'))
+
+    for name, delays in sorted(latency.items()):
+        print("{:<40} {:>8} {:>10.1f} {:>10}".format(name, len(delays), sum(delays) / len(delays), max(delays)))
+
+
+if __name__ == '__main__':
+    main()
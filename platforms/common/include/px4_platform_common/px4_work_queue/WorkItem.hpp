@@ -83,6 +83,10 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	uint16_t TraceId() const { return _trace_id; }
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -108,7 +112,7 @@ protected:
 		}
 	}
 
-	friend void WorkQueue::Run();
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -130,6 +134,11 @@ protected:
 	const char 	*_item_name;
 	uint32_t	_run_count{0};
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	hrt_abstime	_time_scheduled {0}; // time the item was queued (0 if not queued)
+	uint16_t	_trace_id{0};
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 private:
 
 	WorkQueue	*_wq{nullptr};
@@ -42,6 +42,7 @@
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/sem.h>
 #include <px4_platform_common/tasks.h>
+#include <drivers/drv_hrt.h>
 
 namespace px4
 {
@@ -73,6 +74,24 @@ public:
 
 	void print_status(bool last = false);
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	static void trace_enable(bool enable) { _trace_enabled.store(enable); }
+	static bool trace_enabled() { return _trace_enabled.load(); }
+
+	// unique index of this work queue in the trace, assigned at creation
+	uint8_t trace_index() const { return _trace_index; }
+
+	/**
+	 * Copy (and remove) up to max_records from the trace buffer. Must only be called from a single consumer.
+	 * @param dropped number of records lost due to buffer overflow since the last call
+	 * @return number of records copied
+	 */
+	size_t trace_drain(wq_trace_record_t *records, size_t max_records, uint32_t &dropped);
+	void trace_clear();
+
+	void trace_names(WorkQueueTraceNameCallback callback, void *arg);
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	// WorkQueues sorted numerically by relative priority (-1 to -255)
 	bool operator<=(const WorkQueue &rhs) const { return _config.relative_priority >= rhs.get_config().relative_priority; }
 
@@ -105,6 +124,23 @@ private:
 	int _lockstep_component {-1};
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	// single producer (this work queue thread), single consumer (logger) ring buffer
+	void trace_record(uint16_t item_id, hrt_abstime time_scheduled, hrt_abstime time_start, hrt_abstime time_end);
+
+	static constexpr uint32_t TRACE_RECORDS = CONFIG_WORK_QUEUE_TRACE_RECORDS;
+	static_assert((TRACE_RECORDS & (TRACE_RECORDS - 1)) == 0, "CONFIG_WORK_QUEUE_TRACE_RECORDS must be a power of 2");
+
+	wq_trace_record_t		_trace_buffer[TRACE_RECORDS] {};
+	px4::atomic<uint32_t>		_trace_head{0};
+	px4::atomic<uint32_t>		_trace_tail{0};
+	px4::atomic<uint32_t>		_trace_dropped{0};
+
+	uint8_t				_trace_index{0};
+
+	static px4::atomic_bool		_trace_enabled;
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 };
 
 } // namespace px4
@@ -33,6 +33,9 @@
 
 #pragma once
 
+#include <px4_platform_common/defines.h>
+
+#include <stddef.h>
 #include <stdint.h>
 
 namespace px4
@@ -76,6 +79,18 @@ static constexpr wq_config_t hp_default{"wq:hp_default", 1900, -18};
 
 static constexpr wq_config_t uavcan{"wq:uavcan", 3624, -19};
 
+// one work queue per multi-EKF instance (CONFIG_EKF2_MULTI_INSTANCE_PARALLEL), all instances with the same priority
+// below the INS work queues of the IMU producers (a producer is never blocked behind an estimator instance)
+static constexpr wq_config_t EKF0{"wq:EKF0", 6000, -20};
+static constexpr wq_config_t EKF1{"wq:EKF1", 6000, -20};
+static constexpr wq_config_t EKF2{"wq:EKF2", 6000, -20};
+static constexpr wq_config_t EKF3{"wq:EKF3", 6000, -20};
+static constexpr wq_config_t EKF4{"wq:EKF4", 6000, -20};
+static constexpr wq_config_t EKF5{"wq:EKF5", 6000, -20};
+static constexpr wq_config_t EKF6{"wq:EKF6", 6000, -20};
+static constexpr wq_config_t EKF7{"wq:EKF7", 6000, -20};
+static constexpr wq_config_t EKF8{"wq:EKF8", 6000, -20};
+
 static constexpr wq_config_t ttyS0{"wq:ttyS0", 1728, -21};
 static constexpr wq_config_t ttyS1{"wq:ttyS1", 1728, -22};
 static constexpr wq_config_t ttyS2{"wq:ttyS2", 1728, -23};
@@ -137,5 +152,52 @@ const wq_config_t &serial_port_to_wq(const char *serial);
 
 const wq_config_t &ins_instance_to_wq(uint8_t instance);
 
+/**
+ * Map a multi-EKF instance to a dedicated work queue configuration
+ */
+const wq_config_t &ekf_instance_to_wq(uint8_t instance);
+
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+struct wq_trace_record_t {
+	uint64_t time_scheduled; // time the WorkItem was added to the queue
+	uint64_t time_start;     // time WorkItem::Run() was called
+	uint32_t run_time;       // duration of WorkItem::Run() (microseconds)
+	uint16_t item_id;        // WorkItem trace id
+};
+
+/**
+ * Enable or disable recording of WorkItem runs into the per work queue trace buffers.
+ * Disabling also discards all records that haven't been drained yet.
+ */
+void WorkQueueTraceEnable(bool enable);
+
+typedef void (*WorkQueueTraceDrainCallback)(const wq_config_t &config, uint8_t wq_index,
+		const wq_trace_record_t *records, size_t num_records, uint32_t dropped, void *arg);
+
+/**
+ * Drain the trace buffers of all work queues. The callback is called for every batch of records
+ * copied into records (at most max_records each) with the unique trace index of the work queue.
+ * Must only be called from a single thread.
+ */
+void WorkQueueTraceDrain(wq_trace_record_t *records, size_t max_records, WorkQueueTraceDrainCallback callback,
+			 void *arg);
+
+typedef void (*WorkQueueTraceNameCallback)(const wq_config_t &config, uint8_t wq_index, int item_id,
+		const char *item_name, void *arg);
+
+/**
+ * Iterate all work queues and WorkItems to get the mapping of trace ids to names.
+ * The callback is called once per work queue with item_id = -1, followed by all of its WorkItems.
+ */
+void WorkQueueTraceNames(WorkQueueTraceNameCallback callback, void *arg);
+
+/**
+ * @return the highest WorkItem trace id assigned so far
+ */
+int WorkQueueTraceMaxItemId();
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 
 } // namespace px4
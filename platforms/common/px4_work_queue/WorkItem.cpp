@@ -42,9 +42,22 @@
 namespace px4
 {
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+static px4::atomic<int> _trace_next_item_id {0};
+
+int WorkQueueTraceMaxItemId()
+{
+	return _trace_next_item_id.load() - 1;
+}
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 WorkItem::WorkItem(const char *name, const wq_config_t &config) :
 	_item_name(name)
 {
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	_trace_id = _trace_next_item_id.fetch_add(1);
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	if (!Init(config)) {
 		PX4_ERR("init failed");
 	}
@@ -53,6 +66,10 @@ WorkItem::WorkItem(const char *name, const wq_config_t &config) :
 WorkItem::WorkItem(const char *name, const WorkItem &work_item) :
 	_item_name(name)
 {
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	_trace_id = _trace_next_item_id.fetch_add(1);
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	px4::WorkQueue *wq = work_item._wq;
 
 	if ((wq != nullptr) && wq->Attach(this)) {
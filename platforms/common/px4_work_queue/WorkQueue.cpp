@@ -44,9 +44,18 @@
 namespace px4
 {
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+px4::atomic_bool WorkQueue::_trace_enabled {false};
+static px4::atomic<int> _trace_next_wq_index {0};
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 WorkQueue::WorkQueue(const wq_config_t &config) :
 	_config(config)
 {
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	_trace_index = static_cast<uint8_t>(_trace_next_wq_index.fetch_add(1));
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	// set the threads name
 #ifdef __PX4_DARWIN
 	pthread_setname_np(_config.name);
@@ -138,6 +147,15 @@ void WorkQueue::Add(WorkItem *item)
 
 #endif // ENABLE_LOCKSTEP_SCHEDULER
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+	// only take the schedule time if not already queued
+	if (trace_enabled() && (item->_time_scheduled == 0)) {
+		item->_time_scheduled = hrt_absolute_time();
+	}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	_q.push(item);
 	work_unlock();
 
@@ -157,6 +175,11 @@ void WorkQueue::Remove(WorkItem *item)
 {
 	work_lock();
 	_q.remove(item);
+
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	item->_time_scheduled = 0;
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	work_unlock();
 }
 
@@ -183,10 +206,36 @@ void WorkQueue::Run()
 		while (!_q.empty()) {
 			WorkItem *work = _q.pop();
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+			const hrt_abstime time_scheduled = work->_time_scheduled;
+			work->_time_scheduled = 0;
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 			work_unlock(); // unlock work queue to run (item may requeue itself)
+
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+			if (trace_enabled()) {
+				const uint16_t item_id = work->_trace_id;
+				const hrt_abstime time_start = hrt_absolute_time();
+
+				work->RunPreamble();
+				work->Run();
+				// Note: after Run() we cannot access work anymore, as it might have been deleted
+
+				trace_record(item_id, time_scheduled, time_start, hrt_absolute_time());
+
+			} else {
+				work->RunPreamble();
+				work->Run();
+			}
+
+#else
 			work->RunPreamble();
 			work->Run();
 			// Note: after Run() we cannot access work anymore, as it might have been deleted
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 			work_lock(); // re-lock
 		}
 
@@ -205,6 +254,71 @@ void WorkQueue::Run()
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+void WorkQueue::trace_record(uint16_t item_id, hrt_abstime time_scheduled, hrt_abstime time_start,
+			     hrt_abstime time_end)
+{
+	const uint32_t head = _trace_head.load();
+
+	if (head - _trace_tail.load() >= TRACE_RECORDS) {
+		// full, consumer isn't keeping up
+		_trace_dropped.fetch_add(1);
+		return;
+	}
+
+	wq_trace_record_t &record = _trace_buffer[head & (TRACE_RECORDS - 1)];
+
+	// schedule time unknown if the item was queued before tracing was enabled
+	record.time_scheduled = ((time_scheduled != 0) && (time_scheduled <= time_start)) ? time_scheduled : time_start;
+	record.time_start = time_start;
+	record.run_time = static_cast<uint32_t>(time_end - time_start);
+	record.item_id = item_id;
+
+	// publish the record to the consumer
+	_trace_head.store(head + 1);
+}
+
+size_t WorkQueue::trace_drain(wq_trace_record_t *records, size_t max_records, uint32_t &dropped)
+{
+	const uint32_t head = _trace_head.load();
+	uint32_t tail = _trace_tail.load();
+	size_t count = 0;
+
+	while ((tail != head) && (count < max_records)) {
+		records[count++] = _trace_buffer[tail & (TRACE_RECORDS - 1)];
+		tail++;
+	}
+
+	// release the slots to the producer
+	_trace_tail.store(tail);
+
+	dropped = _trace_dropped.load();
+
+	if (dropped > 0) {
+		_trace_dropped.fetch_sub(dropped);
+	}
+
+	return count;
+}
+
+void WorkQueue::trace_clear()
+{
+	_trace_tail.store(_trace_head.load());
+	_trace_dropped.store(0);
+}
+
+void WorkQueue::trace_names(WorkQueueTraceNameCallback callback, void *arg)
+{
+	callback(_config, _trace_index, -1, nullptr, arg);
+
+	LockGuard lg{_work_items.mutex()};
+
+	for (WorkItem *item : _work_items) {
+		callback(_config, _trace_index, item->TraceId(), item->ItemName(), arg);
+	}
+}
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
@@ -225,6 +225,33 @@ const wq_config_t &ins_instance_to_wq(uint8_t instance)
 	return wq_configurations::INS0;
 }
 
+const wq_config_t &ekf_instance_to_wq(uint8_t instance)
+{
+	switch (instance) {
+	case 0: return wq_configurations::EKF0;
+
+	case 1: return wq_configurations::EKF1;
+
+	case 2: return wq_configurations::EKF2;
+
+	case 3: return wq_configurations::EKF3;
+
+	case 4: return wq_configurations::EKF4;
+
+	case 5: return wq_configurations::EKF5;
+
+	case 6: return wq_configurations::EKF6;
+
+	case 7: return wq_configurations::EKF7;
+
+	case 8: return wq_configurations::EKF8;
+	}
+
+	PX4_WARN("no EKF%d wq configuration, using EKF0", instance);
+
+	return wq_configurations::EKF0;
+}
+
 static void *
 WorkQueueRunner(void *context)
 {
@@ -443,6 +470,59 @@ WorkQueueManagerStop()
 	return PX4_OK;
 }
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+void WorkQueueTraceEnable(bool enable)
+{
+	WorkQueue::trace_enable(enable);
+
+	if (!enable && (_wq_manager_wqs_list != nullptr)) {
+		LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+		for (WorkQueue *wq : *_wq_manager_wqs_list) {
+			wq->trace_clear();
+		}
+	}
+}
+
+void WorkQueueTraceDrain(wq_trace_record_t *records, size_t max_records, WorkQueueTraceDrainCallback callback,
+			 void *arg)
+{
+	if (_wq_manager_should_exit.load() || (_wq_manager_wqs_list == nullptr) || (max_records == 0)) {
+		return;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		uint32_t dropped = 0;
+		size_t num_records = wq->trace_drain(records, max_records, dropped);
+
+		while ((num_records > 0) || (dropped > 0)) {
+			callback(wq->get_config(), wq->trace_index(), records, num_records, dropped, arg);
+
+			if (num_records < max_records) {
+				break;
+			}
+
+			num_records = wq->trace_drain(records, max_records, dropped);
+		}
+	}
+}
+
+void WorkQueueTraceNames(WorkQueueTraceNameCallback callback, void *arg)
+{
+	if (_wq_manager_should_exit.load() || (_wq_manager_wqs_list == nullptr)) {
+		return;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		wq->trace_names(callback, arg);
+	}
+}
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 int
 WorkQueueManagerStatus()
 {
@@ -33,8 +33,6 @@
 
 #include "FakeMagnetometer.hpp"
 
-#include <lib/world_magnetic_model/geo_mag_declination.h>
-
 using namespace matrix;
 using namespace time_literals;
 
@@ -70,11 +68,10 @@ void FakeMagnetometer::Run()
 				const double lon = gps.lon / 1.e7;
 
 				// magnetic field data returned by the geo library using the current GPS position
-				const float mag_declination_gps = get_mag_declination_radians(lat, lon);
-				const float mag_inclination_gps = get_mag_inclination_radians(lat, lon);
-				const float mag_strength_gps = get_mag_strength_gauss(lat, lon);
+				const geo_mag_field_s &mag_field = _geo_mag_cache.get(lat, lon);
 
-				_mag_earth_pred = Dcmf(Eulerf(0, -mag_inclination_gps, mag_declination_gps)) * Vector3f(mag_strength_gps, 0, 0);
+				_mag_earth_pred = Dcmf(Eulerf(0, -mag_field.inclination_rad, mag_field.declination_rad))
+						  * Vector3f(mag_field.strength_gauss, 0, 0);
 
 				_mag_earth_available = true;
 			}
@@ -48,6 +48,7 @@
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <drivers/drv_sensor.h>
 #include <lib/drivers/magnetometer/PX4Magnetometer.hpp>
+#include <lib/world_magnetic_model/geo_mag_declination.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/sensor_gps.h>
@@ -76,6 +77,8 @@ private:
 
 	bool _mag_earth_available{false};
 
+	GeoMagCache _geo_mag_cache{};
+
 	matrix::Vector3f _mag_earth_pred{};
 
 	uORB::Subscription _vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
@@ -103,3 +103,45 @@ TEST(Rotations, duplicates)
 		}
 	}
 }
+
+TEST(Rotations, batch_vs_3i)
+{
+	static constexpr int N = 32;
+
+	for (size_t i = 0; i < (size_t)Rotation::ROTATION_MAX; i++) {
+
+		// GIVEN: a FIFO of int16 samples (including extremes) and a rotation
+		const enum Rotation rotation = static_cast<Rotation>(i);
+
+		int16_t x[N];
+		int16_t y[N];
+		int16_t z[N];
+
+		for (int n = 0; n < N; n++) {
+			x[n] = (n == 0) ? INT16_MIN : (int16_t)(n * 1031 - 12000);
+			y[n] = (n == 1) ? INT16_MAX : (int16_t)(n * -733 + 5000);
+			z[n] = (n == 2) ? INT16_MIN : (int16_t)(n * 97);
+		}
+
+		int16_t x_ref[N];
+		int16_t y_ref[N];
+		int16_t z_ref[N];
+
+		for (int n = 0; n < N; n++) {
+			x_ref[n] = x[n];
+			y_ref[n] = y[n];
+			z_ref[n] = z[n];
+			rotate_3i(rotation, x_ref[n], y_ref[n], z_ref[n]);
+		}
+
+		// WHEN: we rotate the whole batch
+		rotate_3i(rotation, x, y, z, N);
+
+		// THEN: the results should be identical to rotating every sample
+		for (int n = 0; n < N; n++) {
+			EXPECT_EQ(x[n], x_ref[n]) << "rotation " << i << " sample " << n;
+			EXPECT_EQ(y[n], y_ref[n]) << "rotation " << i << " sample " << n;
+			EXPECT_EQ(z[n], z_ref[n]) << "rotation " << i << " sample " << n;
+		}
+	}
+}
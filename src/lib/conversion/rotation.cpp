@@ -56,3 +56,36 @@ get_rot_quaternion(enum Rotation rot)
 			math::radians((float)rot_lookup[rot].pitch),
 			math::radians((float)rot_lookup[rot].yaw)}};
 }
+
+__EXPORT void
+rotate_3i(enum Rotation rot, int16_t x[], int16_t y[], int16_t z[], int N)
+{
+	if ((rot == ROTATION_NONE) || (N <= 0)) {
+		return;
+	}
+
+	int16_t x0 = 0;
+	int16_t y0 = 0;
+	int16_t z0 = 0;
+
+	if (rotate_3(rot, x0, y0, z0)) {
+		// axis swaps and negations only
+		for (int n = 0; n < N; n++) {
+			rotate_3(rot, x[n], y[n], z[n]);
+		}
+
+	} else if (rot < ROTATION_MAX) {
+		// full rotation matrix, computed once
+		const matrix::Dcmf R{get_rot_matrix(rot)};
+
+		for (int n = 0; n < N; n++) {
+			const float xf = x[n];
+			const float yf = y[n];
+			const float zf = z[n];
+
+			x[n] = math::constrain(roundf(R(0, 0) * xf + R(0, 1) * yf + R(0, 2) * zf), (float)INT16_MIN, (float)INT16_MAX);
+			y[n] = math::constrain(roundf(R(1, 0) * xf + R(1, 1) * yf + R(1, 2) * zf), (float)INT16_MIN, (float)INT16_MAX);
+			z[n] = math::constrain(roundf(R(2, 0) * xf + R(2, 1) * yf + R(2, 2) * zf), (float)INT16_MIN, (float)INT16_MAX);
+		}
+	}
+}
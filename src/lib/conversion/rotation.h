@@ -386,6 +386,13 @@ __EXPORT inline void rotate_3i(enum Rotation rot, int16_t &x, int16_t &y, int16_
 	}
 }
 
+/**
+ * rotate arrays of 3 element int16_t vectors in-place (e.g. a sensor FIFO)
+ *
+ * The rotation is resolved once for the whole batch instead of per sample.
+ */
+__EXPORT void rotate_3i(enum Rotation rot, int16_t x[], int16_t y[], int16_t z[], int N);
+
 /**
  * rotate a 3 element float vector in-place
  */
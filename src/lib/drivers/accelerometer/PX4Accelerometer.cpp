@@ -39,31 +39,27 @@
 
 using namespace time_literals;
 
-static constexpr int32_t sum(const int16_t samples[], uint8_t len)
+// single pass over the (rotated) FIFO samples of all axes:
+//  - sum of the first len - 1 samples (trapezoidal integration)
+//  - clipping count of all samples
+static inline void sum_clipping(const int16_t *samples[3], uint8_t len, int32_t sum[3], uint8_t clip_count[3])
 {
-	int32_t sum = 0;
-
-	for (int n = 0; n < len; n++) {
-		sum += samples[n];
-	}
-
-	return sum;
-}
-
-static constexpr uint8_t clipping(const int16_t samples[], uint8_t len)
-{
-	unsigned clip_count = 0;
-
-	for (int n = 0; n < len; n++) {
-		// - consider data clipped/saturated if it's INT16_MIN/INT16_MAX or within 1
-		// - this accommodates rotated data (|INT16_MIN| = INT16_MAX + 1)
-		//   and sensors that may re-use the lowest bit for other purposes (sync indicator, etc)
-		if ((samples[n] <= INT16_MIN + 1) || (samples[n] >= INT16_MAX - 1)) {
-			clip_count++;
+	for (int axis = 0; axis < 3; axis++) {
+		const int16_t *data = samples[axis];
+		int32_t axis_sum = 0;
+		unsigned axis_clip_count = 0;
+
+		for (int n = 0; n < len; n++) {
+			// - consider data clipped/saturated if it's INT16_MIN/INT16_MAX or within 1
+			// - this accommodates rotated data (|INT16_MIN| = INT16_MAX + 1)
+			//   and sensors that may re-use the lowest bit for other purposes (sync indicator, etc)
+			axis_clip_count += (data[n] <= INT16_MIN + 1) | (data[n] >= INT16_MAX - 1);
+			axis_sum += data[n];
 		}
-	}
 
-	return clip_count;
+		sum[axis] = axis_sum - data[len - 1];
+		clip_count[axis] = axis_clip_count;
+	}
 }
 
 PX4Accelerometer::PX4Accelerometer(uint32_t device_id, enum Rotation rotation) :
@@ -140,9 +136,7 @@ void PX4Accelerometer::updateFIFO(sensor_accel_fifo_s &sample)
 	// rotate all raw samples and publish fifo
 	const uint8_t N = sample.samples;
 
-	for (int n = 0; n < N; n++) {
-		rotate_3i(_rotation, sample.x[n], sample.y[n], sample.z[n]);
-	}
+	rotate_3i(_rotation, sample.x, sample.y, sample.z, N);
 
 	sample.device_id = _device_id;
 	sample.scale = _scale;
@@ -157,19 +151,20 @@ void PX4Accelerometer::updateFIFO(sensor_accel_fifo_s &sample)
 	report.temperature = _temperature;
 	report.error_count = _error_count;
 
+	const int16_t *samples[3] {sample.x, sample.y, sample.z};
+	int32_t sum[3];
+	sum_clipping(samples, N, sum, report.clip_counter);
+
 	// trapezoidal integration (equally spaced)
 	const float scale = _scale / (float)N;
-	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1)) * scale;
-	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1)) * scale;
-	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1)) * scale;
+	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum[0]) * scale;
+	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum[1]) * scale;
+	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum[2]) * scale;
 
 	_last_sample[0] = sample.x[N - 1];
 	_last_sample[1] = sample.y[N - 1];
 	_last_sample[2] = sample.z[N - 1];
 
-	report.clip_counter[0] = clipping(sample.x, N);
-	report.clip_counter[1] = clipping(sample.y, N);
-	report.clip_counter[2] = clipping(sample.z, N);
 	report.samples = N;
 	report.timestamp = hrt_absolute_time();
 
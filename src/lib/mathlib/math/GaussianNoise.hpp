@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GaussianNoise.hpp
+ *
+ * Block generator of white Gaussian noise for simulation.
+ *
+ * Uniform samples come from four interleaved xoshiro128+ generators that are advanced
+ * together, so the state update maps onto SIMD lanes. Each block of uniform samples is
+ * transformed to standard normal samples with Box-Muller in a single pass over the block.
+ * The sequence is fully determined by the seed.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <lib/mathlib/mathlib.h>
+
+namespace math
+{
+
+template<int BLOCK_SIZE = 64>
+class GaussianNoise
+{
+public:
+	explicit GaussianNoise(uint64_t seed = 0) { reset(seed); }
+
+	/**
+	 * Restart the sequence from a seed
+	 */
+	void reset(uint64_t seed)
+	{
+		// expand the seed with splitmix64, which never yields an all zero generator state
+		for (int lane = 0; lane < LANES; lane++) {
+			const uint64_t a = splitmix64(seed);
+			const uint64_t b = splitmix64(seed);
+			_state[0][lane] = static_cast<uint32_t>(a);
+			_state[1][lane] = static_cast<uint32_t>(a >> 32);
+			_state[2][lane] = static_cast<uint32_t>(b);
+			_state[3][lane] = static_cast<uint32_t>(b >> 32);
+		}
+
+		_index = BLOCK_SIZE;
+	}
+
+	/**
+	 * @return next sample of the standard normal distribution
+	 */
+	float next()
+	{
+		if (_index >= BLOCK_SIZE) {
+			refill();
+		}
+
+		return _block[_index++];
+	}
+
+	/**
+	 * Copy the next samples of the standard normal distribution
+	 *
+	 * @param samples output buffer
+	 * @param count number of samples to copy
+	 */
+	void fill(float *samples, int count)
+	{
+		while (count > 0) {
+			if (_index >= BLOCK_SIZE) {
+				refill();
+			}
+
+			const int n = math::min(count, BLOCK_SIZE - _index);
+			memcpy(samples, &_block[_index], n * sizeof(float));
+			_index += n;
+			samples += n;
+			count -= n;
+		}
+	}
+
+private:
+	static constexpr int LANES = 4;
+
+	static_assert(BLOCK_SIZE > 0 && BLOCK_SIZE % (2 * LANES) == 0, "block size must be a multiple of 8");
+
+	static uint64_t splitmix64(uint64_t &x)
+	{
+		uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+	void refill()
+	{
+		// the block is filled with uniform samples first and then transformed in place
+		for (int i = 0; i < BLOCK_SIZE; i += LANES) {
+			for (int lane = 0; lane < LANES; lane++) {
+				uint32_t *s0 = &_state[0][lane];
+				uint32_t *s1 = &_state[1][lane];
+				uint32_t *s2 = &_state[2][lane];
+				uint32_t *s3 = &_state[3][lane];
+
+				const uint32_t result = *s0 + *s3;
+				const uint32_t t = *s1 << 9;
+
+				*s2 ^= *s0;
+				*s3 ^= *s1;
+				*s1 ^= *s2;
+				*s0 ^= *s3;
+				*s2 ^= t;
+				*s3 = rotl(*s3, 11);
+
+				// upper 24 bits (the best ones of xoshiro128+) to (0, 1], safe for the logarithm
+				_block[i + lane] = static_cast<float>((result >> 8) + 1u) * (1.f / 16777216.f);
+			}
+		}
+
+		// Box-Muller: the first half gives the radii, the second half the angles
+		static constexpr int HALF = BLOCK_SIZE / 2;
+
+		for (int i = 0; i < HALF; i++) {
+			const float radius = sqrtf(-2.f * logf(_block[i]));
+			const float angle = M_TWOPI_F * _block[HALF + i];
+			_block[i] = radius * cosf(angle);
+			_block[HALF + i] = radius * sinf(angle);
+		}
+
+		_index = 0;
+	}
+
+	uint32_t _state[4][LANES];
+	float _block[BLOCK_SIZE];
+	int _index{BLOCK_SIZE};
+};
+
+} // namespace math
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include "GaussianNoise.hpp"
+
+using namespace math;
+
+TEST(GaussianNoiseTest, StandardNormalStatistics)
+{
+	GaussianNoise<> noise{42};
+
+	static constexpr int N = 100000;
+	double sum = 0.0;
+	double sum_sq = 0.0;
+	int within_one_sigma = 0;
+
+	for (int i = 0; i < N; i++) {
+		const float x = noise.next();
+		sum += static_cast<double>(x);
+		sum_sq += static_cast<double>(x * x);
+		within_one_sigma += (fabsf(x) < 1.f);
+	}
+
+	const double mean = sum / N;
+	const double variance = sum_sq / N - mean * mean;
+
+	EXPECT_NEAR(mean, 0.0, 0.01);
+	EXPECT_NEAR(variance, 1.0, 0.02);
+	EXPECT_NEAR(static_cast<double>(within_one_sigma) / N, 0.6827, 0.005);
+}
+
+TEST(GaussianNoiseTest, DeterministicSeed)
+{
+	GaussianNoise<> noise_a{1234};
+	GaussianNoise<> noise_b{1234};
+	GaussianNoise<> noise_c{1235};
+
+	int equal_to_other_seed = 0;
+
+	for (int i = 0; i < 1000; i++) {
+		const float a = noise_a.next();
+		EXPECT_FLOAT_EQ(a, noise_b.next());
+		equal_to_other_seed += (fabsf(a - noise_c.next()) < FLT_EPSILON);
+	}
+
+	EXPECT_EQ(equal_to_other_seed, 0);
+
+	// reset restarts the sequence
+	noise_a.reset(1234);
+	noise_b.reset(1234);
+	EXPECT_FLOAT_EQ(noise_a.next(), noise_b.next());
+}
+
+TEST(GaussianNoiseTest, FillMatchesNext)
+{
+	GaussianNoise<16> noise_a{7};
+	GaussianNoise<16> noise_b{7};
+
+	// crosses block boundaries and starts within a block
+	float samples[50];
+	noise_a.next();
+	noise_b.next();
+	noise_a.fill(samples, 50);
+
+	for (int i = 0; i < 50; i++) {
+		EXPECT_FLOAT_EQ(samples[i], noise_b.next());
+	}
+}
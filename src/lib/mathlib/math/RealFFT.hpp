@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file RealFFT.hpp
+ *
+ * @brief float32 FFT of real valued input.
+ *
+ * The N point real FFT is computed as a N/2 point complex radix-2 FFT of the even/odd
+ * samples followed by a split step. Real and imaginary parts are kept in separate arrays
+ * and all butterflies of a stage operate on contiguous data so the compiler can
+ * auto-vectorize the inner loops (SSE/AVX, NEON).
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+namespace math
+{
+
+class RealFFT
+{
+public:
+	RealFFT() = default;
+	~RealFFT() { deallocate(); }
+
+	RealFFT(const RealFFT &) = delete;
+	RealFFT &operator=(const RealFFT &) = delete;
+
+	// supported lengths: power of 2, 16 - 8192
+	static bool supported(int N)
+	{
+		return (N >= 16) && (N <= 8192) && ((N & (N - 1)) == 0);
+	}
+
+	bool init(int N)
+	{
+		deallocate();
+
+		if (!supported(N)) {
+			return false;
+		}
+
+		_length = N;
+		const int M = N / 2;
+
+		_re = new float[M];
+		_im = new float[M];
+		_twiddle_re = new float[M];
+		_twiddle_im = new float[M];
+		_bit_reverse = new uint16_t[M];
+
+		if (!_re || !_im || !_twiddle_re || !_twiddle_im || !_bit_reverse) {
+			deallocate();
+			return false;
+		}
+
+		// e^(-j 2 pi k / N), k = 0 .. N/2 - 1
+		// the complex FFT of length M uses every second entry, the split step all of them
+		for (int k = 0; k < M; k++) {
+			const double phi = -2.0 * M_PI * k / N;
+			_twiddle_re[k] = (float)cos(phi);
+			_twiddle_im[k] = (float)sin(phi);
+		}
+
+		int bits = 0;
+
+		while ((1 << bits) < M) {
+			bits++;
+		}
+
+		for (int i = 0; i < M; i++) {
+			int reversed = 0;
+
+			for (int b = 0; b < bits; b++) {
+				reversed |= ((i >> b) & 1) << (bits - 1 - b);
+			}
+
+			_bit_reverse[i] = reversed;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Forward FFT of N real samples.
+	 *
+	 * @param input N real samples
+	 * @param output N + 2 values, interleaved [real[0], imag[0], real[1], imag[1] ... real[N/2], imag[N/2]]
+	 */
+	void forward(const float *input, float *output)
+	{
+		const int M = _length / 2;
+
+		// pack even/odd samples as complex input (bit reversed order)
+		for (int i = 0; i < M; i++) {
+			const int j = _bit_reverse[i];
+			_re[j] = input[2 * i];
+			_im[j] = input[2 * i + 1];
+		}
+
+		// iterative radix-2 decimation in time
+		for (int size = 2; size <= M; size *= 2) {
+			const int half = size / 2;
+			const int twiddle_step = _length / size; // N / size (twiddle table is for length N)
+
+			for (int start = 0; start < M; start += size) {
+				float *re_a = &_re[start];
+				float *im_a = &_im[start];
+				float *re_b = &_re[start + half];
+				float *im_b = &_im[start + half];
+
+				for (int k = 0; k < half; k++) {
+					const float w_re = _twiddle_re[k * twiddle_step];
+					const float w_im = _twiddle_im[k * twiddle_step];
+
+					const float t_re = re_b[k] * w_re - im_b[k] * w_im;
+					const float t_im = re_b[k] * w_im + im_b[k] * w_re;
+
+					re_b[k] = re_a[k] - t_re;
+					im_b[k] = im_a[k] - t_im;
+					re_a[k] = re_a[k] + t_re;
+					im_a[k] = im_a[k] + t_im;
+				}
+			}
+		}
+
+		// split: X[k] = 0.5 (Z[k] + conj(Z[M-k])) - 0.5 j W^k (Z[k] - conj(Z[M-k]))
+		output[0] = _re[0] + _im[0];
+		output[1] = 0.f;
+		output[2 * M] = _re[0] - _im[0];
+		output[2 * M + 1] = 0.f;
+
+		for (int k = 1; k < M; k++) {
+			const float z_re = _re[k];
+			const float z_im = _im[k];
+			const float zc_re = _re[M - k];
+			const float zc_im = -_im[M - k];
+
+			const float even_re = 0.5f * (z_re + zc_re);
+			const float even_im = 0.5f * (z_im + zc_im);
+			const float odd_re = 0.5f * (z_re - zc_re);
+			const float odd_im = 0.5f * (z_im - zc_im);
+
+			// -j W^k odd
+			const float w_re = _twiddle_re[k];
+			const float w_im = _twiddle_im[k];
+			const float wo_re = w_re * odd_re - w_im * odd_im;
+			const float wo_im = w_re * odd_im + w_im * odd_re;
+
+			output[2 * k] = even_re + wo_im;
+			output[2 * k + 1] = even_im - wo_re;
+		}
+	}
+
+	int length() const { return _length; }
+
+private:
+	void deallocate()
+	{
+		delete[] _re;
+		delete[] _im;
+		delete[] _twiddle_re;
+		delete[] _twiddle_im;
+		delete[] _bit_reverse;
+
+		_re = nullptr;
+		_im = nullptr;
+		_twiddle_re = nullptr;
+		_twiddle_im = nullptr;
+		_bit_reverse = nullptr;
+		_length = 0;
+	}
+
+	float *_re{nullptr};
+	float *_im{nullptr};
+	float *_twiddle_re{nullptr};
+	float *_twiddle_im{nullptr};
+	uint16_t *_bit_reverse{nullptr};
+
+	int _length{0};
+};
+
+} // namespace math
@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include "RealFFT.hpp"
+
+using namespace math;
+
+static void referenceDFT(const float *x, int N, int k, double &re, double &im)
+{
+	re = 0.0;
+	im = 0.0;
+
+	for (int n = 0; n < N; n++) {
+		const double phi = -2.0 * M_PI * k * n / N;
+		re += static_cast<double>(x[n]) * cos(phi);
+		im += static_cast<double>(x[n]) * sin(phi);
+	}
+}
+
+TEST(RealFFTTest, supported)
+{
+	EXPECT_FALSE(RealFFT::supported(8));
+	EXPECT_FALSE(RealFFT::supported(300));
+	EXPECT_TRUE(RealFFT::supported(256));
+	EXPECT_TRUE(RealFFT::supported(1024));
+	EXPECT_FALSE(RealFFT::supported(16384));
+
+	RealFFT fft;
+	EXPECT_FALSE(fft.init(100));
+	EXPECT_EQ(fft.length(), 0);
+}
+
+TEST(RealFFTTest, matchesDFT)
+{
+	for (int N : {16, 64, 256, 1024}) {
+		RealFFT fft;
+		ASSERT_TRUE(fft.init(N));
+
+		float *x = new float[N];
+		float *output = new float[N + 2];
+
+		srand(N);
+
+		for (int n = 0; n < N; n++) {
+			x[n] = 1000.f * sinf(2.f * (float)M_PI * 17.3f * n / N) + 200.f * (rand() / (float)RAND_MAX - 0.5f) + 50.f;
+		}
+
+		fft.forward(x, output);
+
+		for (int k = 0; k <= N / 2; k++) {
+			double re;
+			double im;
+			referenceDFT(x, N, k, re, im);
+
+			const double tolerance = 1e-5 * 1000.0 * N;
+			EXPECT_NEAR(output[2 * k], re, tolerance) << "N " << N << " bin " << k;
+			EXPECT_NEAR(output[2 * k + 1], im, tolerance) << "N " << N << " bin " << k;
+		}
+
+		delete[] x;
+		delete[] output;
+	}
+}
@@ -0,0 +1,369 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file BiquadCascade.hpp
+ *
+ * Fused cascade of second order filter stages (NotchFilter, LowPassFilter2p) for 3 axes.
+ *
+ * The stages of all axes are gathered into a structure-of-arrays layout (one lane per axis)
+ * and every sample is passed through all stages in a single pass. The filter objects stay
+ * the owners of the parameters and the state, the state is copied in with addStage()
+ * and written back with store().
+ */
+
+#pragma once
+
+#include <mathlib/math/Functions.hpp>
+#include <mathlib/math/filter/LowPassFilter2p.hpp>
+#include <mathlib/math/filter/NotchFilter.hpp>
+
+#include <stdint.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace math
+{
+
+class BiquadCascade
+{
+public:
+	static constexpr int NUM_AXES = 3;
+
+	BiquadCascade() = default;
+	~BiquadCascade() { delete[] _stages; }
+
+	BiquadCascade(const BiquadCascade &) = delete;
+	BiquadCascade &operator=(const BiquadCascade &) = delete;
+
+	bool allocate(int max_stages)
+	{
+		if (max_stages != _max_stages) {
+			delete[] _stages;
+			_stages = (max_stages > 0) ? new Stage[max_stages] : nullptr;
+			_max_stages = (_stages != nullptr) ? max_stages : 0;
+		}
+
+		_num_stages = 0;
+		return (_stages != nullptr);
+	}
+
+	int maxStages() const { return _max_stages; }
+	int numStages() const { return _num_stages; }
+
+	void clear() { _num_stages = 0; }
+
+	/**
+	 * Add one notch filter per axis as a single stage (Direct Form I).
+	 * An axis without filter (nullptr) passes through this stage unchanged.
+	 */
+	bool addStage(NotchFilter<float> *filter[NUM_AXES])
+	{
+		if (_num_stages >= _max_stages) {
+			return false;
+		}
+
+		Stage &stage = _stages[_num_stages];
+		stage.direct_form_2 = false;
+		stage.reset_mask = 0;
+
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			stage.notch[axis] = filter[axis];
+			stage.lpf[axis] = nullptr;
+
+			if (filter[axis]) {
+				float a[3];
+				float b[3];
+				filter[axis]->getCoefficients(a, b);
+				stage.setCoefficients(axis, a, b);
+				filter[axis]->getDelayElements(stage.s1[axis], stage.s2[axis], stage.s3[axis], stage.s4[axis]);
+
+				if (!filter[axis]->initialized()) {
+					// reset to the stage input of the first sample (same as NotchFilter::applyArray)
+					stage.reset_mask |= (1 << axis);
+				}
+
+			} else {
+				stage.setPassThrough(axis);
+			}
+		}
+
+		stage.setPassThrough(NUM_AXES);
+		_num_stages++;
+		return true;
+	}
+
+	/**
+	 * Add the low-pass filters of all axes as a single stage (Direct Form II).
+	 */
+	bool addStage(LowPassFilter2p<float> filter[NUM_AXES])
+	{
+		if (_num_stages >= _max_stages) {
+			return false;
+		}
+
+		Stage &stage = _stages[_num_stages];
+		stage.direct_form_2 = true;
+		stage.reset_mask = 0;
+
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			float a[3];
+			float b[3];
+			filter[axis].getCoefficients(a, b);
+			stage.setCoefficients(axis, a, b);
+			filter[axis].getDelayElements(stage.s1[axis], stage.s2[axis]);
+			stage.s3[axis] = 0.f;
+			stage.s4[axis] = 0.f;
+
+			stage.notch[axis] = nullptr;
+			stage.lpf[axis] = &filter[axis];
+		}
+
+		stage.setPassThrough(NUM_AXES);
+		_num_stages++;
+		return true;
+	}
+
+	/**
+	 * Filter the samples of all axes in place through all stages.
+	 */
+	void apply(float *data[NUM_AXES], int num_samples)
+	{
+		if (num_samples <= 0) {
+			return;
+		}
+
+		// first sample, handle pending filter resets
+		{
+			alignas(16) float x[LANES] {data[0][0], data[1][0], data[2][0], 0.f};
+
+			for (int s = 0; s < _num_stages; s++) {
+				if (_stages[s].reset_mask != 0) {
+					_stages[s].reset(x);
+				}
+
+				applyStage(_stages[s], x);
+			}
+
+			for (int axis = 0; axis < NUM_AXES; axis++) {
+				data[axis][0] = x[axis];
+			}
+		}
+
+		for (int n = 1; n < num_samples; n++) {
+			alignas(16) float x[LANES] {data[0][n], data[1][n], data[2][n], 0.f};
+
+			for (int s = 0; s < _num_stages; s++) {
+				applyStage(_stages[s], x);
+			}
+
+			for (int axis = 0; axis < NUM_AXES; axis++) {
+				data[axis][n] = x[axis];
+			}
+		}
+	}
+
+	/**
+	 * Write the filter states back to the filters added since the last clear().
+	 */
+	void store()
+	{
+		for (int s = 0; s < _num_stages; s++) {
+			Stage &stage = _stages[s];
+
+			for (int axis = 0; axis < NUM_AXES; axis++) {
+				if (stage.notch[axis]) {
+					stage.notch[axis]->setDelayElements(stage.s1[axis], stage.s2[axis], stage.s3[axis], stage.s4[axis]);
+
+				} else if (stage.lpf[axis]) {
+					stage.lpf[axis]->setDelayElements(stage.s1[axis], stage.s2[axis]);
+				}
+			}
+		}
+	}
+
+private:
+	static constexpr int LANES = 4; // 3 axes padded to the vector width
+
+	struct Stage {
+		// coefficients normalized by a0
+		float b0[LANES];
+		float b1[LANES];
+		float b2[LANES];
+		float a1[LANES];
+		float a2[LANES];
+
+		// Direct Form I: s1, s2 inputs, s3, s4 outputs (n-1, n-2)
+		// Direct Form II: s1, s2 delay elements (n-1, n-2)
+		float s1[LANES];
+		float s2[LANES];
+		float s3[LANES];
+		float s4[LANES];
+
+		NotchFilter<float> *notch[NUM_AXES];
+		LowPassFilter2p<float> *lpf[NUM_AXES];
+
+		bool direct_form_2;
+		uint8_t reset_mask;
+
+		void setCoefficients(int lane, const float a[3], const float b[3])
+		{
+			b0[lane] = b[0];
+			b1[lane] = b[1];
+			b2[lane] = b[2];
+			a1[lane] = a[1];
+			a2[lane] = a[2];
+		}
+
+		void setPassThrough(int lane)
+		{
+			b0[lane] = 1.f;
+			b1[lane] = 0.f;
+			b2[lane] = 0.f;
+			a1[lane] = 0.f;
+			a2[lane] = 0.f;
+			s1[lane] = s2[lane] = s3[lane] = s4[lane] = 0.f;
+		}
+
+		// reset the Direct Form I state of the flagged lanes to the steady state of the stage input (NotchFilter::reset())
+		void reset(const float x[LANES])
+		{
+			for (int lane = 0; lane < NUM_AXES; lane++) {
+				if (reset_mask & (1 << lane)) {
+					const float input = isFinite(x[lane]) ? x[lane] : 0.f;
+
+					s1[lane] = s2[lane] = input;
+					s3[lane] = s4[lane] = input * (b0[lane] + b1[lane] + b2[lane]) / (1.f + a1[lane] + a2[lane]);
+
+					if (!isFinite(s3[lane])) {
+						s3[lane] = s4[lane] = 0.f;
+					}
+				}
+			}
+
+			reset_mask = 0;
+		}
+	};
+
+	static inline void applyStage(Stage &st, float x[LANES])
+	{
+#if defined(__ARM_NEON)
+		const float32x4_t in = vld1q_f32(x);
+		const float32x4_t s1 = vld1q_f32(st.s1);
+		const float32x4_t s2 = vld1q_f32(st.s2);
+
+		if (st.direct_form_2) {
+			const float32x4_t w0 = vmlsq_f32(vmlsq_f32(in, vld1q_f32(st.a1), s1), vld1q_f32(st.a2), s2);
+			const float32x4_t out = vmlaq_f32(vmlaq_f32(vmulq_f32(vld1q_f32(st.b0), w0), vld1q_f32(st.b1), s1),
+							  vld1q_f32(st.b2), s2);
+			vst1q_f32(st.s2, s1);
+			vst1q_f32(st.s1, w0);
+			vst1q_f32(x, out);
+
+		} else {
+			const float32x4_t s3 = vld1q_f32(st.s3);
+			float32x4_t out = vmulq_f32(vld1q_f32(st.b0), in);
+			out = vmlaq_f32(out, vld1q_f32(st.b1), s1);
+			out = vmlaq_f32(out, vld1q_f32(st.b2), s2);
+			out = vmlsq_f32(out, vld1q_f32(st.a1), s3);
+			out = vmlsq_f32(out, vld1q_f32(st.a2), vld1q_f32(st.s4));
+			vst1q_f32(st.s2, s1);
+			vst1q_f32(st.s1, in);
+			vst1q_f32(st.s4, s3);
+			vst1q_f32(st.s3, out);
+			vst1q_f32(x, out);
+		}
+
+#elif defined(__SSE__)
+		const __m128 in = _mm_loadu_ps(x);
+		const __m128 s1 = _mm_loadu_ps(st.s1);
+		const __m128 s2 = _mm_loadu_ps(st.s2);
+
+		if (st.direct_form_2) {
+			const __m128 w0 = _mm_sub_ps(_mm_sub_ps(in, _mm_mul_ps(_mm_loadu_ps(st.a1), s1)), _mm_mul_ps(_mm_loadu_ps(st.a2), s2));
+			const __m128 out = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(st.b0), w0), _mm_mul_ps(_mm_loadu_ps(st.b1), s1)),
+						      _mm_mul_ps(_mm_loadu_ps(st.b2), s2));
+			_mm_storeu_ps(st.s2, s1);
+			_mm_storeu_ps(st.s1, w0);
+			_mm_storeu_ps(x, out);
+
+		} else {
+			const __m128 s3 = _mm_loadu_ps(st.s3);
+			__m128 out = _mm_mul_ps(_mm_loadu_ps(st.b0), in);
+			out = _mm_add_ps(out, _mm_mul_ps(_mm_loadu_ps(st.b1), s1));
+			out = _mm_add_ps(out, _mm_mul_ps(_mm_loadu_ps(st.b2), s2));
+			out = _mm_sub_ps(out, _mm_mul_ps(_mm_loadu_ps(st.a1), s3));
+			out = _mm_sub_ps(out, _mm_mul_ps(_mm_loadu_ps(st.a2), _mm_loadu_ps(st.s4)));
+			_mm_storeu_ps(st.s2, s1);
+			_mm_storeu_ps(st.s1, in);
+			_mm_storeu_ps(st.s4, s3);
+			_mm_storeu_ps(st.s3, out);
+			_mm_storeu_ps(x, out);
+		}
+
+#else
+
+		if (st.direct_form_2) {
+			for (int lane = 0; lane < LANES; lane++) {
+				const float w0 = x[lane] - st.a1[lane] * st.s1[lane] - st.a2[lane] * st.s2[lane];
+				const float out = st.b0[lane] * w0 + st.b1[lane] * st.s1[lane] + st.b2[lane] * st.s2[lane];
+				st.s2[lane] = st.s1[lane];
+				st.s1[lane] = w0;
+				x[lane] = out;
+			}
+
+		} else {
+			for (int lane = 0; lane < LANES; lane++) {
+				const float out = st.b0[lane] * x[lane] + st.b1[lane] * st.s1[lane] + st.b2[lane] * st.s2[lane]
+						  - st.a1[lane] * st.s3[lane] - st.a2[lane] * st.s4[lane];
+				st.s2[lane] = st.s1[lane];
+				st.s1[lane] = x[lane];
+				st.s4[lane] = st.s3[lane];
+				st.s3[lane] = out;
+				x[lane] = out;
+			}
+		}
+
+#endif
+	}
+
+	Stage *_stages{nullptr};
+	int _max_stages{0};
+	int _num_stages{0};
+};
+
+} // namespace math
@@ -122,6 +122,30 @@ public:
 	// Return the sample frequency
 	float get_sample_freq() const { return _sample_freq; }
 
+	// Used for batch processing (BiquadCascade)
+	void getCoefficients(float a[3], float b[3]) const
+	{
+		a[0] = 1.f;
+		a[1] = _a1;
+		a[2] = _a2;
+		b[0] = _b0;
+		b[1] = _b1;
+		b[2] = _b2;
+	}
+
+	// Direct Form II delay elements, used for batch processing (BiquadCascade)
+	void getDelayElements(T &w1, T &w2) const
+	{
+		w1 = _delay_element_1;
+		w2 = _delay_element_2;
+	}
+
+	void setDelayElements(const T &w1, const T &w2)
+	{
+		_delay_element_1 = w1;
+		_delay_element_2 = w2;
+	}
+
 	float getMagnitudeResponse(float frequency) const;
 
 	// Reset the filter state to this value
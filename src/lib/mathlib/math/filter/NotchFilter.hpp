@@ -90,7 +90,7 @@ public:
 	float getNotchFreq() const { return _notch_freq; }
 	float getBandwidth() const { return _bandwidth; }
 
-	// Used in unit test only
+	// Used in unit test and batch processing (BiquadCascade)
 	void getCoefficients(float a[3], float b[3]) const
 	{
 		a[0] = 1.f;
@@ -130,6 +130,24 @@ public:
 
 	bool initialized() const { return _initialized; }
 
+	// Direct Form I delay elements, used for batch processing (BiquadCascade)
+	void getDelayElements(T &x1, T &x2, T &y1, T &y2) const
+	{
+		x1 = _delay_element_1;
+		x2 = _delay_element_2;
+		y1 = _delay_element_output_1;
+		y2 = _delay_element_output_2;
+	}
+
+	void setDelayElements(const T &x1, const T &x2, const T &y1, const T &y2)
+	{
+		_delay_element_1 = x1;
+		_delay_element_2 = x2;
+		_delay_element_output_1 = y1;
+		_delay_element_output_2 = y2;
+		_initialized = true;
+	}
+
 	void reset() { _initialized = false; }
 
 	void reset(const T &sample)
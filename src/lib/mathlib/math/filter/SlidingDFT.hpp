@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SlidingDFT.hpp
+ *
+ * @brief Sliding discrete Fourier transform of a limited bin range.
+ *
+ * Every input sample updates the bins [bin_first, bin_last] of an N point DFT over the
+ * last N samples, so the spectrum is available after every sample at a constant cost
+ * of O(number of bins) instead of O(N log N) once per block.
+ * A damping factor close to 1 keeps the recursion stable with float accumulation.
+ *
+ * Bins are returned with a Hann window applied in the frequency domain,
+ * Y[k] = 0.5 X[k] - 0.25 (X[k-1] + X[k+1]), which requires the two neighbouring bins.
+ * The bins [bin_first - 1, bin_last + 1] are therefore computed internally.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <string.h>
+
+namespace math
+{
+
+class SlidingDFT
+{
+public:
+	SlidingDFT() = default;
+	~SlidingDFT() { deallocate(); }
+
+	SlidingDFT(const SlidingDFT &) = delete;
+	SlidingDFT &operator=(const SlidingDFT &) = delete;
+
+	/**
+	 * Allocate and initialize a N point sliding DFT.
+	 *
+	 * @param N DFT length
+	 * @param bin_first first (windowed) bin to compute, >= 1
+	 * @param bin_last last (windowed) bin to compute, <= N / 2 - 2
+	 * @return false if the arguments are invalid or the allocation failed
+	 */
+	bool init(int N, int bin_first, int bin_last)
+	{
+		deallocate();
+
+		if ((N < 4) || (bin_first < 1) || (bin_last < bin_first) || (bin_last > N / 2 - 2)) {
+			return false;
+		}
+
+		_length = N;
+		_bin_first = bin_first;
+		_bin_last = bin_last;
+		_num_bins = (bin_last + 1) - (bin_first - 1) + 1;
+
+		_samples = new float[_length];
+		_bins = new Complex[_num_bins];
+		_twiddle = new Complex[_num_bins];
+
+		if (!_samples || !_bins || !_twiddle) {
+			deallocate();
+			return false;
+		}
+
+		// X[k](n) = r e^(j 2 pi k / N) (X[k](n-1) + x(n) - r^N x(n-N))
+		for (int i = 0; i < _num_bins; i++) {
+			const int k = _bin_first - 1 + i;
+			const float phi = 2.f * (float)M_PI * k / _length;
+			_twiddle[i].re = DAMPING * cosf(phi);
+			_twiddle[i].im = DAMPING * sinf(phi);
+		}
+
+		_damping_n = powf(DAMPING, _length);
+
+		reset();
+
+		return true;
+	}
+
+	void reset()
+	{
+		if (_samples && _bins) {
+			memset(_samples, 0, sizeof(float) * _length);
+			memset(_bins, 0, sizeof(Complex) * _num_bins);
+		}
+
+		_index = 0;
+		_count = 0;
+	}
+
+	/**
+	 * Add one sample and update all bins.
+	 */
+	void update(float sample)
+	{
+		const float delta = sample - _damping_n * _samples[_index];
+		_samples[_index] = sample;
+
+		_index = (_index + 1 < _length) ? _index + 1 : 0;
+
+		if (_count < _length) {
+			_count++;
+		}
+
+		for (int i = 0; i < _num_bins; i++) {
+			const float re = _bins[i].re + delta;
+			const float im = _bins[i].im;
+			_bins[i].re = re * _twiddle[i].re - im * _twiddle[i].im;
+			_bins[i].im = re * _twiddle[i].im + im * _twiddle[i].re;
+		}
+	}
+
+	void update(const float *samples, int N)
+	{
+		for (int n = 0; n < N; n++) {
+			update(samples[n]);
+		}
+	}
+
+	/**
+	 * Hann windowed bin k, valid for bin_first() <= k <= bin_last().
+	 */
+	void windowedBin(int k, float &re, float &im) const
+	{
+		const int i = k - (_bin_first - 1);
+		re = 0.5f * _bins[i].re - 0.25f * (_bins[i - 1].re + _bins[i + 1].re);
+		im = 0.5f * _bins[i].im - 0.25f * (_bins[i - 1].im + _bins[i + 1].im);
+	}
+
+	/**
+	 * Write the windowed bins [bin_first, bin_last] into an interleaved
+	 * (real[k], imag[k]) output buffer at index 2 * k, matching the CMSIS rfft output layout.
+	 */
+	void windowedSpectrum(float *output) const
+	{
+		for (int k = _bin_first; k <= _bin_last; k++) {
+			windowedBin(k, output[2 * k], output[2 * k + 1]);
+		}
+	}
+
+	// true once the window has been completely filled
+	bool valid() const { return (_count >= _length); }
+
+	int length() const { return _length; }
+	int bin_first() const { return _bin_first; }
+	int bin_last() const { return _bin_last; }
+
+	/**
+	 * Free the buffers, length() is 0 until the next successful init().
+	 */
+	void deallocate()
+	{
+		delete[] _samples;
+		delete[] _bins;
+		delete[] _twiddle;
+
+		_samples = nullptr;
+		_bins = nullptr;
+		_twiddle = nullptr;
+		_length = 0;
+		_num_bins = 0;
+	}
+
+private:
+	struct Complex {
+		float re;
+		float im;
+	};
+
+	static constexpr float DAMPING = 0.99999f;
+
+	float *_samples{nullptr}; // circular buffer of the last N samples
+	Complex *_bins{nullptr};
+	Complex *_twiddle{nullptr};
+
+	float _damping_n{1.f};
+
+	int _length{0};
+	int _bin_first{0};
+	int _bin_last{0};
+	int _num_bins{0};
+
+	int _index{0};
+	int _count{0};
+};
+
+} // namespace math
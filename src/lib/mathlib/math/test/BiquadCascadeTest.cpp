@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the fused biquad cascade
+ * Run this test only using make tests TESTFILTER=BiquadCascade
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/mathlib/math/filter/BiquadCascade.hpp>
+
+using namespace math;
+
+class BiquadCascadeTest : public ::testing::Test
+{
+public:
+	static constexpr float SAMPLE_FREQ = 8000.f;
+	static constexpr int NUM_SAMPLES = 32;
+
+	void SetUp() override
+	{
+		for (int axis = 0; axis < 3; axis++) {
+			_lpf[axis].set_cutoff_frequency(SAMPLE_FREQ, 80.f);
+			_lpf_ref[axis].set_cutoff_frequency(SAMPLE_FREQ, 80.f);
+
+			// 3 notches, a different one is missing on every axis
+			for (int i = 0; i < 3; i++) {
+				const float freq = (i == axis) ? 0.f : 120.f + 100.f * i + 10.f * axis;
+				_notch[i][axis].setParameters(SAMPLE_FREQ, freq, 20.f);
+				_notch_ref[i][axis].setParameters(SAMPLE_FREQ, freq, 20.f);
+			}
+		}
+	}
+
+	// apply the filters one after the other (reference)
+	void applyReference(float data[3][NUM_SAMPLES], int num_samples)
+	{
+		for (int axis = 0; axis < 3; axis++) {
+			for (int i = 0; i < 3; i++) {
+				if (_notch_ref[i][axis].getNotchFreq() > 0.f) {
+					_notch_ref[i][axis].applyArray(data[axis], num_samples);
+				}
+			}
+
+			_lpf_ref[axis].applyArray(data[axis], num_samples);
+		}
+	}
+
+	void applyCascade(float data[3][NUM_SAMPLES], int num_samples)
+	{
+		_cascade.clear();
+
+		for (int i = 0; i < 3; i++) {
+			NotchFilter<float> *nf[3];
+
+			for (int axis = 0; axis < 3; axis++) {
+				nf[axis] = (_notch[i][axis].getNotchFreq() > 0.f) ? &_notch[i][axis] : nullptr;
+			}
+
+			EXPECT_TRUE(_cascade.addStage(nf));
+		}
+
+		EXPECT_TRUE(_cascade.addStage(_lpf));
+
+		float *data_array[3] {data[0], data[1], data[2]};
+		_cascade.apply(data_array, num_samples);
+		_cascade.store();
+	}
+
+	static void generateSignal(float data[3][NUM_SAMPLES], int offset)
+	{
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < NUM_SAMPLES; n++) {
+				const float t = (offset + n) / SAMPLE_FREQ;
+				data[axis][n] = 0.3f * (axis + 1) + sinf(2.f * M_PI_F * 220.f * t) + 0.5f * sinf(2.f * M_PI_F * 15.f * t);
+			}
+		}
+	}
+
+	LowPassFilter2p<float> _lpf[3] {};
+	NotchFilter<float> _notch[3][3] {};
+
+	LowPassFilter2p<float> _lpf_ref[3] {};
+	NotchFilter<float> _notch_ref[3][3] {};
+
+	BiquadCascade _cascade{};
+};
+
+TEST_F(BiquadCascadeTest, capacity)
+{
+	ASSERT_TRUE(_cascade.allocate(1));
+	EXPECT_TRUE(_cascade.addStage(_lpf));
+	EXPECT_FALSE(_cascade.addStage(_lpf));
+	EXPECT_EQ(_cascade.numStages(), 1);
+
+	_cascade.clear();
+	EXPECT_EQ(_cascade.numStages(), 0);
+}
+
+TEST_F(BiquadCascadeTest, matchesIndividualFilters)
+{
+	ASSERT_TRUE(_cascade.allocate(4));
+
+	// batches of different size, including single samples
+	const int batch_sizes[] {1, NUM_SAMPLES, 7, 1, 16, NUM_SAMPLES};
+	int offset = 0;
+
+	for (int num_samples : batch_sizes) {
+		float data[3][NUM_SAMPLES];
+		float data_ref[3][NUM_SAMPLES];
+		generateSignal(data, offset);
+		generateSignal(data_ref, offset);
+		offset += num_samples;
+
+		applyReference(data_ref, num_samples);
+		applyCascade(data, num_samples);
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < num_samples; n++) {
+				EXPECT_NEAR(data[axis][n], data_ref[axis][n], 1e-5f) << "axis " << axis << " sample " << n;
+			}
+		}
+	}
+
+	// all notch filters initialized through the cascade
+	for (int i = 0; i < 3; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			if (_notch[i][axis].getNotchFreq() > 0.f) {
+				EXPECT_TRUE(_notch[i][axis].initialized());
+			}
+		}
+	}
+}
+
+TEST_F(BiquadCascadeTest, notchReset)
+{
+	ASSERT_TRUE(_cascade.allocate(4));
+
+	float data[3][NUM_SAMPLES];
+	float data_ref[3][NUM_SAMPLES];
+	generateSignal(data, 0);
+	generateSignal(data_ref, 0);
+	applyReference(data_ref, NUM_SAMPLES);
+	applyCascade(data, NUM_SAMPLES);
+
+	// force a notch reset on the next batch (e.g. large frequency change)
+	for (int axis = 0; axis < 3; axis++) {
+		_notch[1][axis].reset();
+		_notch_ref[1][axis].reset();
+	}
+
+	generateSignal(data, NUM_SAMPLES);
+	generateSignal(data_ref, NUM_SAMPLES);
+	applyReference(data_ref, NUM_SAMPLES);
+	applyCascade(data, NUM_SAMPLES);
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int n = 0; n < NUM_SAMPLES; n++) {
+			EXPECT_NEAR(data[axis][n], data_ref[axis][n], 1e-5f) << "axis " << axis << " sample " << n;
+		}
+	}
+}
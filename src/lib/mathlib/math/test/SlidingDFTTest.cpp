@@ -0,0 +1,220 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the sliding DFT
+ * Run this test only using make tests TESTFILTER=SlidingDFT
+ */
+
+#include <gtest/gtest.h>
+
+#include <lib/mathlib/math/filter/SlidingDFT.hpp>
+
+#include "gyro_test_data.h"
+
+using namespace math;
+
+static constexpr int N = 256;
+static constexpr float SAMPLE_FREQ = 8000.f;
+
+// Hann windowed reference DFT bin k of the last N samples
+static void referenceBin(const float *x, int num_samples, int k, float &re, float &im)
+{
+	re = 0.f;
+	im = 0.f;
+
+	for (int m = 0; m < N; m++) {
+		const float sample = x[num_samples - N + m];
+		const float window = 0.5f * (1.f - cosf(2.f * (float)M_PI * m / N));
+		const float phi = 2.f * (float)M_PI * k * m / N;
+		re += window * sample * cosf(phi);
+		im -= window * sample * sinf(phi);
+	}
+}
+
+static float signal(int n)
+{
+	const float t = n / SAMPLE_FREQ;
+	return 100.f * sinf(2.f * (float)M_PI * 156.25f * t) + 40.f * sinf(2.f * (float)M_PI * 230.f * t + 0.3f)
+	       + 20.f * cosf(2.f * (float)M_PI * 30.f * t);
+}
+
+TEST(SlidingDFTTest, invalidArguments)
+{
+	SlidingDFT sdft;
+	EXPECT_FALSE(sdft.init(N, 0, 10));
+	EXPECT_FALSE(sdft.init(N, 10, 9));
+	EXPECT_FALSE(sdft.init(N, 2, N / 2 - 1));
+	EXPECT_TRUE(sdft.init(N, 1, N / 2 - 2));
+}
+
+TEST(SlidingDFTTest, matchesDFT)
+{
+	static constexpr int BIN_FIRST = 2;
+	static constexpr int BIN_LAST = 12;
+	static constexpr int NUM_SAMPLES = 3 * N + 17;
+
+	SlidingDFT sdft;
+	ASSERT_TRUE(sdft.init(N, BIN_FIRST, BIN_LAST));
+
+	float x[NUM_SAMPLES];
+
+	for (int n = 0; n < NUM_SAMPLES; n++) {
+		x[n] = signal(n);
+		sdft.update(x[n]);
+
+		EXPECT_EQ(sdft.valid(), n >= N - 1);
+	}
+
+	float spectrum[N] {};
+	sdft.windowedSpectrum(spectrum);
+
+	for (int k = BIN_FIRST; k <= BIN_LAST; k++) {
+		float re_ref;
+		float im_ref;
+		referenceBin(x, NUM_SAMPLES, k, re_ref, im_ref);
+
+		// damping causes a small bias
+		const float tolerance = 0.01f * sqrtf(re_ref * re_ref + im_ref * im_ref) + 0.5f;
+		EXPECT_NEAR(spectrum[2 * k], re_ref, tolerance) << "bin " << k;
+		EXPECT_NEAR(spectrum[2 * k + 1], im_ref, tolerance) << "bin " << k;
+	}
+
+	// peak at 156.25 Hz (bin 5)
+	float peak_mag = 0.f;
+	int peak_bin = 0;
+
+	for (int k = BIN_FIRST; k <= BIN_LAST; k++) {
+		const float mag = sqrtf(spectrum[2 * k] * spectrum[2 * k] + spectrum[2 * k + 1] * spectrum[2 * k + 1]);
+
+		if (mag > peak_mag) {
+			peak_mag = mag;
+			peak_bin = k;
+		}
+	}
+
+	EXPECT_EQ(peak_bin, 5);
+}
+
+TEST(SlidingDFTTest, matchesDFTRecordedGyro)
+{
+	// IMU_GYRO_FFT_MIN/MAX band of the 250 Hz recording
+	const float resolution_hz = GYRO_DATA_SAMPLE_FREQ / N;
+	const int bin_first = (int)ceilf(30.f / resolution_hz);
+	const int bin_last = (int)floorf(120.f / resolution_hz);
+
+	static constexpr int NUM_SAMPLES = sizeof(gyro_data_x) / sizeof(gyro_data_x[0]);
+	const float *gyro_data[3] {gyro_data_x, gyro_data_y, gyro_data_z};
+
+	for (int axis = 0; axis < 3; axis++) {
+		SlidingDFT sdft;
+		ASSERT_TRUE(sdft.init(N, bin_first, bin_last));
+
+		sdft.update(gyro_data[axis], NUM_SAMPLES);
+		ASSERT_TRUE(sdft.valid());
+
+		float re_ref[N / 2] {};
+		float im_ref[N / 2] {};
+		float mag_max = 0.f;
+
+		for (int k = bin_first; k <= bin_last; k++) {
+			referenceBin(gyro_data[axis], NUM_SAMPLES, k, re_ref[k], im_ref[k]);
+			mag_max = fmaxf(mag_max, sqrtf(re_ref[k] * re_ref[k] + im_ref[k] * im_ref[k]));
+		}
+
+		float spectrum[N] {};
+		sdft.windowedSpectrum(spectrum);
+
+		for (int k = bin_first; k <= bin_last; k++) {
+			// damping causes a small bias, the gyro bias (DC) leaks into the whole band
+			const float tolerance = 0.02f * mag_max;
+			EXPECT_NEAR(spectrum[2 * k], re_ref[k], tolerance) << "axis " << axis << " bin " << k;
+			EXPECT_NEAR(spectrum[2 * k + 1], im_ref[k], tolerance) << "axis " << axis << " bin " << k;
+		}
+	}
+}
+
+TEST(SlidingDFTTest, longRunStable)
+{
+	SlidingDFT sdft;
+	ASSERT_TRUE(sdft.init(N, 3, 8));
+
+	// one minute at 8 kHz
+	static constexpr int NUM_SAMPLES = 60 * 8000;
+
+	for (int n = 0; n < NUM_SAMPLES; n++) {
+		sdft.update(signal(n));
+	}
+
+	float re_peak;
+	float im_peak;
+	sdft.windowedBin(5, re_peak, im_peak);
+	const float peak_mag = sqrtf(re_peak * re_peak + im_peak * im_peak);
+
+	// peak magnitude of a sine with amplitude A is A * N / 4 with the Hann window
+	EXPECT_NEAR(peak_mag, 100.f * N / 4.f, 0.01f * 100.f * N / 4.f);
+
+	// continue with silence, the spectrum must decay to zero after one window
+	// apart from accumulated float rounding errors (bounded by the damping)
+	for (int n = 0; n < N; n++) {
+		sdft.update(0.f);
+	}
+
+	for (int k = 3; k <= 8; k++) {
+		float re;
+		float im;
+		sdft.windowedBin(k, re, im);
+		EXPECT_LT(sqrtf(re * re + im * im), 5e-3f * peak_mag) << "bin " << k;
+	}
+}
+
+TEST(SlidingDFTTest, reset)
+{
+	SlidingDFT sdft;
+	ASSERT_TRUE(sdft.init(N, 3, 8));
+
+	for (int n = 0; n < 2 * N; n++) {
+		sdft.update(signal(n));
+	}
+
+	EXPECT_TRUE(sdft.valid());
+
+	sdft.reset();
+	EXPECT_FALSE(sdft.valid());
+
+	float re;
+	float im;
+	sdft.windowedBin(5, re, im);
+	EXPECT_FLOAT_EQ(re, 0.f);
+	EXPECT_FLOAT_EQ(im, 0.f);
+}
@@ -0,0 +1,47 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Recorded gyro data (rad/s) for the spectrum estimation tests and microbenchmarks:
+ * 512 consecutive samples at 250 Hz, replay data ekf_gsf_reset.csv of the ekf2 unit tests
+ */
+
+#pragma once
+
+static constexpr float GYRO_DATA_SAMPLE_FREQ = 250.f;
+
+static constexpr float gyro_data_x[512] = {-0.013275516f, -0.014692209f, -0.017163383f, -0.018157762f, -0.015646163f, -0.016242342f, -0.015054046f, -0.01279979f, -0.01553435f, -0.015938416f, -0.0144000985f, -0.015185119f, -0.017978864f, -0.020102112f, -0.017275795f, -0.01694434f, -0.021566233f, -0.019523485f, -0.019472545f, -0.021266082f, -0.023234654f, -0.023531746f, -0.018189434f, -0.015775574f, -0.019701928f, -0.022316871f, -0.018377643f, -0.014757532f, -0.021091444f, -0.024301024f, -0.020934088f, -0.019948635f, -0.018213017f, -0.021231847f, -0.022974106f, -0.022255754f, -0.021148613f, -0.020802556f, -0.019172324f, -0.02092349f, -0.02350778f, -0.021025801f, -0.0185794f, -0.017857973f, -0.021181472f, -0.020943798f, -0.01852736f, -0.018828932f, -0.020650852f, -0.018203503f, -0.015737915f, -0.016426103f, -0.01722138f, -0.016647086f, -0.014584706f, -0.015379702f, -0.015066613f, -0.012594369f, -0.014882165f, -0.015976427f, -0.01735606f, -0.019035785f, -0.018052788f, -0.019061286f, -0.017602647f, -0.015863106f, -0.013949018f, -0.015592344f, -0.01752068f, -0.019085534f, -0.02086234f, -0.01713703f, -0.015183022f, -0.018728599f, -0.017102197f, -0.01502037f, -0.01702299f, -0.015390718f, -0.015405451f, -0.018841946f, -0.016159035f, -0.013848071f, -0.016372558f, -0.018001702f, -0.015883315f, -0.012347467f, -0.012625629f, -0.013576073f, -0.0120452f, -0.014009059f, -0.016595613f, -0.012653961f, -0.009896394f, -0.008165209f, -0.006805666f, -0.009095034f, -0.012251564f, -0.008905703f, -0.004627168f, -0.002624015f, -0.003174813f, -0.008237426f, -0.0071759606f, -0.008018829f, -0.007900171f, -0.007252167f, -0.012220517f, -0.014187081f, -0.013126387f, -0.008770159f, -0.007321991f, -0.0075613176f, -0.0075735655f, -0.008078195f, -0.009805009f, -0.0066005667f, -0.00193802f, -0.005156344f, -0.008135965f, -0.009142286f, -0.009077934f, -0.0077589964f, -0.006830057f, -0.011422808f, -0.012977598f, -0.008570418f, -0.008132353f, -0.010479437f, -0.01226085f, -0.011268683f, -0.009563038f, -0.010816209f, -0.010287969f, -0.009154535f, -0.008617359f, -0.0074448152f, -0.007811642f, -0.006217068f, -0.0059020985f, -0.0023133561f, -0.0026765047f, -0.0019574547f, 0.0014765235f, -0.0011696029f, -0.0024170526f, -0.004148321f, -0.0061695366f, -0.0046906555f, -0.0012285364f, -0.0011381863f, -0.0021183442f, -0.003930238f, -0.0052370895f, -0.0069007226f, -0.003476999f, -0.00036640087f, -0.0023143284f, -0.0024175362f, -0.0044843173f, -0.006280112f, -0.006425497f, -0.0041176556f, -0.0028059247f, -0.0022507592f, -0.002747668f, -0.0051063355f, -0.004994021f, -0.004870179f, -0.00533712f, -0.004359301f, -0.0038894454f, -0.003942919f, -0.003716639f, -0.005812491f, -0.0058467085f, -0.0033100229f, -0.0035518953f, -0.002833176f, -0.002363832f, -0.00034158488f, -0.0005787739f, -0.0019488435f, -0.00023095847f, -0.00085568114f, 0.00017031783f, 0.0039257687f, 0.0046866573f, 0.0022945318f, -0.0006838354f, -0.0021253442f, -0.0041144765f, -0.0059579164f, -0.0012767634f, -0.0007260475f, -0.004093807f, -0.0047588744f, -0.0035064574f, -0.0023152886f, -0.0044438154f, -0.0065134955f, -0.005086808f, -0.0044400645f, -0.0041758595f, -0.000756561f, -0.0019395275f, -0.0018116103f, 0.001890912f, 0.00068789267f, 0.00023821273f, -0.0021145926f, -0.004798195f, -0.0009338557f, 0.002316626f, 0.0026246782f, 0.0023857884f, 0.0013550883f, 0.0026968482f, 0.0043327794f, -0.00065095455f, -0.002133798f, -7.0540766e-05f, -0.00095578795f, -0.004564741f, -0.005590545f, -0.0027164936f, -0.0017402936f, -0.001124468f, -0.002405692f, -0.0015055233f, -0.0007676346f, -0.002446084f, -0.0008574568f, 0.002808576f, 0.003082584f, 0.0024077708f, 0.0011436441f, -0.0017866567f, -0.0005300745f, -0.0011937089f, -0.004739446f, -0.0031318613f, -0.0025411514f, -0.0034388716f, -0.0009112795f, -0.0020432537f, -0.0050290683f, -0.004636569f, -0.004880053f, -0.0059303395f, -0.004588312f, -0.004542059f, -0.0065927734f, -0.006906242f, -0.0064219446f, -0.00741745f, -0.0071262848f, -0.002941907f, -0.0012804904f, -0.00095521443f, -0.0015094231f, -0.0038331237f, -0.0017154835f, 0.0023058427f, 0.0010388872f, 0.00051653525f, 0.0022020582f, 0.0012088591f, -0.0030037614f, -0.005018751f, -0.0019983547f, -0.001856378f, -0.0023347773f, -0.0031773448f, -0.0055864817f, -0.0032597084f, -0.0024754705f, -0.004203534f, -0.003691336f, -0.0031944122f, -0.0032740156f, -0.0021322796f, -0.0016469208f, -0.0028062118f, -0.003050719f, -0.00058223045f, -0.0003264925f, 0.0010341188f, 0.017212277f, 0.041149445f, 0.06591282f, 0.096286416f, 0.13106337f, 0.16752638f, 0.20466891f, 0.23753871f, 0.2671055f, 0.29509994f, 0.3182875f, 0.33477017f, 0.34708226f, 0.35325575f, 0.3540817f, 0.34930754f, 0.34038544f, 0.32791978f, 0.3096827f, 0.28901592f, 0.2689503f, 0.24499384f, 0.21695888f, 0.19199513f, 0.16252556f, 0.13310812f, 0.10889828f, 0.085754566f, 0.06371826f, 0.044557117f, 0.026711747f, 0.00644102f, -0.0068710884f, -0.017475147f, -0.02615768f, -0.03414776f, -0.03921561f, -0.04094765f, -0.04287599f, -0.037487697f, -0.03495463f, -0.033326045f, -0.026332477f, -0.021930512f, -0.014238688f, -0.006591021f, -0.0016859611f, 0.006385246f, 0.00982436f, 0.015666325f, 0.023554519f, 0.0276264f, 0.031244574f, 0.038066357f, 0.042253066f, 0.04153832f, 0.046935182f, 0.050181434f, 0.04774623f, 0.0461377f, 0.046117242f, 0.046797205f, 0.04466272f, 0.039654754f, 0.036128074f, 0.03632662f, 0.03610679f, 0.033736672f, 0.032982368f, 0.026175842f, 0.019135732f, 0.015321966f, 0.006816441f, 0.0024167593f, -0.00071093003f, -0.0044865147f, -0.007856271f, -0.01266808f, -0.020350212f, -0.02866264f, -0.032767184f, -0.03581415f, -0.04185821f, -0.045684732f, -0.04808549f, -0.054119755f, -0.05745707f, -0.06027466f, -0.06668273f, -0.070299655f, -0.071338266f, -0.073229514f, -0.07475279f, -0.07460656f, -0.07467049f, -0.077379405f, -0.081149206f, -0.08175681f, -0.08253826f, -0.08405279f, -0.0858662f, -0.0867838f, -0.08121244f, -0.08164806f, -0.0866734f, -0.08584843f, -0.08291416f, -0.082389556f, -0.08595157f, -0.08715462f, -0.086861365f, -0.08509589f, -0.084022425f, -0.084957846f, -0.08477821f, -0.08354538f, -0.08280619f, -0.082027175f, -0.07873827f, -0.077678226f, -0.07700377f, -0.07593681f, -0.07479012f, -0.074987695f, -0.07426596f, -0.072010174f, -0.07140963f, -0.06828111f, -0.06783918f, -0.06748659f, -0.06702693f, -0.0672683f, -0.065907925f, -0.06328062f, -0.06179737f, -0.061598875f, -0.057673614f, -0.058554865f, -0.05926266f, -0.051591143f, -0.048067167f, -0.0500091f, -0.04821877f, -0.04631466f, -0.044941187f, -0.04648156f, -0.047174666f, -0.042126734f, -0.04006583f, -0.04584431f, -0.048414372f, -0.04562562f, -0.04502334f, -0.044480428f, -0.043479793f, -0.041061807f, -0.040194277f, -0.041147843f, -0.041968342f, -0.042295054f, -0.03980108f, -0.037405416f, -0.037264325f, -0.034237567f, -0.03282738f, -0.032875907f, -0.030700568f, -0.028899172f, -0.028772771f, -0.028815847f, -0.025745258f, -0.020238273f, -0.020867683f, -0.02400838f, -0.02062206f, -0.02044469f, -0.023542032f, -0.024284184f, -0.025960885f, -0.030851312f, -0.03641116f, -0.03845156f, -0.04431984f, -0.04818437f, -0.05110543f, -0.057228386f, -0.061618995f, -0.06573202f, -0.07130509f, -0.081364f, -0.08613526f, -0.08735565f, -0.09224176f, -0.09845202f, -0.103743345f, -0.103576005f, -0.10486012f, -0.10855164f, -0.11344022f, -0.11385246f, -0.11086208f, -0.11089638f, -0.1124045f, -0.11444763f, -0.114446566f, -0.11211461f, -0.10808907f, -0.10828975f, -0.107547194f, -0.1029886f, -0.09711365f, -0.095830634f, -0.093410626f, -0.08904217f, -0.08702646f, -0.08270097f, -0.07669144f, -0.07245491f, -0.07139773f, -0.067377366f, -0.060793195f, -0.05707456f, -0.056883212f, -0.053852618f, -0.046088092f};
+
+static constexpr float gyro_data_y[512] = {-0.011153468f, -0.011895286f, -0.011727182f, -0.010109528f, -0.011048669f, -0.013073885f, -0.017266914f, -0.0151969595f, -0.015011592f, -0.011642909f, -0.008650291f, -0.01359158f, -0.014799959f, -0.015639953f, -0.017095491f, -0.013591098f, -0.011639374f, -0.009566436f, -0.010461695f, -0.014907756f, -0.01356182f, -0.011730136f, -0.012674159f, -0.014307952f, -0.015361487f, -0.013177581f, -0.011763318f, -0.016695688f, -0.01622339f, -0.016954405f, -0.015091644f, -0.012961034f, -0.012166708f, -0.014101691f, -0.018666126f, -0.012871752f, -0.013541261f, -0.015800348f, -0.014897029f, -0.014065573f, -0.013142947f, -0.014203597f, -0.014900322f, -0.014975965f, -0.016569525f, -0.016299805f, -0.01359562f, -0.015714949f, -0.017862486f, -0.014621907f, -0.014013535f, -0.014676046f, -0.010404717f, -0.011202934f, -0.015207305f, -0.013429603f, -0.00978553f, -0.012162024f, -0.010970893f, -0.009492744f, -0.01448852f, -0.013575365f, -0.012853904f, -0.014797843f, -0.015441919f, -0.016660294f, -0.0154369995f, -0.010050075f, -0.010637325f, -0.015206999f, -0.01579067f, -0.013673873f, -0.011694706f, -0.014610621f, -0.015894081f, -0.016355116f, -0.014127538f, -0.012115766f, -0.0161752f, -0.015713666f, -0.012563096f, -0.010619327f, -0.011086678f, -0.01252592f, -0.011569672f, -0.010196179f, -0.010482519f, -0.013220405f, -0.014163755f, -0.01249019f, -0.009625937f, -0.008832025f, -0.01262004f, -0.010713759f, -0.008058656f, -0.010242415f, -0.012735056f, -0.011912034f, -0.010288716f, -0.009098383f, -0.0070987763f, -0.0078545f, -0.0081648175f, -0.00966206f, -0.010334833f, -0.0095314775f, -0.010404322f, -0.01004802f, -0.007325709f, -0.0047192243f, -0.0061630914f, -0.0074556707f, -0.00704956f, -0.0067645125f, -0.007750108f, -0.0061657755f, -0.004439916f, -0.005554782f, -0.003815375f, -0.0069283075f, -0.01143359f, -0.009644941f, -0.00833182f, -0.0066682f, -0.008478979f, -0.011374753f, -0.011413575f, -0.009918504f, -0.006982913f, -0.007856543f, -0.006863035f, -0.008009588f, -0.012031737f, -0.01220298f, -0.010208872f, -0.008214582f, -0.0097174f, -0.012262222f, -0.0104181f, -0.0071771727f, -0.010012352f, -0.009808177f, -0.008577616f, -0.010841402f, -0.009038879f, -0.0054749446f, -0.004438554f, -0.0074507645f, -0.010720161f, -0.007932343f, -0.0034828284f, -0.0013768905f, -0.0027395014f, -0.0049921684f, -0.0060396153f, -0.005622714f, -0.005580388f, -0.006295936f, -0.0059637213f, -0.0075905924f, -0.005214152f, -0.005439644f, -0.0101158535f, -0.008844584f, -0.008666881f, -0.010954935f, -0.010720027f, -0.010972573f, -0.009361341f, -0.0061232303f, -0.0030228656f, -0.0036649378f, -0.0076758014f, -0.008361683f, -0.0032788536f, -0.0009519643f, -0.0037408026f, -0.0077302037f, -0.0068927053f, -0.0026790707f, -0.0058949436f, -0.008887451f, -0.004293924f, -0.0031527728f, -0.005029144f, -0.0064054327f, -0.00746682f, -0.00832634f, -0.0072682826f, -0.0049717575f, -0.0053763757f, -0.006605093f, -0.0070667295f, -0.0034963565f, -0.004449436f, -0.0027275782f, 0.0005020618f, -0.0063589243f, -0.008793843f, -0.005431536f, -0.0040494357f, -0.0071369717f, -0.009494572f, -0.0076659424f, -0.006358838f, -0.0064809136f, -0.008385065f, -0.009789049f, -0.008974278f, -0.008435293f, -0.006016315f, -0.0056139478f, -0.0070118164f, -0.0056137857f, -0.005257479f, -0.007083788f, -0.0066285334f, -0.0035423727f, -0.0028977552f, -0.005478776f, -0.0072564743f, -0.0089870235f, -0.0069350055f, -0.0037873976f, -0.005680733f, -0.009840404f, -0.009561168f, -0.0048778504f, -0.0045339544f, -0.007101092f, -0.008581155f, -0.007865257f, -0.007975395f, -0.008392128f, -0.007958432f, -0.009188021f, -0.009574791f, -0.010464614f, -0.011229551f, -0.006963343f, -0.0041181357f, -0.0056010755f, -0.0054751304f, -0.0058748703f, -0.008647398f, -0.0072753006f, -0.0064512035f, -0.0052401796f, -0.0034905532f, -0.0036786525f, -0.004853215f, -0.0055014207f, -0.0058420515f, -0.005687735f, -0.005131705f, -0.004117962f, -0.0025151428f, -0.0053366413f, -0.0047203624f, -0.0039686095f, -0.00838534f, -0.007283941f, -0.0046760226f, -0.0057971184f, -0.006721454f, -0.006662102f, -0.0076468084f, -0.008952618f, -0.0056269327f, -0.00526924f, -0.009039822f, -0.007970653f, -0.0047050556f, -0.0050976845f, -0.007218167f, -0.0045285462f, -0.002218318f, -0.0054752026f, -0.0068607666f, -0.0047573154f, -0.0059124576f, -0.0071958024f, -0.006422864f, -0.006270409f, -0.010753064f, -0.013866752f, -0.011040082f, -0.01516772f, -0.024423325f, -0.037378754f, -0.055783335f, -0.07514366f, -0.09740343f, -0.11903176f, -0.13763921f, -0.16054603f, -0.18143436f, -0.19425794f, -0.2060781f, -0.21650168f, -0.22537977f, -0.23204833f, -0.23222636f, -0.23188621f, -0.23099807f, -0.21808296f, -0.20457676f, -0.19801296f, -0.19382437f, -0.18383667f, -0.17024599f, -0.15643162f, -0.13952495f, -0.12432625f, -0.10934991f, -0.09427541f, -0.086148106f, -0.08122371f, -0.070944026f, -0.056055415f, -0.047307387f, -0.04323673f, -0.03649172f, -0.028509507f, -0.020647768f, -0.01399724f, -0.0125678545f, -0.009233298f, -0.00061651086f, 0.0051555927f, 0.0126458295f, 0.016398316f, 0.021793898f, 0.027876554f, 0.03381609f, 0.044617355f, 0.054010767f, 0.059229262f, 0.06623234f, 0.073677205f, 0.07753114f, 0.08521417f, 0.09344811f, 0.10237369f, 0.111288436f, 0.11521518f, 0.12312953f, 0.13253494f, 0.13647954f, 0.1413842f, 0.14710774f, 0.14972496f, 0.15349187f, 0.15623467f, 0.1566988f, 0.15635075f, 0.15746255f, 0.15857825f, 0.15861677f, 0.1609149f, 0.16114236f, 0.16142689f, 0.16010267f, 0.1563112f, 0.1553246f, 0.15400563f, 0.14857815f, 0.1445078f, 0.14485821f, 0.1450361f, 0.14111045f, 0.13694566f, 0.1344427f, 0.13275953f, 0.1261578f, 0.12127436f, 0.120850846f, 0.119350106f, 0.11744447f, 0.11244881f, 0.10690732f, 0.10492645f, 0.10234259f, 0.094147086f, 0.08762176f, 0.085251644f, 0.08200788f, 0.07977972f, 0.07583549f, 0.073051624f, 0.072557025f, 0.06771001f, 0.06274538f, 0.06052269f, 0.058124218f, 0.054563425f, 0.054510575f, 0.05569699f, 0.053829733f, 0.049791716f, 0.050956864f, 0.05108105f, 0.04501493f, 0.041696683f, 0.043833595f, 0.043038744f, 0.040320866f, 0.03922955f, 0.039765395f, 0.039329037f, 0.03767247f, 0.03655153f, 0.03375117f, 0.029647622f, 0.029138269f, 0.026777167f, 0.023818523f, 0.024883242f, 0.021518236f, 0.021067673f, 0.018241549f, 0.014674635f, 0.01670704f, 0.015210306f, 0.010863757f, 0.009886895f, 0.008488051f, 0.007972076f, 0.009401742f, 0.0067384434f, 0.0055474225f, 0.0059843026f, 0.0076226867f, 0.00905486f, 0.008338845f, 0.009031362f, 0.0074180216f, 0.003328084f, 0.0023592003f, 0.0035608548f, 0.006510048f, 0.006292038f, 0.002230001f, 0.006538633f, 0.010873742f, 0.008779141f, 0.0075933486f, 0.0046034134f, 0.0030574298f, 0.0043803523f, 0.004242666f, 0.0031740898f, 0.0019017892f, 0.0015916387f, 0.0018904568f, 0.0034719356f, 0.0027025682f, 0.0009854804f, 0.0019489457f, 0.0014154662f, 0.0005619203f, 3.0021532e-05f, -0.0020169471f, -0.003359741f, -0.003437091f, -0.003444403f, -0.005710814f, -0.0069418442f, -0.0071174875f, -0.009023254f, -0.010260693f, -0.011340158f, -0.012984091f, -0.018100759f, -0.025056753f, -0.024218855f, -0.021420913f, -0.021249365f, -0.023094628f, -0.02819384f, -0.030317385f, -0.028742341f, -0.029877366f, -0.031868324f, -0.030944956f, -0.033466473f, -0.03400931f, -0.032299f, -0.03340676f, -0.037230074f, -0.03854211f, -0.034906015f, -0.03618821f, -0.03740251f, -0.03517709f, -0.03449705f, -0.03687614f, -0.039121263f, -0.037802033f, -0.03763725f, -0.037866123f, -0.03548409f, -0.035946198f, -0.03640212f, -0.034230575f, -0.0319596f, -0.031440843f, -0.033353224f, -0.033945818f, -0.038645692f, -0.0417654f, -0.033925742f};
+
+static constexpr float gyro_data_z[512] = {-0.0005998494f, -0.0013222647f, 0.0022001937f, 0.0012168142f, 0.0011746789f, 0.00111851f, 0.0022193627f, 0.0031134703f, 0.0019279706f, -0.00042944588f, -0.002112432f, 0.00012067453f, 0.0029250102f, 0.003409862f, 0.0010109564f, 0.0029705125f, 0.00291148f, -0.0010668349f, 0.00061850133f, 0.0022740725f, 0.0036299801f, -0.0010677137f, -0.003998621f, -0.0004497472f, 0.0018426019f, 0.00094540464f, -0.00092337327f, -0.0022067067f, -0.004885138f, -0.0019245615f, -0.0012533637f, -0.0022537946f, 0.0019281061f, 0.0034743364f, 0.0009249546f, -0.00028796055f, 0.00026871313f, 0.0026563792f, 0.0014752194f, 0.000178241f, -0.0010806964f, -0.002827179f, -0.0019427675f, 0.0022459668f, 0.0032299045f, 0.0019497139f, 0.0011555176f, -0.003419525f, -0.0007490294f, 0.0042737713f, 0.00312691f, 0.00060372625f, 0.0018142591f, 0.0037709796f, 0.003433499f, -0.00028245256f, -0.003139412f, -0.0036401001f, -0.0023878622f, 2.2057018e-05f, 4.2534997e-05f, 0.00064831093f, 0.00026528214f, 0.00015806546f, 0.0022337302f, 0.0015714333f, 0.002814866f, 0.00023559653f, -0.0006767667f, -0.0015445481f, -0.0031228466f, -2.9779918e-05f, -0.00018954033f, 0.0006125256f, 0.00278753f, 0.00062397274f, -0.0019623092f, 0.000261925f, 0.0010981349f, 0.00066907454f, -0.00015786517f, 0.00088333874f, 0.0033047537f, 0.004549346f, 0.0019882757f, 0.0023397645f, 0.0048032706f, 0.0029193766f, 0.0030188097f, 0.0015688376f, -0.00087837636f, -0.0040193056f, -0.0003601679f, 0.0023188214f, -0.00127565f, 0.0053961193f, 0.00656824f, 0.0026858968f, 0.00221391f, 0.0035674942f, 0.004377148f, 0.002444234f, -0.00070794526f, 0.0012635001f, 0.0039215605f, 0.0009220953f, -0.0015190296f, -0.001879332f, 0.0020334146f, 0.0047054f, 0.006426903f, 0.008054896f, 0.0034320662f, -0.00018371265f, 0.004333162f, 0.006416181f, 0.0029357206f, 0.0033825575f, 0.0052984883f, 0.00442398f, 0.0022857508f, 0.0011936656f, 0.0024627952f, 0.0032325815f, 0.0031970835f, 0.002083977f, 0.0005129201f, 0.0022966398f, 0.0051175132f, 0.004906656f, 0.0040899524f, 0.0024625952f, -0.0003059167f, 0.001155619f, 0.004544988f, 0.0038391748f, 0.001453964f, 0.00020845933f, 0.0017434941f, 0.000478706f, 0.00031680643f, 0.0016504648f, 0.00018236763f, -0.0014682128f, 0.00079250394f, 0.0007370077f, -0.00025820953f, 0.00086658495f, -0.0010623459f, -0.00071392243f, 0.0009285831f, 0.0005364481f, 0.0017338414f, 0.0011137667f, 3.3711523e-05f, 0.0022947188f, 0.0025871645f, 0.0024579298f, 0.003071269f, 0.0044543953f, 0.0020021137f, 0.0025926575f, 0.0036534925f, 0.0022336454f, 0.0015446917f, 0.000577772f, 0.002367255f, 0.0026448655f, 0.003648854f, 0.0024253551f, 0.0027266354f, 0.0049643484f, 0.0010265164f, -0.00061950716f, 0.0029717884f, 0.0037176544f, 0.0022038608f, 0.0021912341f, 0.0004972854f, -0.00020716216f, -0.00018459547f, -0.0014621707f, 0.001753878f, 0.0028104219f, 0.0013027122f, 0.0022919653f, 0.0018178445f, 9.428403e-05f, -0.0014792181f, -0.002135198f, 0.00057960174f, 0.0033138108f, 0.00023676812f, -0.00040345395f, 0.0013018273f, 0.0006394542f, 0.00078894466f, -0.00075333455f, -0.00031640707f, -6.4777305e-05f, 0.00041831366f, 0.0051260316f, 0.0053162086f, 0.00057419186f, -0.002041186f, -0.0016453092f, 0.0021951986f, 0.0070815026f, 0.006494622f, 0.003720968f, 0.0019954364f, 0.0029449984f, 0.003047453f, 0.0006229473f, -0.00034508738f, 0.0016384452f, 0.003113286f, 0.0031688751f, 0.006248945f, 0.006361151f, 0.0026190553f, 0.001552268f, 0.00065093423f, -0.0005881765f, 0.0009813851f, 0.0031967591f, 0.00470057f, 0.004361392f, 0.0021671911f, 0.0013628304f, 0.0040490273f, 0.008766677f, 0.005949034f, 0.0048680874f, 0.006038091f, 0.0011257154f, 0.0026306144f, 0.0016472726f, -0.0002846475f, 0.004526676f, 0.0032485295f, 0.0035955121f, 0.004258318f, 0.0003648718f, 0.0026172856f, 0.0066219848f, 0.007299639f, 0.0049883234f, 0.002069422f, 0.001980978f, 0.0031313472f, 0.0014646145f, 0.0007619426f, -0.00038890328f, -0.0008882936f, -0.0001143886f, 0.0008539867f, -0.0003362634f, 0.00072691013f, 0.0029849522f, -0.00081253384f, -0.0025620768f, 0.00018675934f, 0.0035039731f, 0.0054560467f, 0.00435635f, 0.0013777204f, 0.0017497086f, 0.0005658914f, -0.0010968837f, 0.00019479815f, 0.00061870494f, 0.002530012f, 0.005969117f, 0.002920466f, 0.0014713588f, 0.0025115614f, 0.00457985f, 0.006767834f, 0.0025329532f, 0.0027187248f, 0.0020225642f, 0.003801465f, 0.0064817434f, 0.0028389061f, 0.0029201242f, 0.0132294595f, 0.034963768f, 0.07214754f, 0.12007566f, 0.1710076f, 0.2271409f, 0.28559625f, 0.34926015f, 0.41986644f, 0.48799217f, 0.55684483f, 0.6286857f, 0.69813544f, 0.7688364f, 0.8366667f, 0.9034258f, 0.9720159f, 1.0420774f, 1.1098552f, 1.1769567f, 1.2446896f, 1.3116353f, 1.3718872f, 1.4311696f, 1.492592f, 1.5537738f, 1.616745f, 1.6719053f, 1.7279792f, 1.7878045f, 1.8453774f, 1.8936627f, 1.9457211f, 1.9998811f, 2.0506442f, 2.1019185f, 2.1473281f, 2.1939042f, 2.238241f, 2.282754f, 2.3304367f, 2.3715692f, 2.409503f, 2.4489684f, 2.4849582f, 2.5201616f, 2.5559978f, 2.5916843f, 2.6239176f, 2.6534712f, 2.6844995f, 2.714013f, 2.742372f, 2.7732487f, 2.801041f, 2.8254824f, 2.8489907f, 2.871532f, 2.8987398f, 2.9232857f, 2.9418178f, 2.9667933f, 2.9858403f, 2.9988382f, 3.0177228f, 3.038275f, 3.0580297f, 3.0755222f, 3.0923798f, 3.1075258f, 3.1227732f, 3.137217f, 3.1483114f, 3.1610003f, 3.1744797f, 3.1888616f, 3.201304f, 3.2125142f, 3.2212646f, 3.2295609f, 3.2401319f, 3.2491536f, 3.2579312f, 3.265307f, 3.2700872f, 3.2776062f, 3.292422f, 3.2977962f, 3.2996385f, 3.3094964f, 3.3145783f, 3.3221116f, 3.3295681f, 3.3297813f, 3.3343618f, 3.3388538f, 3.340754f, 3.3449214f, 3.3497427f, 3.3520036f, 3.3545768f, 3.3559303f, 3.3613665f, 3.3652477f, 3.3652358f, 3.370371f, 3.3722095f, 3.3742785f, 3.3771462f, 3.3791964f, 3.377928f, 3.3795083f, 3.3827362f, 3.3823428f, 3.382452f, 3.3849058f, 3.389156f, 3.389289f, 3.385663f, 3.385377f, 3.3897028f, 3.3894567f, 3.3901215f, 3.3935294f, 3.3939104f, 3.3927457f, 3.3899932f, 3.3915153f, 3.3922162f, 3.3931723f, 3.3948793f, 3.390064f, 3.3893828f, 3.3898628f, 3.3895812f, 3.39127f, 3.3904772f, 3.3888059f, 3.3908224f, 3.392126f, 3.39391f, 3.394662f, 3.393608f, 3.3957021f, 3.3963714f, 3.3948493f, 3.394429f, 3.3947191f, 3.3935926f, 3.3961606f, 3.3965306f, 3.3938835f, 3.3956547f, 3.394908f, 3.3972697f, 3.3973336f, 3.3945222f, 3.395992f, 3.3961484f, 3.3926992f, 3.3907523f, 3.3922043f, 3.393349f, 3.3939748f, 3.3947978f, 3.39724f, 3.399069f, 3.397452f, 3.3975391f, 3.3985846f, 3.3959985f, 3.3960176f, 3.3943157f, 3.3932476f, 3.3963175f, 3.3953214f, 3.3938265f, 3.3900976f, 3.3847876f, 3.3816137f, 3.380075f, 3.3755994f, 3.3699765f, 3.3600583f, 3.348058f, 3.338199f, 3.3246775f, 3.312193f, 3.298274f, 3.2844172f, 3.2664018f, 3.2445617f, 3.228882f, 3.213019f, 3.1897674f, 3.167048f, 3.14569f, 3.1227546f, 3.0996785f, 3.0747828f, 3.0470035f, 3.0196745f, 2.995634f, 2.9708388f, 2.942075f, 2.9104955f, 2.8806655f, 2.8570619f, 2.8285124f, 2.796183f, 2.76779f, 2.7372446f, 2.704877f, 2.672989f, 2.6444087f, 2.614873f, 2.5836368f, 2.5539346f, 2.5237226f, 2.494142f, 2.4668322f, 2.4348865f, 2.4020298f, 2.371317f, 2.336279f, 2.3052168f};
@@ -14,6 +14,87 @@
 namespace matrix
 {
 
+template<typename Type>
+Type typeEpsilon();
+
+template<> inline
+float typeEpsilon<float>()
+{
+	return FLT_EPSILON;
+}
+
+/**
+ * Geninv of a wide matrix G (M <= N) from its precomputed Gram matrix G * G^T
+ *
+ * Useful when the Gram matrix is updated incrementally, e.g. if only a few columns of G change.
+ */
+template<typename Type, size_t M, size_t N>
+bool geninvGram(const Matrix<Type, M, N> &G, const SquareMatrix<Type, M> &GGt, Matrix<Type, N, M> &res)
+{
+	size_t rank;
+	const SquareMatrix<Type, M> L = fullRankCholesky(GGt, rank);
+
+	// Rows of G with (numerically) zero norm do not contribute to the rank.
+	// If they are the only reason for rank deficiency, the remaining rows are independent and
+	// pinv(G) = G^T * (G * G^T)^-1 restricted to them, computed by two triangular solves with L.
+	const Type tol = M * typeEpsilon<Type>() * GGt.diag().max();
+	size_t pivot_rows[M];
+	size_t num_pivot_rows = 0;
+
+	for (size_t k = 0; k < M; k++) {
+		if (GGt(k, k) > tol) {
+			pivot_rows[num_pivot_rows++] = k;
+		}
+	}
+
+	if (num_pivot_rows == rank) {
+		res = Matrix<Type, N, M>();
+
+		for (size_t i = 0; i < N; i++) {
+			Type y[M];
+
+			// forward substitution: L_p * y = G_p(:, i)
+			for (size_t a = 0; a < rank; a++) {
+				Type sum = G(pivot_rows[a], i);
+
+				for (size_t b = 0; b < a; b++) {
+					sum -= L(pivot_rows[a], b) * y[b];
+				}
+
+				y[a] = sum / L(pivot_rows[a], a);
+			}
+
+			// back substitution: L_p^T * z = y
+			for (size_t a = rank; a-- > 0;) {
+				Type sum = y[a];
+
+				for (size_t b = a + 1; b < rank; b++) {
+					sum -= L(pivot_rows[b], a) * y[b];
+				}
+
+				y[a] = sum / L(pivot_rows[a], a);
+				res(i, pivot_rows[a]) = y[a];
+			}
+		}
+
+		return true;
+	}
+
+	SquareMatrix<Type, M> A = L.transpose() * L;
+	SquareMatrix<Type, M> X;
+
+	if (!inv(A, X, rank)) {
+		res = Matrix<Type, N, M>();
+		return false; // LCOV_EXCL_LINE -- this can only be hit from numerical issues
+	}
+
+	// doing an intermediate assignment reduces stack usage
+	A = X * X * L.transpose();
+	res = G.transpose() * (L * A);
+
+	return true;
+}
+
 /**
  * Geninv
  * Fast pseudoinverse based on full rank cholesky factorisation
@@ -26,20 +107,8 @@ bool geninv(const Matrix<Type, M, N> &G, Matrix<Type, N, M> &res)
 	size_t rank;
 
 	if (M <= N) {
-		SquareMatrix<Type, M> A = G * G.transpose();
-		SquareMatrix<Type, M> L = fullRankCholesky(A, rank);
-
-		A = L.transpose() * L;
-		SquareMatrix<Type, M> X;
-
-		if (!inv(A, X, rank)) {
-			res = Matrix<Type, N, M>();
-			return false; // LCOV_EXCL_LINE -- this can only be hit from numerical issues
-		}
-
-		// doing an intermediate assignment reduces stack usage
-		A = X * X * L.transpose();
-		res = G.transpose() * (L * A);
+		const SquareMatrix<Type, M> A = G * G.transpose();
+		return geninvGram(G, A, res);
 
 	} else {
 		SquareMatrix<Type, N> A = G.transpose() * G;
@@ -62,15 +131,6 @@ bool geninv(const Matrix<Type, M, N> &G, Matrix<Type, N, M> &res)
 }
 
 
-template<typename Type>
-Type typeEpsilon();
-
-template<> inline
-float typeEpsilon<float>()
-{
-	return FLT_EPSILON;
-}
-
 /**
  * Full rank Cholesky factorization of A
  */
@@ -232,6 +232,32 @@ public:
 		}
 	}
 
+	// symmetric rank one update of a symmetric matrix: this += alpha * v * v^T
+	// only the upper triangle is computed (contiguous rows) and copied to the lower triangle,
+	// rows and columns corresponding to zero entries of v are left untouched
+	void symmetricRankOneUpdate(const Vector<Type, M> &v, const Type alpha)
+	{
+		SquareMatrix<Type, M> &self = *this;
+
+		for (size_t row_idx = 0; row_idx < M; row_idx++) {
+			if (!(std::fabs(v(row_idx)) > Type(0))) {
+				continue;
+			}
+
+			const Type alpha_v_row = alpha * v(row_idx);
+
+			for (size_t col_idx = row_idx; col_idx < M; col_idx++) {
+				self(row_idx, col_idx) += alpha_v_row * v(col_idx);
+			}
+
+			for (size_t col_idx = row_idx + 1; col_idx < M; col_idx++) {
+				if (std::fabs(v(col_idx)) > Type(0)) {
+					self(col_idx, row_idx) = self(row_idx, col_idx);
+				}
+			}
+		}
+	}
+
 	// checks if block diagonal is symmetric
 	template <size_t Width>
 	bool isBlockSymmetric(size_t first, const Type eps = Type(1e-8f))
@@ -173,3 +173,40 @@ TEST(MatrixPseudoInverseTest, PseudoInverse)
 	Matrix<float, 6, 5> real_pinv_expected(real_pinv_expected_alloc);
 	EXPECT_EQ(real_pinv, real_pinv_expected);
 }
+
+TEST(MatrixPseudoInverseTest, PseudoInverseGram)
+{
+	// Moore-Penrose conditions for wide matrices with zero rows and with linearly dependent rows
+	Matrix<float, 6, 12> G;
+
+	for (size_t i = 0; i < 12; i++) {
+		for (size_t j = 0; j < 6; j++) {
+			G(j, i) = sinf(1.3f * i + 0.7f * j);
+		}
+	}
+
+	for (int test = 0; test < 3; test++) {
+		if (test == 1) {
+			// zero rows, e.g. an effectiveness matrix without lateral thrust
+			G.row(3) = 0.f;
+			G.row(4) = 0.f;
+
+		} else if (test == 2) {
+			// dependent rows
+			G.row(4) = G.row(0) * 2.f;
+		}
+
+		const SquareMatrix<float, 6> GGt = G * G.transpose();
+		Matrix<float, 12, 6> P;
+		EXPECT_TRUE(geninvGram(G, GGt, P));
+
+		const Matrix<float, 6, 12> GPG = G * P * G;
+		const Matrix<float, 12, 6> PGP = P * G * P;
+		const SquareMatrix<float, 6> GP = G * P;
+		const SquareMatrix<float, 12> PG = P * G;
+		EXPECT_TRUE(isEqual(GPG, G, 1e-4f)) << test;
+		EXPECT_TRUE(isEqual(PGP, P, 1e-4f)) << test;
+		EXPECT_TRUE(isEqual(GP, GP.transpose(), 1e-4f)) << test;
+		EXPECT_TRUE(isEqual(PG, PG.transpose(), 1e-4f)) << test;
+	}
+}
@@ -175,3 +175,43 @@ TEST(MatrixSquareTest, Square)
 	SquareMatrix<float, 4> K(data_K);
 	EXPECT_FALSE(K.isRowColSymmetric<1>(2));
 }
+
+TEST(MatrixSquareTest, SymmetricRankOneUpdate)
+{
+	float data[16] = {4, 1, 2, 0.5,
+			  1, 5, 3, 1,
+			  2, 3, 6, 2,
+			  0.5, 1, 2, 7
+			 };
+	SquareMatrix<float, 4> P(data);
+	const Vector4f v(0.5f, 0.f, -1.f, 2.f);
+	const float alpha = -0.25f;
+
+	SquareMatrix<float, 4> P_check = P + (Matrix<float, 4, 1>(v) * v.transpose()) * alpha;
+	P.symmetricRankOneUpdate(v, alpha);
+	EXPECT_TRUE(isEqual(P, P_check));
+	EXPECT_TRUE(P.isBlockSymmetric<4>(0));
+
+	// row and column of the zero entry are untouched
+	EXPECT_FLOAT_EQ(P(1, 0), 1.f);
+	EXPECT_FLOAT_EQ(P(1, 1), 5.f);
+	EXPECT_FLOAT_EQ(P(3, 1), 1.f);
+
+	// larger matrix with several zero entries, as used by the EKF covariance update
+	SquareMatrix<float, 24> Q;
+	Vector<float, 24> w;
+
+	for (size_t i = 0; i < 24; i++) {
+		w(i) = (i % 3 == 0) ? 0.f : 0.1f * i - 1.f;
+
+		for (size_t j = i; j < 24; j++) {
+			Q(i, j) = (i == j) ? 10.f : 0.01f * (i + j);
+			Q(j, i) = Q(i, j);
+		}
+	}
+
+	SquareMatrix<float, 24> Q_check = Q - (Matrix<float, 24, 1>(w) * w.transpose()) * 0.5f;
+	Q.symmetricRankOneUpdate(w, -0.5f);
+	EXPECT_TRUE(isEqual(Q, Q_check, 1e-6f));
+	EXPECT_TRUE(Q.isBlockSymmetric<24>(0));
+}
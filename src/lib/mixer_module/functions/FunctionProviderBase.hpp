@@ -67,6 +67,7 @@ public:
 	virtual uORB::SubscriptionCallbackWorkItem *subscriptionCallback() { return nullptr; }
 
 	virtual bool getLatestSampleTimestamp(hrt_abstime &t) const { return false; }
+	virtual bool getLatestTimestamp(hrt_abstime &t) const { return false; }
 
 	/**
 	 * Check whether the output (motor) is configured to be reversible
@@ -75,6 +75,7 @@ MixingOutput::MixingOutput(const char *param_prefix, uint8_t max_num_outputs, Ou
 	_max_num_outputs(max_num_outputs < MAX_ACTUATORS ? max_num_outputs : MAX_ACTUATORS),
 	_interface(interface),
 	_control_latency_perf(perf_alloc(PC_ELAPSED, "control latency")),
+	_output_latency_perf(perf_alloc(PC_ELAPSED, "output latency")),
 	_param_prefix(param_prefix)
 {
 	/* Safely initialize armed flags */
@@ -101,6 +102,7 @@ MixingOutput::MixingOutput(const char *param_prefix, uint8_t max_num_outputs, Ou
 MixingOutput::~MixingOutput()
 {
 	perf_free(_control_latency_perf);
+	perf_free(_output_latency_perf);
 	px4_sem_destroy(&_lock);
 
 	cleanupFunctions();
@@ -133,6 +135,7 @@ void MixingOutput::printStatus() const
 {
 	PX4_INFO("Param prefix: %s", _param_prefix);
 	perf_print_counter(_control_latency_perf);
+	perf_print_counter(_output_latency_perf);
 
 	if (_wq_switched) {
 		PX4_INFO("Switched to rate_ctrl work queue");
@@ -493,6 +496,12 @@ MixingOutput::limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updat
 	/* now return the outputs to the driver */
 	if (_interface.updateOutputs(stop_motors, _current_output_value, _max_num_outputs, has_updates)) {
 		actuator_outputs_s actuator_outputs{};
+
+		// Just check the first function. It means we only get the sample timestamp if motors are assigned first, which is the default
+		if (_function_allocated[0]) {
+			_function_allocated[0]->getLatestSampleTimestamp(actuator_outputs.timestamp_sample);
+		}
+
 		setAndPublishActuatorOutputs(_max_num_outputs, actuator_outputs);
 
 		updateLatencyPerfCounter(actuator_outputs);
@@ -674,12 +683,16 @@ MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, actuator_output
 void
 MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
 {
+	if (actuator_outputs.timestamp_sample != 0) {
+		perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - actuator_outputs.timestamp_sample);
+	}
+
 	// Just check the first function. It means we only get the latency if motors are assigned first, which is the default
 	if (_function_allocated[0]) {
-		hrt_abstime timestamp_sample;
+		hrt_abstime timestamp;
 
-		if (_function_allocated[0]->getLatestSampleTimestamp(timestamp_sample)) {
-			perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - timestamp_sample);
+		if (_function_allocated[0]->getLatestTimestamp(timestamp)) {
+			perf_set_elapsed(_output_latency_perf, actuator_outputs.timestamp - timestamp);
 		}
 	}
 }
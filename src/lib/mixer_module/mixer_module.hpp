@@ -275,7 +275,8 @@ private:
 
 	OutputModuleInterface &_interface;
 
-	perf_counter_t _control_latency_perf;
+	perf_counter_t _control_latency_perf; ///< gyro sample to output
+	perf_counter_t _output_latency_perf; ///< motor setpoint publication (control allocation) to output
 
 	FunctionProviderBase *_function_allocated[MAX_ACTUATORS] {}; ///< unique allocated functions
 	FunctionProviderBase *_functions[MAX_ACTUATORS] {}; ///< currently assigned functions
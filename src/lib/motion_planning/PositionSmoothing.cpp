@@ -297,9 +297,169 @@ void PositionSmoothing::_generateTrajectory(
 		out_setpoints.position(i) = _trajectory[i].getCurrentPosition();
 	}
 
-	for (int i = 0; i < 3; ++i) {
-		_trajectory[i].updateDurations(velocity_setpoint(i));
+	float vel_sp[3];
+	velocity_setpoint.copyTo(vel_sp);
+	VelocitySmoothing::updateDurationsSynchronized(_trajectory, vel_sp, 3);
+}
+
+namespace
+{
+
+/**
+ * Displacement during a jerk limited velocity transition with jerk j applied during T1,
+ * constant acceleration during T2 and jerk -j during T3
+ */
+float transitionDisplacement(float a0, float v0, float j, float T1, float T2, float T3)
+{
+	const float a1 = a0 + j * T1;
+	const float v1 = v0 + (a0 + 0.5f * j * T1) * T1;
+	const float v2 = v1 + a1 * T2;
+
+	const float x1 = (v0 + (0.5f * a0 + j * T1 / 6.f) * T1) * T1;
+	const float x2 = (v1 + 0.5f * a1 * T2) * T2;
+	const float x3 = (v2 + (0.5f * a1 - j * T3 / 6.f) * T3) * T3;
+
+	return x1 + x2 + x3;
+}
+
+} // namespace
+
+float PositionSmoothing::planWaypoints(const Vector3f *waypoints, int num_waypoints, PlannedLeg *legs) const
+{
+	const int num_legs = math::min(num_waypoints, MAX_PLANNED_LEGS);
+
+	if (num_legs <= 0) {
+		return 0.f;
+	}
+
+	const Vector3f start_position = getCurrentPosition();
+	Vector3f leg_start[MAX_PLANNED_LEGS];
+
+	for (int k = 0; k < num_legs; k++) {
+		leg_start[k] = (k == 0) ? start_position : waypoints[k - 1];
+	}
+
+	math::trajectory::VehicleDynamicLimits config;
+	config.z_accept_rad = _vertical_acceptance_radius;
+	config.xy_accept_rad = _target_acceptance_radius;
+	config.max_acc_xy = _trajectory[0].getMaxAccel();
+	config.max_jerk = _trajectory[0].getMaxJerk();
+	config.max_speed_xy = _cruise_speed;
+	config.max_acc_xy_radius_scale = _horizontal_trajectory_gain;
+
+	// Maximum XY speed at the start and at the end of each leg, propagated backwards from the stop at the last waypoint
+	float xy_speed[MAX_PLANNED_LEGS];
+	float corner_speed[MAX_PLANNED_LEGS];
+	float exit_speed = 0.f;
+
+	for (int k = num_legs - 1; k >= 0; k--) {
+		const Vector3f &next_target = waypoints[math::min(k + 1, num_legs - 1)];
+		corner_speed[k] = math::trajectory::computeXYSpeedAtWaypoint(leg_start[k], waypoints[k], next_target, exit_speed,
+				  config);
+		exit_speed = math::trajectory::computeStartXYSpeedFromWaypoints(leg_start[k], waypoints[k], next_target, exit_speed,
+				config);
+		xy_speed[k] = exit_speed;
+	}
+
+	// Each leg accelerates from its entry velocity to its cruise velocity and then slows down
+	// to the corner speed at its target, the turn itself is assumed to be instantaneous.
+	Vector3f leg_unit[MAX_PLANNED_LEGS];
+	Vector3f cruise_velocity[MAX_PLANNED_LEGS];
+
+	for (int k = 0; k < num_legs; k++) {
+		const float z_speed = math::min(_trajectory[2].getMaxVel(), math::trajectory::computeMaxSpeedFromDistance(
+							_trajectory[2].getMaxJerk(), _trajectory[2].getMaxAccel(),
+							fabsf(waypoints[k](2) - leg_start[k](2)), 0.f));
+
+		leg_unit[k] = (waypoints[k] - leg_start[k]).unit_or_zero();
+		cruise_velocity[k] = leg_unit[k] * sqrtf(xy_speed[k] * xy_speed[k] + z_speed * z_speed);
+		math::trajectory::clampToXYNorm(cruise_velocity[k], xy_speed[k], 0.5f);
+		math::trajectory::clampToZNorm(cruise_velocity[k], z_speed, 0.5f);
+	}
+
+	// Solve the acceleration and braking transitions of all legs in a single batch:
+	// transition 2k accelerates into leg k, transition 2k + 1 brakes at the end of leg k
+	static constexpr int MAX_SOLVES = 3 * 2 * MAX_PLANNED_LEGS;
+	float accel[MAX_SOLVES];
+	float vel[MAX_SOLVES];
+	float vel_sp[MAX_SOLVES];
+	float max_jerk[MAX_SOLVES];
+	float max_accel[MAX_SOLVES];
+	float direction[MAX_SOLVES];
+	float T1[MAX_SOLVES];
+	float T2[MAX_SOLVES];
+	float T3[MAX_SOLVES];
+
+	const int num_transitions = 2 * num_legs;
+
+	for (int k = 0; k < num_legs; k++) {
+		const Vector2f entry_unit = Vector2f(leg_unit[k]).unit_or_zero();
+		const Vector2f exit_unit = entry_unit * corner_speed[k];
+		const Vector3f entry_velocity = (k == 0) ? Vector3f(_trajectory[0].getCurrentVelocity(),
+						_trajectory[1].getCurrentVelocity(), _trajectory[2].getCurrentVelocity())
+						: Vector3f(entry_unit(0) * corner_speed[k - 1], entry_unit(1) * corner_speed[k - 1], 0.f);
+		const Vector3f exit_velocity(exit_unit(0), exit_unit(1), 0.f);
+
+		for (int i = 0; i < 3; i++) {
+			const int accel_index = 3 * (2 * k) + i;
+			const int brake_index = accel_index + 3;
+			const float max_vel = _trajectory[i].getMaxVel();
+
+			accel[accel_index] = (k == 0) ? _trajectory[i].getCurrentAcceleration() : 0.f;
+			vel[accel_index] = entry_velocity(i);
+			vel_sp[accel_index] = math::constrain(cruise_velocity[k](i), -max_vel, max_vel);
+
+			accel[brake_index] = 0.f;
+			vel[brake_index] = vel_sp[accel_index];
+			vel_sp[brake_index] = math::constrain(exit_velocity(i), -max_vel, max_vel);
+
+			max_jerk[accel_index] = max_jerk[brake_index] = _trajectory[i].getMaxJerk();
+			max_accel[accel_index] = max_accel[brake_index] = _trajectory[i].getMaxAccel();
+		}
+	}
+
+	VelocitySmoothing::computeDurations({accel, vel, vel_sp, max_jerk, max_accel, direction, T1, T2, T3},
+					    3 * num_transitions);
+
+	float transition_time[2 * MAX_PLANNED_LEGS];
+	float transition_distance[2 * MAX_PLANNED_LEGS];
+
+	for (int t = 0; t < num_transitions; t++) {
+		// The three axes of a transition are synchronized with each other
+		const int offset = 3 * t;
+		const VelocitySmoothingBatch transition{accel + offset, vel + offset, vel_sp + offset, max_jerk + offset,
+							max_accel + offset, direction + offset, T1 + offset, T2 + offset, T3 + offset};
+		transition_time[t] = VelocitySmoothing::computeMaxTotalTime(transition, 3);
+		VelocitySmoothing::synchronizeDurations(transition, 3, transition_time[t]);
+
+		Vector3f displacement;
+
+		for (int i = 0; i < 3; i++) {
+			const int index = offset + i;
+			displacement(i) = transitionDisplacement(accel[index], vel[index], direction[index] * max_jerk[index],
+					  T1[index], T2[index], T3[index]);
+		}
+
+		transition_distance[t] = displacement.dot(leg_unit[t / 2]);
+	}
+
+	float total_time = 0.f;
+
+	for (int k = 0; k < num_legs; k++) {
+		const float distance_left = (waypoints[k] - leg_start[k]).norm() - transition_distance[2 * k]
+					    - transition_distance[2 * k + 1];
+		const float speed = cruise_velocity[k].norm();
+		const float cruise_time = (speed > FLT_EPSILON) ? math::max(distance_left, 0.f) / speed : 0.f;
+
+		total_time += transition_time[2 * k] + cruise_time + transition_time[2 * k + 1];
+
+		if (legs != nullptr) {
+			legs[k].velocity = cruise_velocity[k];
+			legs[k].transition_time = transition_time[2 * k];
+			legs[k].cruise_time = cruise_time;
+			legs[k].braking_time = transition_time[2 * k + 1];
+		}
 	}
 
-	VelocitySmoothing::timeSynchronization(_trajectory, 3);
+	return total_time;
 }
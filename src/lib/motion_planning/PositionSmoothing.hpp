@@ -66,6 +66,18 @@ public:
 		Vector3f unsmoothed_velocity;
 	};
 
+	/**
+	 * @brief Estimated timing of one leg of a planned waypoint list (see planWaypoints()).
+	 */
+	struct PlannedLeg {
+		Vector3f velocity;	///< cruise velocity along the leg
+		float transition_time;	///< time to reach the cruise velocity from the velocity at the start of the leg
+		float cruise_time;	///< time spent at the cruise velocity
+		float braking_time;	///< time to slow down to the allowed speed at the target of the leg
+	};
+
+	static constexpr int MAX_PLANNED_LEGS = 8;
+
 	/**
 	 * @brief Generates new setpoints for jerk, acceleration, velocity and position
 	 * to reach the given waypoint triplet smoothly from current position
@@ -115,6 +127,21 @@ public:
 				   out_setpoints);
 	}
 
+	/**
+	 * @brief Plan ahead over a list of waypoints starting from the current trajectory state
+	 * and estimate the time needed to fly it, stopping at the last waypoint.
+	 * The velocity transitions of all legs are solved in a single batch. The estimate
+	 * assumes time optimal transitions and instantaneous turns at the corner speed of each
+	 * waypoint, the flight usually takes slightly longer.
+	 *
+	 * @param waypoints remaining waypoints, the first one is the current target
+	 * @param num_waypoints number of waypoints, only the first MAX_PLANNED_LEGS are considered
+	 * @param legs optional output of the timing of each leg, needs to hold num_waypoints entries
+	 * (at most MAX_PLANNED_LEGS)
+	 * @return float total estimated time [s]
+	 */
+	float planWaypoints(const Vector3f *waypoints, int num_waypoints, PlannedLeg *legs = nullptr) const;
+
 
 	/**
 	 * @brief Reset internal state to the given values
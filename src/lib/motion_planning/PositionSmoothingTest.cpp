@@ -189,3 +189,63 @@ TEST_F(PositionSmoothingTest, reachesTargetInitialVelocity)
 	expectVectorEqual(TARGET, position, "position", EPS);
 	EXPECT_LT(iteration, N_ITER) << "Took too long to converge\n";
 }
+
+TEST_F(PositionSmoothingTest, planWaypointsMatchesFlightTime)
+{
+	const float EPS = 1e-2f;
+	const int N_ITER = 2000;
+	const float DELTA_T = 0.02f;
+	const Vector3f WAYPOINTS[] = {{20.f, 0.f, 0.f}, {20.f, 20.f, 5.f}, {40.f, 30.f, 5.f}};
+	static constexpr int NUM_WAYPOINTS = sizeof(WAYPOINTS) / sizeof(WAYPOINTS[0]);
+
+	PositionSmoothing::PlannedLeg legs[NUM_WAYPOINTS];
+	const float planned_time = _position_smoothing.planWaypoints(WAYPOINTS, NUM_WAYPOINTS, legs);
+
+	// The plan ends with a stop at the last waypoint and respects the velocity limits
+	float sum_time = 0.f;
+
+	for (int k = 0; k < NUM_WAYPOINTS; k++) {
+		EXPECT_GT(legs[k].transition_time, 0.f);
+		EXPECT_GE(legs[k].cruise_time, 0.f);
+		EXPECT_GT(legs[k].braking_time, 0.f);
+		EXPECT_LE(legs[k].velocity.xy().norm(), CRUISE_SPEED + EPS);
+		sum_time += legs[k].transition_time + legs[k].cruise_time + legs[k].braking_time;
+	}
+
+	EXPECT_NEAR(sum_time, planned_time, 1e-4f);
+
+	// Fly the waypoints until reaching the acceptance radius of the last one
+	Vector3f position{0.f, 0.f, 0.f};
+	Vector3f previous{0.f, 0.f, 0.f};
+	PositionSmoothing::PositionSmoothingSetpoints out;
+	int current = 0;
+	int iteration = 0;
+
+	for (; iteration < N_ITER; iteration++) {
+		const Vector3f &target = WAYPOINTS[current];
+		const Vector3f &next = WAYPOINTS[(current + 1 < NUM_WAYPOINTS) ? current + 1 : current];
+		Vector3f waypoints[3] = {previous, target, next};
+
+		_position_smoothing.generateSetpoints(position, waypoints, {0.f, 0.f, 0.f}, DELTA_T, false, out);
+		position = out.position;
+		expectDynamicsLimitsRespected(out);
+
+		if ((position - target).xy().norm() < TARGET_ACCEPTANCE_RADIUS
+		    && fabsf(position(2) - target(2)) < VERTICAL_ACCEPTANCE_RADIUS) {
+			if (current == NUM_WAYPOINTS - 1) {
+				break;
+			}
+
+			previous = target;
+			current++;
+		}
+	}
+
+	EXPECT_LT(iteration, N_ITER) << "Took too long to reach the last waypoint\n";
+
+	// The plan assumes time optimal transitions, the flight should take a bit longer
+	const float flight_time = iteration * DELTA_T;
+	printf("Planned %.2f s, flown in %.2f s\n", (double)planned_time, (double)flight_time);
+	EXPECT_LT(planned_time, flight_time);
+	EXPECT_GT(planned_time, 0.7f * flight_time);
+}
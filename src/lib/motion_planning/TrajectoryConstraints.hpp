@@ -67,8 +67,8 @@ struct VehicleDynamicLimits {
  * the real acceptance radius is smaller.
  *
  */
-inline float computeStartXYSpeedFromWaypoints(const Vector3f &start_position, const Vector3f &target,
-		const Vector3f &next_target, float exit_speed, const VehicleDynamicLimits &config)
+inline float computeXYSpeedAtWaypoint(const Vector3f &start_position, const Vector3f &target,
+				      const Vector3f &next_target, float exit_speed, const VehicleDynamicLimits &config)
 {
 	const float distance_target_next = (target - next_target).xy().norm();
 
@@ -92,6 +92,18 @@ inline float computeStartXYSpeedFromWaypoints(const Vector3f &start_position, co
 		speed_at_target = min(max_speed_in_turn, exit_speed, config.max_speed_xy);
 	}
 
+	return speed_at_target;
+}
+
+/*
+ * Compute the maximum allowed speed at the start position such that the vehicle can
+ * slow down to the allowed speed at the target (see computeXYSpeedAtWaypoint())
+ */
+inline float computeStartXYSpeedFromWaypoints(const Vector3f &start_position, const Vector3f &target,
+		const Vector3f &next_target, float exit_speed, const VehicleDynamicLimits &config)
+{
+	const float speed_at_target = computeXYSpeedAtWaypoint(start_position, target, next_target, exit_speed, config);
+
 	float start_to_target = (start_position - target).xy().norm();
 	float max_speed = computeMaxSpeedFromDistance(config.max_jerk, config.max_acc_xy, start_to_target, speed_at_target);
 
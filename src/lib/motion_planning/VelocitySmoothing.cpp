@@ -40,186 +40,300 @@
 
 using matrix::sign;
 
-VelocitySmoothing::VelocitySmoothing(float initial_accel, float initial_vel, float initial_pos)
+namespace
 {
-	reset(initial_accel, initial_vel, initial_pos);
+
+// Branch-free building blocks of the duration solve: conditions are expressed as selects
+// (math::min/max and ternaries on values) so that the loops over trajectories can be vectorized.
+
+/**
+ * Saturate T1 in order to respect the maximum acceleration constraint
+ */
+inline float saturateT1ForAccel(float a0, float j_max, float T1, float a_max)
+{
+	/* Check maximum acceleration, saturate and recompute T1 if needed */
+	const float accel_T1 = a0 + j_max * T1;
+	const float T1_max_accel = (a_max - a0) / j_max;
+	const float T1_min_accel = (-a_max - a0) / j_max;
+
+	return (accel_T1 > a_max) ? T1_max_accel : ((accel_T1 < -a_max) ? T1_min_accel : T1);
 }
 
-void VelocitySmoothing::reset(float accel, float vel, float pos)
+/**
+ * Compute the direction of the jerk to be applied in order to drive the current state
+ * to the desired one
+ */
+inline float computeDirection(float a0, float v0, float vel_sp, float max_jerk)
 {
-	_state.j = 0.f;
-	_state.a = accel;
-	_state.v = vel;
-	_state.x = pos;
+	// Compute the velocity at which the trajectory will be
+	// when the acceleration will be zero
+	const float sign_a0 = sign(a0);
+	const float j_zero_acc = -sign_a0 * max_jerk; // Required jerk to reduce the acceleration
+	const float t_zero_acc = -a0 / j_zero_acc; // Required time to cancel the current acceleration
+	const float vel_zero_acc_braking = v0 + a0 * t_zero_acc + 0.5f * j_zero_acc * t_zero_acc * t_zero_acc;
+	const float vel_zero_acc = (fabsf(a0) > FLT_EPSILON) ? vel_zero_acc_braking : v0;
 
-	_state_init = _state;
+	/* Depending of the direction, start accelerating positively or negatively */
+	const float direction = sign(vel_sp - vel_zero_acc);
+
+	// If by braking immediately the velocity is exactly
+	// the require one with zero acceleration, then brake
+	return (fabsf(direction) < FLT_EPSILON) ? sign_a0 : direction;
 }
 
-float VelocitySmoothing::saturateT1ForAccel(float a0, float j_max, float T1, float a_max) const
+/**
+ * Compute increasing acceleration time
+ */
+inline float computeT1(float a0, float v3, float j_max, float a_max)
 {
-	/* Check maximum acceleration, saturate and recompute T1 if needed */
-	float accel_T1 = a0 + j_max * T1;
-	float T1_new = T1;
+	const float delta = 2.f * a0 * a0 + 4.f * j_max * v3;
 
-	if (accel_T1 > a_max) {
-		T1_new = (a_max - a0) / j_max;
+	const float sqrt_delta = sqrtf(math::max(delta, 0.f));
+	const float T1_plus = (-a0 + 0.5f * sqrt_delta) / j_max;
+	const float T1_minus = (-a0 - 0.5f * sqrt_delta) / j_max;
 
-	} else if (accel_T1 < -a_max) {
-		T1_new = (-a_max - a0) / j_max;
-	}
+	const float T3_plus = a0 / j_max + T1_plus;
+	const float T3_minus = a0 / j_max + T1_minus;
+
+	const bool plus_valid = math::min(T1_plus, T3_plus) >= 0.f;
+	const bool minus_valid = math::min(T1_minus, T3_minus) >= 0.f;
+	const float T1 = plus_valid ? T1_plus : (minus_valid ? T1_minus : 0.f);
 
-	return T1_new;
+	// no real solution if delta < 0
+	return (delta < 0.f) ? 0.f : math::max(saturateT1ForAccel(a0, j_max, T1, a_max), 0.f);
 }
 
-float VelocitySmoothing::computeT1(float a0, float v3, float j_max, float a_max) const
+/**
+ * Compute increasing acceleration time using total time constraint
+ */
+inline float computeT1(float T123, float a0, float v3, float j_max, float a_max)
 {
-	float delta = 2.f * a0 * a0 + 4.f * j_max * v3;
+	const float a = -j_max;
+	const float b = j_max * T123 - a0;
+	const float delta = T123 * T123 * j_max * j_max + 2.f * T123 * a0 * j_max - a0 * a0 - 4.f * j_max * v3;
 
-	if (delta < 0.f) {
-		// Solution is not real
-		return 0.f;
-	}
+	const float sqrt_delta = sqrtf(math::max(delta, 0.f));
+	const float denominator_inv = 1.f / (2.f * a);
+	const float T1_plus = math::max((-b + sqrt_delta) * denominator_inv, 0.f);
+	const float T1_minus = math::max((-b - sqrt_delta) * denominator_inv, 0.f);
 
-	float sqrt_delta = sqrtf(delta);
-	float T1_plus = (-a0 + 0.5f * sqrt_delta) / j_max;
-	float T1_minus = (-a0 - 0.5f * sqrt_delta) / j_max;
+	const float T3_plus = a0 / j_max + T1_plus;
+	const float T3_minus = a0 / j_max + T1_minus;
 
-	float T3_plus = a0 / j_max + T1_plus;
-	float T3_minus = a0 / j_max + T1_minus;
+	// T1 >= 0, T3 >= 0 and T1 + T3 <= T123 combined into a single comparison
+	const bool plus_valid = math::min(T1_plus, T3_plus, T123 - (T1_plus + T3_plus)) >= 0.f;
+	const bool minus_valid = math::min(T1_minus, T3_minus, T123 - (T1_minus + T3_minus)) >= 0.f;
+	const float T1 = plus_valid ? T1_plus : (minus_valid ? T1_minus : 0.f);
 
-	float T1 = 0.f;
+	// no real solution if delta < 0
+	return (delta < 0.f) ? 0.f : saturateT1ForAccel(a0, j_max, T1, a_max);
+}
 
-	if (T1_plus >= 0.f && T3_plus >= 0.f) {
-		T1 = T1_plus;
+/**
+ * Compute constant acceleration time
+ */
+inline float computeT2(float T1, float T3, float a0, float v3, float j_max)
+{
+	const float den = a0 + j_max * T1;
+	const bool den_valid = math::abs_t(den) > FLT_EPSILON;
+	const float T2 = (-0.5f * T1 * T1 * j_max - T1 * T3 * j_max - T1 * a0 + 0.5f * T3 * T3 * j_max - T3 * a0 + v3)
+			 / (den_valid ? den : 1.f);
 
-	} else if (T1_minus >= 0.f && T3_minus >= 0.f) {
-		T1 = T1_minus;
-	}
+	return den_valid ? math::max(T2, 0.f) : 0.f;
+}
 
-	T1 = saturateT1ForAccel(a0, j_max, T1, a_max);
+/**
+ * Compute constant acceleration time using total time constraint
+ */
+inline float computeT2(float T123, float T1, float T3)
+{
+	const float T2 = T123 - T1 - T3;
+	return math::max(T2, 0.f);
+}
 
-	return math::max(T1, 0.f);
+/**
+ * Compute decreasing acceleration time
+ */
+inline float computeT3(float T1, float a0, float j_max)
+{
+	const float T3 = a0 / j_max + T1;
+	return math::max(T3, 0.f);
 }
 
-float VelocitySmoothing::computeT1(float T123, float a0, float v3, float j_max, float a_max) const
+} // namespace
+
+VelocitySmoothing::VelocitySmoothing(float initial_accel, float initial_vel, float initial_pos)
 {
-	float a = -j_max;
-	float b = j_max * T123 - a0;
-	float delta = T123 * T123 * j_max * j_max + 2.f * T123 * a0 * j_max - a0 * a0 - 4.f * j_max * v3;
+	reset(initial_accel, initial_vel, initial_pos);
+}
 
-	if (delta < 0.f) {
-		// Solution is not real
-		return 0.f;
-	}
+void VelocitySmoothing::reset(float accel, float vel, float pos)
+{
+	_state.j = 0.f;
+	_state.a = accel;
+	_state.v = vel;
+	_state.x = pos;
 
-	float sqrt_delta = sqrtf(delta);
-	float denominator_inv = 1.f / (2.f * a);
-	float T1_plus = math::max((-b + sqrt_delta) * denominator_inv, 0.f);
-	float T1_minus = math::max((-b - sqrt_delta) * denominator_inv, 0.f);
+	_state_init = _state;
+}
 
-	float T3_plus = a0 / j_max + T1_plus;
-	float T3_minus = a0 / j_max + T1_minus;
+void VelocitySmoothing::updateDurations(float vel_setpoint)
+{
+	updateDurations(this, &vel_setpoint, 1);
+}
 
-	float T1 = 0.f;
+void VelocitySmoothing::computeDurations(const VelocitySmoothingBatch &batch, int n_traj)
+{
+	for (int offset = 0; offset < n_traj; offset += MAX_BATCH_SIZE) {
+		const int n = math::min(n_traj - offset, MAX_BATCH_SIZE);
 
-	if ((T1_plus >= 0.f && T3_plus >= 0.f) && ((T1_plus + T3_plus) <= T123)) {
-		T1 = T1_plus;
+		// solve into local arrays, which cannot alias the inputs
+		float direction[MAX_BATCH_SIZE];
+		float T1[MAX_BATCH_SIZE];
+		float T2[MAX_BATCH_SIZE];
+		float T3[MAX_BATCH_SIZE];
 
-	} else if ((T1_minus >= 0.f && T3_minus >= 0.f) && ((T1_minus + T3_minus) <= T123)) {
-		T1 = T1_minus;
-	}
+		for (int i = 0; i < n; i++) {
+			const float a0 = batch.accel[offset + i];
+			const float vel_sp = batch.vel_sp[offset + i];
+			const float max_jerk = batch.max_jerk[offset + i];
 
-	T1 = saturateT1ForAccel(a0, j_max, T1, a_max);
+			direction[i] = computeDirection(a0, batch.vel[offset + i], vel_sp, max_jerk);
 
-	return T1;
-}
+			const float jerk_max_T1 = direction[i] * max_jerk;
+			const float delta_v = vel_sp - batch.vel[offset + i];
 
+			// compute increasing acceleration time
+			const float T1_i = computeT1(a0, delta_v, jerk_max_T1, batch.max_accel[offset + i]);
 
-float VelocitySmoothing::computeT2(float T1, float T3, float a0, float v3, float j_max) const
-{
-	float T2 = 0.f;
+			// compute decreasing acceleration time
+			const float T3_i = computeT3(T1_i, a0, jerk_max_T1);
 
-	float den = a0 + j_max * T1;
+			// compute constant acceleration time
+			const float T2_i = computeT2(T1_i, T3_i, a0, delta_v, jerk_max_T1);
 
-	if (math::abs_t(den) > FLT_EPSILON) {
-		T2 = (-0.5f * T1 * T1 * j_max - T1 * T3 * j_max - T1 * a0 + 0.5f * T3 * T3 * j_max - T3 * a0 + v3) / den;
-	}
+			const bool moving = (fabsf(direction[i]) > FLT_EPSILON);
+			T1[i] = moving ? T1_i : 0.f;
+			T2[i] = moving ? T2_i : 0.f;
+			T3[i] = moving ? T3_i : 0.f;
+		}
 
-	return math::max(T2, 0.f);
+		for (int i = 0; i < n; i++) {
+			batch.direction[offset + i] = direction[i];
+			batch.T1[offset + i] = T1[i];
+			batch.T2[offset + i] = T2[i];
+			batch.T3[offset + i] = T3[i];
+		}
+	}
 }
 
-float VelocitySmoothing::computeT2(float T123, float T1, float T3) const
+float VelocitySmoothing::computeMaxTotalTime(const VelocitySmoothingBatch &batch, int n_traj)
 {
-	float T2 = T123 - T1 - T3;
-	return math::max(T2, 0.f);
-}
+	float max_total_time = 0.f;
 
-float VelocitySmoothing::computeT3(float T1, float a0, float j_max) const
-{
-	float T3 = a0 / j_max + T1;
-	return math::max(T3, 0.f);
+	for (int i = 0; i < n_traj; i++) {
+		max_total_time = math::max(max_total_time, batch.T1[i] + batch.T2[i] + batch.T3[i]);
+	}
+
+	return max_total_time;
 }
 
-void VelocitySmoothing::updateDurations(float vel_setpoint)
+void VelocitySmoothing::synchronizeDurations(const VelocitySmoothingBatch &batch, int n_traj, float T123)
 {
-	_vel_sp = math::constrain(vel_setpoint, -_max_vel, _max_vel);
-	_local_time = 0.f;
-	_state_init = _state;
+	if (T123 <= FLT_EPSILON) {
+		return;
+	}
+
+	for (int offset = 0; offset < n_traj; offset += MAX_BATCH_SIZE) {
+		const int n = math::min(n_traj - offset, MAX_BATCH_SIZE);
+
+		// solve into local arrays, which cannot alias the inputs
+		float T1[MAX_BATCH_SIZE];
+		float T2[MAX_BATCH_SIZE];
+		float T3[MAX_BATCH_SIZE];
+
+		for (int i = 0; i < n; i++) {
+			const float a0 = batch.accel[offset + i];
+			const float jerk_max_T1 = batch.direction[offset + i] * batch.max_jerk[offset + i];
+			const float delta_v = batch.vel_sp[offset + i] - batch.vel[offset + i];
+
+			// compute increasing acceleration time
+			const float T1_i = computeT1(T123, a0, delta_v, jerk_max_T1, batch.max_accel[offset + i]);
+
+			// compute decreasing acceleration time
+			const float T3_i = computeT3(T1_i, a0, jerk_max_T1);
 
-	_direction = computeDirection();
+			// compute constant acceleration time
+			const float T2_i = computeT2(T123, T1_i, T3_i);
 
-	if (_direction != 0) {
-		updateDurationsMinimizeTotalTime();
+			// only stretch the shorter trajectories
+			const bool shorter = (batch.T1[offset + i] + batch.T2[offset + i] + batch.T3[offset + i]) < T123;
+			T1[i] = shorter ? T1_i : batch.T1[offset + i];
+			T2[i] = shorter ? T2_i : batch.T2[offset + i];
+			T3[i] = shorter ? T3_i : batch.T3[offset + i];
+		}
 
-	} else {
-		_T1 = _T2 = _T3 = 0.f;
+		for (int i = 0; i < n; i++) {
+			batch.T1[offset + i] = T1[i];
+			batch.T2[offset + i] = T2[i];
+			batch.T3[offset + i] = T3[i];
+		}
 	}
 }
 
-int VelocitySmoothing::computeDirection() const
+void VelocitySmoothing::gatherBatch(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj,
+				    BatchStorage &storage)
 {
-	// Compute the velocity at which the trajectory will be
-	// when the acceleration will be zero
-	float vel_zero_acc = computeVelAtZeroAcc();
+	for (int i = 0; i < n_traj; i++) {
+		VelocitySmoothing &t = traj[i];
 
-	/* Depending of the direction, start accelerating positively or negatively */
-	int direction = sign(_vel_sp - vel_zero_acc);
+		t._vel_sp = math::constrain(vel_setpoints[i], -t._max_vel, t._max_vel);
+		t._local_time = 0.f;
+		t._state_init = t._state;
 
-	if (direction == 0) {
-		// If by braking immediately the velocity is exactly
-		// the require one with zero acceleration, then brake
-		direction = sign(_state.a);
+		storage.accel[i] = t._state.a;
+		storage.vel[i] = t._state.v;
+		storage.vel_sp[i] = t._vel_sp;
+		storage.max_jerk[i] = t._max_jerk;
+		storage.max_accel[i] = t._max_accel;
 	}
-
-	return direction;
 }
 
-float VelocitySmoothing::computeVelAtZeroAcc() const
+void VelocitySmoothing::scatterBatch(VelocitySmoothing *traj, int n_traj, const BatchStorage &storage)
 {
-	float vel_zero_acc = _state.v;
-
-	if (fabsf(_state.a) > FLT_EPSILON) {
-		float j_zero_acc = -sign(_state.a) * _max_jerk; // Required jerk to reduce the acceleration
-		float t_zero_acc = -_state.a / j_zero_acc; // Required time to cancel the current acceleration
-		vel_zero_acc = _state.v + _state.a * t_zero_acc + 0.5f * j_zero_acc * t_zero_acc * t_zero_acc;
+	for (int i = 0; i < n_traj; i++) {
+		traj[i]._direction = (int)storage.direction[i];
+		traj[i]._T1 = storage.T1[i];
+		traj[i]._T2 = storage.T2[i];
+		traj[i]._T3 = storage.T3[i];
 	}
-
-	return vel_zero_acc;
 }
 
-void VelocitySmoothing::updateDurationsMinimizeTotalTime()
+void VelocitySmoothing::updateDurations(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj)
 {
-	float jerk_max_T1 = _direction * _max_jerk;
-	float delta_v = _vel_sp - _state.v;
+	BatchStorage storage;
 
-	// compute increasing acceleration time
-	_T1 = computeT1(_state.a, delta_v, jerk_max_T1, _max_accel);
+	for (int offset = 0; offset < n_traj; offset += MAX_BATCH_SIZE) {
+		const int n = math::min(n_traj - offset, MAX_BATCH_SIZE);
+		gatherBatch(&traj[offset], &vel_setpoints[offset], n, storage);
+		computeDurations(storage.batch, n);
+		scatterBatch(&traj[offset], n, storage);
+	}
+}
 
-	// compute decreasing acceleration time
-	_T3 = computeT3(_T1, _state.a, jerk_max_T1);
+void VelocitySmoothing::updateDurationsSynchronized(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj)
+{
+	if (n_traj > MAX_BATCH_SIZE) {
+		updateDurations(traj, vel_setpoints, n_traj);
+		timeSynchronization(traj, n_traj);
+		return;
+	}
 
-	// compute constant acceleration time
-	_T2 = computeT2(_T1, _T3, _state.a, delta_v, jerk_max_T1);
+	BatchStorage storage;
+	gatherBatch(traj, vel_setpoints, n_traj, storage);
+	computeDurations(storage.batch, n_traj);
+	synchronizeDurations(storage.batch, n_traj, computeMaxTotalTime(storage.batch, n_traj));
+	scatterBatch(traj, n_traj, storage);
 }
 
 Trajectory VelocitySmoothing::evaluatePoly(float j, float a0, float v0, float x0, float t, int d) const
@@ -266,38 +380,30 @@ void VelocitySmoothing::updateTraj(float dt, float time_stretch)
 void VelocitySmoothing::timeSynchronization(VelocitySmoothing *traj, int n_traj)
 {
 	float desired_time = 0.f;
-	int longest_traj_index = 0;
 
 	for (int i = 0; i < n_traj; i++) {
-		const float T123 = traj[i].getTotalTime();
-
-		if (T123 > desired_time) {
-			desired_time = T123;
-			longest_traj_index = i;
-		}
+		desired_time = math::max(desired_time, traj[i].getTotalTime());
 	}
 
-	if (desired_time > FLT_EPSILON) {
-		for (int i = 0; i < n_traj; i++) {
-			if ((i != longest_traj_index)
-			    && (traj[i].getTotalTime() < desired_time)) {
-				traj[i].updateDurationsGivenTotalTime(desired_time);
-			}
+	BatchStorage storage;
+
+	for (int offset = 0; offset < n_traj; offset += MAX_BATCH_SIZE) {
+		const int n = math::min(n_traj - offset, MAX_BATCH_SIZE);
+
+		for (int i = 0; i < n; i++) {
+			const VelocitySmoothing &t = traj[offset + i];
+			storage.accel[i] = t._state.a;
+			storage.vel[i] = t._state.v;
+			storage.vel_sp[i] = t._vel_sp;
+			storage.max_jerk[i] = t._max_jerk;
+			storage.max_accel[i] = t._max_accel;
+			storage.direction[i] = t._direction;
+			storage.T1[i] = t._T1;
+			storage.T2[i] = t._T2;
+			storage.T3[i] = t._T3;
 		}
-	}
-}
 
-void VelocitySmoothing::updateDurationsGivenTotalTime(float T123)
-{
-	float jerk_max_T1 = _direction * _max_jerk;
-	float delta_v = _vel_sp - _state.v;
-
-	// compute increasing acceleration time
-	_T1 = computeT1(T123, _state.a, delta_v, jerk_max_T1, _max_accel);
-
-	// compute decreasing acceleration time
-	_T3 = computeT3(_T1, _state.a, jerk_max_T1);
-
-	// compute constant acceleration time
-	_T2 = computeT2(T123, _T1, _T3);
+		synchronizeDurations(storage.batch, n, desired_time);
+		scatterBatch(&traj[offset], n, storage);
+	}
 }
@@ -40,6 +40,24 @@ struct Trajectory {
 	float x; //< position
 };
 
+/**
+ * Structure of arrays view of several trajectories for the batched duration solve
+ * (see VelocitySmoothing::computeDurations()). All arrays need to hold at least
+ * the number of trajectories passed to the solver.
+ */
+struct VelocitySmoothingBatch {
+	const float *accel;	///< initial acceleration
+	const float *vel;	///< initial velocity
+	const float *vel_sp;	///< velocity setpoint (already constrained to the maximum velocity)
+	const float *max_jerk;
+	const float *max_accel;
+
+	float *direction;	///< direction of the jerk during T1 (-1, 0 or 1)
+	float *T1;
+	float *T2;
+	float *T3;
+};
+
 /**
  * @class VelocitySmoothing
  *
@@ -123,61 +141,49 @@ public:
 	 */
 	static void timeSynchronization(VelocitySmoothing *traj, int n_traj);
 
-private:
-
-	/**
-	 * Compute T1, T2, T3 depending on the current state and velocity setpoint.
-	 * Minimize the total time of the trajectory
-	 */
-	void updateDurationsMinimizeTotalTime();
-
 	/**
-	 * Compute T1, T2, T3 depending on the current state and velocity setpoint.
-	 * @param T123 desired total time of the trajectory
-	 */
-	void updateDurationsGivenTotalTime(float T123);
-
-	/**
-	 * Compute the direction of the jerk to be applied in order to drive the current state
-	 * to the desired one
-	 */
-	int computeDirection() const;
-
-	/**
-	 * Compute the velocity at which the trajectory will be if the maximum jerk is applied
-	 * during the time required to cancel the current acceleration
+	 * Compute T1, T2, T3 of several trajectories at once, equivalent to calling updateDurations()
+	 * on each of them.
+	 * @param traj an array of VelocitySmoothing objects
+	 * @param vel_setpoints velocity setpoint of each trajectory
+	 * @param n_traj the number of trajectories
 	 */
-	float computeVelAtZeroAcc() const;
+	static void updateDurations(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj);
 
 	/**
-	 * Compute increasing acceleration time
+	 * Equivalent to updateDurations() followed by timeSynchronization(), in a single pass.
 	 */
-	inline float computeT1(float a0, float v3, float j_max, float a_max) const;
+	static void updateDurationsSynchronized(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj);
 
 	/**
-	 * Compute increasing acceleration time using total time constraint
+	 * Batched duration solve minimizing the total time of each trajectory.
+	 * The loops do not branch per trajectory, so that the compiler can vectorize them.
+	 * @param batch inputs and outputs in structure of arrays layout
+	 * @param n_traj the number of trajectories
 	 */
-	inline float computeT1(float T123, float a0, float v3, float j_max, float a_max) const;
+	static void computeDurations(const VelocitySmoothingBatch &batch, int n_traj);
 
 	/**
-	 * Saturate T1 in order to respect the maximum acceleration constraint
+	 * @return the longest total time T1 + T2 + T3 of a batch
 	 */
-	inline float saturateT1ForAccel(float a0, float j_max, float T1, float a_max) const;
+	static float computeMaxTotalTime(const VelocitySmoothingBatch &batch, int n_traj);
 
 	/**
-	 * Compute constant acceleration time
+	 * Batched time synchronization: recompute the durations of all trajectories shorter than T123
+	 * to have a total time of T123 (batched version of timeSynchronization()).
+	 * @param batch inputs and outputs in structure of arrays layout, durations computed by computeDurations()
+	 * @param n_traj the number of trajectories
+	 * @param T123 desired total time, usually computeMaxTotalTime()
 	 */
-	inline float computeT2(float T1, float T3, float a0, float v3, float j_max) const;
+	static void synchronizeDurations(const VelocitySmoothingBatch &batch, int n_traj, float T123);
 
 	/**
-	 * Compute constant acceleration time using total time constraint
+	 * Maximum number of trajectories processed at once by the object based batch functions,
+	 * larger arrays are processed in chunks.
 	 */
-	inline float computeT2(float T123, float T1, float T3) const;
+	static constexpr int MAX_BATCH_SIZE = 8;
 
-	/**
-	 * Compute decreasing acceleration time
-	 */
-	inline float computeT3(float T1, float a0, float j_max) const;
+private:
 
 	/**
 	 * Compute the jerk, acceleration, velocity and position
@@ -191,6 +197,30 @@ private:
 	 */
 	inline Trajectory evaluatePoly(float j, float a0, float v0, float x0, float t, int d) const;
 
+	struct BatchStorage {
+		float accel[MAX_BATCH_SIZE];
+		float vel[MAX_BATCH_SIZE];
+		float vel_sp[MAX_BATCH_SIZE];
+		float max_jerk[MAX_BATCH_SIZE];
+		float max_accel[MAX_BATCH_SIZE];
+		float direction[MAX_BATCH_SIZE];
+		float T1[MAX_BATCH_SIZE];
+		float T2[MAX_BATCH_SIZE];
+		float T3[MAX_BATCH_SIZE];
+
+		const VelocitySmoothingBatch batch{accel, vel, vel_sp, max_jerk, max_accel, direction, T1, T2, T3};
+	};
+
+	/**
+	 * Prepare the state of the trajectories for a new duration solve and copy it into the batch storage
+	 */
+	static void gatherBatch(VelocitySmoothing *traj, const float *vel_setpoints, int n_traj, BatchStorage &storage);
+
+	/**
+	 * Copy the durations from the batch storage to the trajectories
+	 */
+	static void scatterBatch(VelocitySmoothing *traj, int n_traj, const BatchStorage &storage);
+
 	/* Input */
 	float _vel_sp{0.0f};
 
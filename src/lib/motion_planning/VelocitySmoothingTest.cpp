@@ -208,3 +208,101 @@ TEST_F(VelocitySmoothingTest, testZeroSetpoint)
 		EXPECT_FLOAT_EQ(_trajectories[i].getCurrentPosition(), 0.f);
 	}
 }
+
+TEST_F(VelocitySmoothingTest, testBatchMatchesSingle)
+{
+	static constexpr int N_MAX = VelocitySmoothing::MAX_BATCH_SIZE + 4;
+
+	// one batch (3 axes and a full batch) and more trajectories than fit a batch (processed per trajectory)
+	for (int n : {3, VelocitySmoothing::MAX_BATCH_SIZE, N_MAX}) {
+		// GIVEN: two identical sets of trajectories with different initial conditions and setpoints
+		VelocitySmoothing single[N_MAX];
+		VelocitySmoothing batch[N_MAX];
+		float velocity_setpoints[N_MAX];
+
+		for (int i = 0; i < n; i++) {
+			const float a0 = 0.9f * sinf(1.3f * i);
+			const float v0 = 3.f * cosf(0.7f * i);
+			velocity_setpoints[i] = 4.f * sinf(2.1f * i + 0.4f);
+
+			for (VelocitySmoothing *traj : {&single[i], &batch[i]}) {
+				traj->setMaxJerk(10.f + i);
+				traj->setMaxAccel(2.f + 0.25f * i);
+				traj->setMaxVel(3.f);
+				traj->reset(a0, v0, 0.f);
+			}
+		}
+
+		// WHEN: the durations are computed one trajectory at a time and in a single batch
+		for (int i = 0; i < n; i++) {
+			single[i].updateDurations(velocity_setpoints[i]);
+		}
+
+		VelocitySmoothing::timeSynchronization(single, n);
+		VelocitySmoothing::updateDurationsSynchronized(batch, velocity_setpoints, n);
+
+		// THEN: both solutions should match
+		for (int i = 0; i < n; i++) {
+			EXPECT_NEAR(single[i].getT1(), batch[i].getT1(), 1e-5f) << "n = " << n << ", i = " << i;
+			EXPECT_NEAR(single[i].getT2(), batch[i].getT2(), 1e-5f) << "n = " << n << ", i = " << i;
+			EXPECT_NEAR(single[i].getT3(), batch[i].getT3(), 1e-5f) << "n = " << n << ", i = " << i;
+			EXPECT_NEAR(single[i].getTotalTime(), batch[i].getTotalTime(), 1e-4f) << "n = " << n << ", i = " << i;
+		}
+	}
+}
+
+TEST_F(VelocitySmoothingTest, testDurationsReference)
+{
+	// durations {T1, T2, T3} computed per axis and synchronized by the solver before it was batched
+	static constexpr float reference[][3] {
+		{0.0409641f, 3.1719289f, 0.0409641f},
+		{-0.0217041f, 3.1366725f, 0.1388889f},
+		{0.2273252f, 2.8765318f, 0.1500000f},
+		{0.2029860f, 2.8771265f, 0.1091997f},
+		{0.2770985f, 2.7455471f, 0.1666667f},
+		{0.0541325f, 3.1058688f, 0.0293109f},
+		{0.0102658f, 2.1073337f, 0.1172526f},
+		{0.0380114f, 2.1269195f, 0.0699213f},
+		{0.1098913f, 1.9374608f, 0.1875000f},
+		{0.0000000f, 1.4127781f, 0.0672339f},
+		{0.0000000f, 1.4449980f, 0.0350139f},
+		{0.2752715f, 1.0073720f, 0.1973684f},
+	};
+
+	for (int set = 0; set < 4; set++) {
+		// GIVEN: three axes with different initial conditions, setpoints and constraints
+		VelocitySmoothing single[3];
+		VelocitySmoothing batch[3];
+		float velocity_setpoints[3];
+
+		for (int axis = 0; axis < 3; axis++) {
+			const int i = 3 * set + axis;
+			velocity_setpoints[axis] = 5.f * sinf(2.1f * i + 0.4f);
+
+			for (VelocitySmoothing *traj : {&single[axis], &batch[axis]}) {
+				traj->setMaxJerk(8.f + i);
+				traj->setMaxAccel(1.f + 0.25f * i);
+				traj->setMaxVel(4.f);
+				traj->reset(1.5f * sinf(1.3f * i), 3.f * cosf(0.7f * i), 0.f);
+			}
+
+			single[axis].updateDurations(velocity_setpoints[axis]);
+		}
+
+		// WHEN: the durations are synchronized per trajectory and in a single batch
+		VelocitySmoothing::timeSynchronization(single, 3);
+		VelocitySmoothing::updateDurationsSynchronized(batch, velocity_setpoints, 3);
+
+		// THEN: both match the reference; the results depend on the floating point flags
+		// (e.g. -freciprocal-math), by up to about 1e-3 s for ill-conditioned inputs
+		for (int axis = 0; axis < 3; axis++) {
+			const float *expected = reference[3 * set + axis];
+
+			for (const VelocitySmoothing *traj : {&single[axis], &batch[axis]}) {
+				EXPECT_NEAR(traj->getT1(), expected[0], 1e-5f) << "set = " << set << ", axis = " << axis;
+				EXPECT_NEAR(traj->getT2(), expected[1], 1e-5f) << "set = " << set << ", axis = " << axis;
+				EXPECT_NEAR(traj->getT3(), expected[2], 1e-5f) << "set = " << set << ", axis = " << axis;
+			}
+		}
+	}
+}
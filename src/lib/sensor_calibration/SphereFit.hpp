@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SphereFit.hpp
+ *
+ * Incremental linear least-squares sphere fit.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+#include <px4_platform_common/defines.h>
+
+namespace calibration
+{
+
+/**
+ * Linear least-squares fit of a sphere, updated sample by sample.
+ *
+ * The algebraic sphere model |m - c|^2 = r^2 is linear in [c, r^2 - |c|^2], so each sample is
+ * accumulated into the 4x4 normal equations in constant time while the data is being collected,
+ * and the fit can be solved at any time without iterating over the samples.
+ * The result is typically used as initial guess for the non-linear sphere/ellipsoid fit (lm_mag_fit()),
+ * or directly if no scale factors are needed.
+ */
+class SphereFit
+{
+public:
+	SphereFit() = default;
+	~SphereFit() = default;
+
+	void reset()
+	{
+		_ATA.zero();
+		_ATb.zero();
+		_count = 0;
+	}
+
+	void addSample(const matrix::Vector3f &sample)
+	{
+		// the samples are relative to the first one to keep the normal equations well conditioned
+		if (_count == 0) {
+			_reference = sample;
+		}
+
+		const matrix::Vector3f p = sample - _reference;
+		const float a[4] {2.f * p(0), 2.f * p(1), 2.f * p(2), 1.f};
+		const float b = p.norm_squared();
+
+		// upper triangle only, the matrix is symmetric
+		for (int i = 0; i < 4; i++) {
+			for (int j = i; j < 4; j++) {
+				_ATA(i, j) += a[i] * a[j];
+			}
+
+			_ATb(i) += a[i] * b;
+		}
+
+		_count++;
+	}
+
+	void addSamples(const float x[], const float y[], const float z[], unsigned count)
+	{
+		for (unsigned k = 0; k < count; k++) {
+			addSample(matrix::Vector3f{x[k], y[k], z[k]});
+		}
+	}
+
+	/**
+	 * Solve the normal equations of the accumulated samples.
+	 *
+	 * @param offset sphere center
+	 * @param radius sphere radius
+	 * @return true on success, false if the samples don't determine a sphere
+	 */
+	bool solve(matrix::Vector3f &offset, float &radius) const
+	{
+		if (_count < 4) {
+			return false;
+		}
+
+		matrix::SquareMatrix<float, 4> ATA;
+
+		for (int i = 0; i < 4; i++) {
+			for (int j = i; j < 4; j++) {
+				ATA(i, j) = _ATA(i, j);
+				ATA(j, i) = _ATA(i, j);
+			}
+		}
+
+		matrix::SquareMatrix<float, 4> ATA_inv;
+
+		if (!ATA.I(ATA_inv)) {
+			return false;
+		}
+
+		const matrix::Vector<float, 4> x = ATA_inv * _ATb;
+		const matrix::Vector3f center{x(0), x(1), x(2)};
+		const float radius_squared = x(3) + center.norm_squared();
+
+		if (!PX4_ISFINITE(radius_squared) || (radius_squared <= 0.f)) {
+			return false;
+		}
+
+		offset = center + _reference;
+		radius = sqrtf(radius_squared);
+		return true;
+	}
+
+	unsigned count() const { return _count; }
+
+private:
+	matrix::SquareMatrix<float, 4> _ATA{};
+	matrix::Vector<float, 4> _ATb{};
+	matrix::Vector3f _reference{};
+	unsigned _count{0};
+};
+
+} // namespace calibration
@@ -314,11 +314,10 @@ void lm_ellipsoid_fit_iteration(const float x[], const float y[], const float z[
 
 
 int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int samples_collected, sphere_params &params,
-	       bool full_ellipsoid)
+	       bool full_ellipsoid, int min_iterations)
 {
 
 	const int max_iterations = 100;
-	const int min_iterations = 10;
 	const float cost_threshold = 0.01;
 	const float step_threshold = 0.001;
 
@@ -354,3 +353,45 @@ int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int s
 	return 1;
 }
 
+
+static float lm_mag_fit_residual(float x, float y, float z, const sphere_params &params)
+{
+	const matrix::Vector3f v{x - params.offset(0), y - params.offset(1), z - params.offset(2)};
+	const float A = (params.diag(0)    * v(0)) + (params.offdiag(0) * v(1)) + (params.offdiag(1) * v(2));
+	const float B = (params.offdiag(0) * v(0)) + (params.diag(1)    * v(1)) + (params.offdiag(2) * v(2));
+	const float C = (params.offdiag(1) * v(0)) + (params.offdiag(2) * v(1)) + (params.diag(2)    * v(2));
+
+	return params.radius - sqrtf(A * A + B * B + C * C);
+}
+
+unsigned int lm_mag_fit_reject_outliers(const float x[], const float y[], const float z[], unsigned int samples_collected,
+					const sphere_params &params, float x_out[], float y_out[], float z_out[],
+					float threshold_sigma, float min_distance_ratio)
+{
+	if (samples_collected == 0) {
+		return 0;
+	}
+
+	float sum_squared = 0.f;
+
+	for (unsigned int k = 0; k < samples_collected; k++) {
+		const float residual = lm_mag_fit_residual(x[k], y[k], z[k], params);
+		sum_squared += residual * residual;
+	}
+
+	const float rms = sqrtf(sum_squared / samples_collected);
+	const float threshold = fmaxf(threshold_sigma * rms, min_distance_ratio * params.radius);
+
+	unsigned int accepted = 0;
+
+	for (unsigned int k = 0; k < samples_collected; k++) {
+		if (fabsf(lm_mag_fit_residual(x[k], y[k], z[k], params)) <= threshold) {
+			x_out[accepted] = x[k];
+			y_out[accepted] = y[k];
+			z_out[accepted] = z[k];
+			accepted++;
+		}
+	}
+
+	return accepted;
+}
@@ -56,10 +56,32 @@ struct sphere_params {
  * @param max_iterations abort if maximum number of iterations have been reached. If unsure, set to 100.
  * @param params the values to be optimized
  * @param full_ellipsoid whether to just optimize a sphere, or do an ellipsoid optimization
+ * @param min_iterations minimum number of iterations before accepting convergence, can be reduced if params
+ *                       already is a good initial guess (e.g. from calibration::SphereFit)
  *
  * NB!! If you optimize the full ellipsoid, you must have already optimized without the full ellipsoid
  *
  * @return 0 on success, 1 on failure
  */
 int lm_mag_fit(const float x[], const float y[], const float z[], unsigned int samples_collected, sphere_params &params,
-	       bool full_ellipsoid);
+	       bool full_ellipsoid, int min_iterations = 10);
+
+/**
+ * Copy the samples that are consistent with a fitted sphere/ellipsoid, rejecting outliers
+ * (e.g. magnetic disturbances) whose distance to the model surface is larger than
+ * max(threshold_sigma * RMS distance, min_distance_ratio * radius).
+ *
+ * The distance is the same residual minimized by lm_mag_fit(), so this is meant to be run on the
+ * final model, followed by a refit of the accepted samples.
+ *
+ * @param x, y, z samples
+ * @param samples_collected number of samples
+ * @param params fitted model
+ * @param x_out, y_out, z_out accepted samples, can't be the same as the input arrays
+ * @param threshold_sigma rejection threshold in standard deviations
+ * @param min_distance_ratio rejection threshold lower bound relative to the radius
+ * @return number of accepted samples
+ */
+unsigned int lm_mag_fit_reject_outliers(const float x[], const float y[], const float z[], unsigned int samples_collected,
+					const sphere_params &params, float x_out[], float y_out[], float z_out[],
+					float threshold_sigma = 3.f, float min_distance_ratio = 0.05f);
@@ -66,7 +66,14 @@ static constexpr unsigned get_lookup_table_index(float *val, float min, float ma
 	return static_cast<unsigned>((-(min) + *val) / SAMPLING_RES);
 }
 
-static constexpr float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+struct table_cell_s {
+	unsigned lat_index;
+	unsigned lon_index;
+	float lat_scale;
+	float lon_scale;
+};
+
+static constexpr table_cell_s get_table_cell(float lat, float lon)
 {
 	lat = math::constrain(lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 
@@ -83,22 +90,41 @@ static constexpr float get_table_data(float lat, float lon, const int16_t table[
 	float min_lon = floorf(lon / SAMPLING_RES) * SAMPLING_RES;
 
 	/* find index of nearest low sampling point */
-	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
-	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+	const unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
+	const unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
 
-	const float data_sw = table[min_lat_index][min_lon_index];
-	const float data_se = table[min_lat_index][min_lon_index + 1];
-	const float data_ne = table[min_lat_index + 1][min_lon_index + 1];
-	const float data_nw = table[min_lat_index + 1][min_lon_index];
-
-	/* perform bilinear interpolation on the four grid corners */
+	/* bilinear interpolation weights within the grid cell */
 	const float lat_scale = constrain((lat - min_lat) / SAMPLING_RES, 0.f, 1.f);
 	const float lon_scale = constrain((lon - min_lon) / SAMPLING_RES, 0.f, 1.f);
 
-	const float data_min = lon_scale * (data_se - data_sw) + data_sw;
-	const float data_max = lon_scale * (data_ne - data_nw) + data_nw;
+	return table_cell_s{min_lat_index, min_lon_index, lat_scale, lon_scale};
+}
+
+static constexpr float interpolate(const table_cell_s &cell, const float corners[4])
+{
+	/* perform bilinear interpolation on the four grid corners (sw, se, ne, nw) */
+	const float data_min = cell.lon_scale * (corners[1] - corners[0]) + corners[0];
+	const float data_max = cell.lon_scale * (corners[2] - corners[3]) + corners[3];
 
-	return lat_scale * (data_max - data_min) + data_min;
+	return cell.lat_scale * (data_max - data_min) + data_min;
+}
+
+static void get_table_corners(const table_cell_s &cell, const int16_t table[LAT_DIM][LON_DIM], float corners[4])
+{
+	corners[0] = table[cell.lat_index][cell.lon_index];
+	corners[1] = table[cell.lat_index][cell.lon_index + 1];
+	corners[2] = table[cell.lat_index + 1][cell.lon_index + 1];
+	corners[3] = table[cell.lat_index + 1][cell.lon_index];
+}
+
+static float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+{
+	const table_cell_s cell = get_table_cell(lat, lon);
+
+	float corners[4];
+	get_table_corners(cell, table, corners);
+
+	return interpolate(cell, corners);
 }
 
 float get_mag_declination_radians(float lat, float lon)
@@ -130,3 +156,39 @@ float get_mag_strength_tesla(float lat, float lon)
 {
 	return get_mag_strength_gauss(lat, lon) * 1e-4f; // 1 Gauss == 0.0001 Tesla
 }
+
+geo_mag_field_s get_mag_field(float lat, float lon)
+{
+	GeoMagCache cache{};
+	return cache.get(lat, lon);
+}
+
+const geo_mag_field_s &GeoMagCache::get(float lat, float lon)
+{
+	if (_valid && (fabsf(lat - _lat) < FLT_EPSILON) && (fabsf(lon - _lon) < FLT_EPSILON)) {
+		return _field;
+	}
+
+	const table_cell_s cell = get_table_cell(lat, lon);
+
+	if (!_valid || (cell.lat_index != _lat_index) || (cell.lon_index != _lon_index)) {
+		// moved to a different grid cell, fetch its corners from all tables at once
+		get_table_corners(cell, declination_table, _declination_corners);
+		get_table_corners(cell, inclination_table, _inclination_corners);
+		get_table_corners(cell, strength_table, _strength_corners);
+
+		_lat_index = cell.lat_index;
+		_lon_index = cell.lon_index;
+		_valid = true;
+	}
+
+	// all tables are stored as 10^-4 radians or milli-Gauss * 10
+	_field.declination_rad = interpolate(cell, _declination_corners) * 1e-4f;
+	_field.inclination_rad = interpolate(cell, _inclination_corners) * 1e-4f;
+	_field.strength_gauss = interpolate(cell, _strength_corners) * 1e-4f;
+
+	_lat = lat;
+	_lon = lon;
+
+	return _field;
+}
@@ -41,6 +41,8 @@
 
 #pragma once
 
+#include <math.h>
+
 // Return magnetic declination in degrees or radians
 float get_mag_declination_degrees(float lat, float lon);
 float get_mag_declination_radians(float lat, float lon);
@@ -52,3 +54,42 @@ float get_mag_inclination_radians(float lat, float lon);
 // return magnetic field strength in Gauss or Tesla
 float get_mag_strength_gauss(float lat, float lon);
 float get_mag_strength_tesla(float lat, float lon);
+
+struct geo_mag_field_s {
+	float declination_rad{NAN};	// magnetic declination (rad)
+	float inclination_rad{NAN};	// magnetic field inclination (rad)
+	float strength_gauss{NAN};	// magnetic field strength (Gauss)
+};
+
+// Return magnetic declination, inclination and strength from a single lookup of the surrounding grid cell
+geo_mag_field_s get_mag_field(float lat, float lon);
+
+/**
+ * Combined magnetic field lookup that keeps the four corners of the last grid cell,
+ * so repeated queries within the same cell only redo the bilinear interpolation
+ * and queries at an unchanged position return the previous result.
+ *
+ * Not thread safe, every user keeps its own instance.
+ */
+class GeoMagCache
+{
+public:
+	const geo_mag_field_s &get(float lat, float lon);
+
+	void reset() { _valid = false; }
+
+private:
+	geo_mag_field_s _field{};
+
+	float _declination_corners[4] {};
+	float _inclination_corners[4] {};
+	float _strength_corners[4] {};
+
+	float _lat{NAN};
+	float _lon{NAN};
+
+	unsigned _lat_index{0};
+	unsigned _lon_index{0};
+
+	bool _valid{false};
+};
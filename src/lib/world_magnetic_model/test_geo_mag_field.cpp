@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include "geo_mag_declination.h"
+
+static void expect_field_eq(const geo_mag_field_s &field, float lat, float lon)
+{
+	EXPECT_FLOAT_EQ(field.declination_rad, get_mag_declination_radians(lat, lon)) << "lat: " << lat << " lon: " << lon;
+	EXPECT_FLOAT_EQ(field.inclination_rad, get_mag_inclination_radians(lat, lon)) << "lat: " << lat << " lon: " << lon;
+	EXPECT_FLOAT_EQ(field.strength_gauss, get_mag_strength_gauss(lat, lon)) << "lat: " << lat << " lon: " << lon;
+}
+
+TEST(GeoMagFieldTest, CombinedLookup)
+{
+	for (float lat = -90.f; lat <= 90.f; lat += 3.7f) {
+		for (float lon = -180.f; lon <= 180.f; lon += 4.3f) {
+			expect_field_eq(get_mag_field(lat, lon), lat, lon);
+		}
+	}
+
+	// table bounds and longitude wrapping
+	expect_field_eq(get_mag_field(90.f, 180.f), 90.f, 180.f);
+	expect_field_eq(get_mag_field(-90.f, -180.f), -90.f, -180.f);
+	expect_field_eq(get_mag_field(47.f, 190.f), 47.f, 190.f);
+	expect_field_eq(get_mag_field(47.f, -190.f), 47.f, -190.f);
+}
+
+TEST(GeoMagFieldTest, CachedLookup)
+{
+	GeoMagCache cache;
+
+	// small steps within and across grid cells, going back and forth
+	for (float lat = 46.f; lat <= 48.f; lat += 0.01f) {
+		const float lon = 8.5f + 0.3f * sinf(lat * 10.f);
+		expect_field_eq(cache.get(lat, lon), lat, lon);
+	}
+
+	for (float lon = 30.f; lon >= -30.f; lon -= 0.7f) {
+		expect_field_eq(cache.get(-33.f, lon), -33.f, lon);
+	}
+
+	// repeated query at the same position
+	const geo_mag_field_s first = cache.get(10.f, 20.f);
+	const geo_mag_field_s &second = cache.get(10.f, 20.f);
+	EXPECT_EQ(first.declination_rad, second.declination_rad);
+	EXPECT_EQ(first.inclination_rad, second.inclination_rad);
+	EXPECT_EQ(first.strength_gauss, second.strength_gauss);
+
+	cache.reset();
+	expect_field_eq(cache.get(-60.f, 100.f), -60.f, 100.f);
+}
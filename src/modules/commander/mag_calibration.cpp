@@ -40,7 +40,6 @@
 #include "mag_calibration.h"
 #include "commander_helper.h"
 #include "calibration_routines.h"
-#include "lm_fit.hpp"
 #include "calibration_messages.h"
 #include "factory_calibration_storage.h"
 
@@ -50,7 +49,9 @@
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_tone_alarm.h>
 #include <matrix/math.hpp>
+#include <lib/sensor_calibration/lm_fit.hpp>
 #include <lib/sensor_calibration/Magnetometer.hpp>
+#include <lib/sensor_calibration/SphereFit.hpp>
 #include <lib/sensor_calibration/Utilities.hpp>
 #include <lib/conversion/rotation.h>
 #include <lib/world_magnetic_model/geo_mag_declination.h>
@@ -72,6 +73,10 @@ using namespace time_literals;
 static constexpr char sensor_name[] {"mag"};
 static constexpr int MAX_MAGS = 4;
 static constexpr float MAG_SPHERE_RADIUS_DEFAULT = 0.2f;
+static constexpr float MAG_SPHERE_RADIUS_MIN = 0.2f;	///< same as the lm_mag_fit() radius limits
+static constexpr float MAG_SPHERE_RADIUS_MAX = 0.7f;
+static constexpr int LM_MIN_ITERATIONS = 10;			///< lm_mag_fit() minimum iterations from the default parameters
+static constexpr int LM_MIN_ITERATIONS_INITIAL_GUESS = 2;	///< lm_mag_fit() minimum iterations from the linear fit
 static constexpr unsigned int calibration_total_points = 240;	///< The total points per magnetometer
 static constexpr unsigned int calibraton_duration_s = 42; 	///< The total duration the routine is allowed to take
 
@@ -94,6 +99,8 @@ struct mag_worker_data_t {
 	float		*y[MAX_MAGS];
 	float		*z[MAX_MAGS];
 
+	calibration::SphereFit *sphere_fit[MAX_MAGS];	///< linear sphere fit updated with every sample
+
 	calibration::Magnetometer calibration[MAX_MAGS] {};
 };
 
@@ -389,6 +396,8 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 						worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](2);
 
 						worker_data->calibration_counter_total[cur_mag]++;
+
+						worker_data->sphere_fit[cur_mag]->addSample(new_samples[cur_mag]);
 					}
 				}
 
@@ -518,6 +527,7 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		worker_data.x[cur_mag] = nullptr;
 		worker_data.y[cur_mag] = nullptr;
 		worker_data.z[cur_mag] = nullptr;
+		worker_data.sphere_fit[cur_mag] = nullptr;
 		worker_data.calibration_counter_total[cur_mag] = 0;
 	}
 
@@ -538,8 +548,10 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 			worker_data.x[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
 			worker_data.y[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
 			worker_data.z[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+			worker_data.sphere_fit[cur_mag] = new calibration::SphereFit();
 
-			if (worker_data.x[cur_mag] == nullptr || worker_data.y[cur_mag] == nullptr || worker_data.z[cur_mag] == nullptr) {
+			if (worker_data.x[cur_mag] == nullptr || worker_data.y[cur_mag] == nullptr || worker_data.z[cur_mag] == nullptr
+			    || worker_data.sphere_fit[cur_mag] == nullptr) {
 				calibration_log_critical(mavlink_log_pub, "ERROR: out of memory");
 				result = calibrate_return_error;
 				break;
@@ -573,6 +585,22 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		offdiag[cur_mag].zero();
 	}
 
+	// samples used for the fit, without outliers
+	float *x_fit = nullptr;
+	float *y_fit = nullptr;
+	float *z_fit = nullptr;
+
+	if (result == calibrate_return_ok) {
+		x_fit = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+		y_fit = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+		z_fit = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+
+		if (x_fit == nullptr || y_fit == nullptr || z_fit == nullptr) {
+			calibration_log_critical(mavlink_log_pub, "ERROR: out of memory");
+			result = calibrate_return_error;
+		}
+	}
+
 	if (result == calibrate_return_ok) {
 		// Sphere fit the data to get calibration values
 		for (uint8_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
@@ -590,10 +618,25 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 				sphere_data.diag = matrix::Vector3f(diag[cur_mag](0), diag[cur_mag](1), diag[cur_mag](2));
 				sphere_data.offdiag = matrix::Vector3f(offdiag[cur_mag](0), offdiag[cur_mag](1), offdiag[cur_mag](2));
 
+				// The linear sphere fit was already accumulated during the data collection, use it as initial guess
+				// for the non-linear fit
+				const unsigned sample_count = worker_data.calibration_counter_total[cur_mag];
+				Vector3f linear_offset;
+				float linear_radius = 0.f;
+				int min_iterations = LM_MIN_ITERATIONS;
+
+				if (worker_data.sphere_fit[cur_mag]->solve(linear_offset, linear_radius)
+				    && (linear_radius > MAG_SPHERE_RADIUS_MIN) && (linear_radius < MAG_SPHERE_RADIUS_MAX)) {
+
+					sphere_data.offset = linear_offset;
+					sphere_data.radius = linear_radius;
+					min_iterations = LM_MIN_ITERATIONS_INITIAL_GUESS;
+				}
+
 				bool sphere_fit_success = false;
 				bool ellipsoid_fit_success = false;
-				int ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-						     worker_data.calibration_counter_total[cur_mag], sphere_data, false);
+				int ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag], sample_count,
+						     sphere_data, false, min_iterations);
 
 				if (ret == PX4_OK) {
 					sphere_fit_success = true;
@@ -601,12 +644,34 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 
 					if (!sphere_fit_only) {
 						int ellipsoid_ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-									       worker_data.calibration_counter_total[cur_mag], sphere_data, true);
+									       sample_count, sphere_data, true, min_iterations);
 
 						if (ellipsoid_ret == PX4_OK) {
 							ellipsoid_fit_success = true;
 						}
 					}
+
+					// Remove the samples that are disturbed (e.g. by a nearby magnet) against the final model and refit,
+					// only if the large majority of samples is consistent
+					const unsigned fit_count = lm_mag_fit_reject_outliers(worker_data.x[cur_mag], worker_data.y[cur_mag],
+								   worker_data.z[cur_mag], sample_count, sphere_data, x_fit, y_fit, z_fit);
+
+					if ((fit_count < sample_count) && (fit_count >= (sample_count * 9) / 10)) {
+						sphere_params inlier_data = sphere_data;
+
+						bool refit_success = (lm_mag_fit(x_fit, y_fit, z_fit, fit_count, inlier_data, false,
+										 LM_MIN_ITERATIONS_INITIAL_GUESS) == PX4_OK);
+
+						if (refit_success && ellipsoid_fit_success) {
+							refit_success = (lm_mag_fit(x_fit, y_fit, z_fit, fit_count, inlier_data, true,
+										    LM_MIN_ITERATIONS_INITIAL_GUESS) == PX4_OK);
+						}
+
+						if (refit_success) {
+							PX4_INFO("Mag: %" PRIu8 " rejected %u outliers", cur_mag, sample_count - fit_count);
+							sphere_data = inlier_data;
+						}
+					}
 				}
 
 				if (!sphere_fit_success && !ellipsoid_fit_success) {
@@ -884,8 +949,13 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		free(worker_data.x[cur_mag]);
 		free(worker_data.y[cur_mag]);
 		free(worker_data.z[cur_mag]);
+		delete worker_data.sphere_fit[cur_mag];
 	}
 
+	free(x_fit);
+	free(y_fit);
+	free(z_fit);
+
 	FactoryCalibrationStorage factory_storage;
 
 	if (result == calibrate_return_ok && factory_storage.open() != PX4_OK) {
@@ -974,12 +1044,10 @@ int do_mag_calibration_quick(orb_advert_t *mavlink_log_pub, float heading_radian
 	} else {
 
 		// magnetic field data returned by the geo library using the current GPS position
-		const float mag_declination_gps = get_mag_declination_radians(latitude, longitude);
-		const float mag_inclination_gps = get_mag_inclination_radians(latitude, longitude);
-		const float mag_strength_gps = get_mag_strength_gauss(latitude, longitude);
+		const geo_mag_field_s mag_field = get_mag_field(latitude, longitude);
 
-		const Vector3f mag_earth_pred = Dcmf(Eulerf(0, -mag_inclination_gps, mag_declination_gps)) * Vector3f(mag_strength_gps,
-						0, 0);
+		const Vector3f mag_earth_pred = Dcmf(Eulerf(0, -mag_field.inclination_rad, mag_field.declination_rad))
+						* Vector3f(mag_field.strength_gauss, 0, 0);
 
 		uORB::Subscription vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
 		vehicle_attitude_s attitude{};
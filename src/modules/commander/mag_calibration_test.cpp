@@ -42,8 +42,9 @@
 #include <matrix/matrix/math.hpp>
 #include <px4_platform_common/defines.h>
 
-#include "lm_fit.hpp"
-#include "mag_calibration_test_data.h"
+#include <lib/sensor_calibration/lm_fit.hpp>
+#include <lib/sensor_calibration/SphereFit.hpp>
+#include <lib/sensor_calibration/mag_calibration_test_data.h>
 
 using matrix::Vector3f;
 
@@ -236,3 +237,84 @@ TEST_F(MagCalTest, replayTestData)
 	EXPECT_NEAR(ellipsoid.diag(1), scale_true(1), 0.01f) << "scale Y: " << ellipsoid.diag(1);
 	EXPECT_NEAR(ellipsoid.diag(2), scale_true(2), 0.01f) << "scale Z: " << ellipsoid.diag(2);
 }
+
+TEST_F(MagCalTest, linearSphereFit)
+{
+	// GIVEN: a dataset of regularly spaced points
+	// on a perfect sphere but not centered on the origin
+	static constexpr unsigned int N_SAMPLES = 240;
+
+	const float mag_str_true = 0.4f;
+	const Vector3f offset_true = {-1.07f, 0.35f, -0.78f};
+	const Vector3f scale_true = {1.f, 1.f, 1.f};
+
+	float x[N_SAMPLES];
+	float y[N_SAMPLES];
+	float z[N_SAMPLES];
+	generateRegularData(x, y, z, N_SAMPLES, mag_str_true);
+	modifyOffsetScale(x, y, z, N_SAMPLES, offset_true, scale_true);
+
+	// WHEN: accumulating the samples one by one into the linear fit
+	calibration::SphereFit sphere_fit;
+	sphere_fit.addSamples(x, y, z, N_SAMPLES);
+
+	Vector3f offset;
+	float radius = 0.f;
+
+	// THEN: the solution is exact without any iteration
+	EXPECT_TRUE(sphere_fit.solve(offset, radius));
+	EXPECT_EQ(sphere_fit.count(), N_SAMPLES);
+	EXPECT_NEAR(radius, mag_str_true, 0.001f) << "radius: " << radius;
+	EXPECT_NEAR(offset(0), offset_true(0), 0.001f) << "offset X: " << offset(0);
+	EXPECT_NEAR(offset(1), offset_true(1), 0.001f) << "offset Y: " << offset(1);
+	EXPECT_NEAR(offset(2), offset_true(2), 0.001f) << "offset Z: " << offset(2);
+}
+
+TEST_F(MagCalTest, replayTestDataOutliers)
+{
+	// GIVEN: the real test dataset with a few disturbed samples
+	constexpr unsigned int N_SAMPLES = 231;
+	constexpr unsigned int N_OUTLIERS = 6;
+
+	const float mag_str_true = 0.4f;
+	const Vector3f offset_true = {-0.18f, 0.05f, -0.58f};
+
+	float x[N_SAMPLES];
+	float y[N_SAMPLES];
+	float z[N_SAMPLES];
+	memcpy(x, mag_data1_x, sizeof(x));
+	memcpy(y, mag_data1_y, sizeof(y));
+	memcpy(z, mag_data1_z, sizeof(z));
+
+	// disturbances increasing the field strength by 50%
+	for (unsigned i = 0; i < N_OUTLIERS; i++) {
+		const unsigned k = i * 37;
+		x[k] = offset_true(0) + 1.5f * (x[k] - offset_true(0));
+		y[k] = offset_true(1) + 1.5f * (y[k] - offset_true(1));
+		z[k] = offset_true(2) + 1.5f * (z[k] - offset_true(2));
+	}
+
+	// WHEN: using the linear fit as initial guess and rejecting the outliers against the fitted model
+	calibration::SphereFit sphere_fit;
+	sphere_fit.addSamples(x, y, z, N_SAMPLES);
+
+	sphere_params sphere;
+	ASSERT_TRUE(sphere_fit.solve(sphere.offset, sphere.radius));
+	ASSERT_EQ(lm_mag_fit(x, y, z, N_SAMPLES, sphere, false, 2), PX4_OK);
+
+	float x_fit[N_SAMPLES];
+	float y_fit[N_SAMPLES];
+	float z_fit[N_SAMPLES];
+	const unsigned fit_count = lm_mag_fit_reject_outliers(x, y, z, N_SAMPLES, sphere, x_fit, y_fit, z_fit);
+
+	// THEN: only the disturbed samples are rejected and the refit finds the correct parameters
+	EXPECT_EQ(fit_count, N_SAMPLES - N_OUTLIERS);
+
+	int sphere_success = lm_mag_fit(x_fit, y_fit, z_fit, fit_count, sphere, false, 2);
+
+	EXPECT_EQ(sphere_success, PX4_OK);
+	EXPECT_NEAR(sphere.radius, mag_str_true, 0.1f) << "radius: " << sphere.radius;
+	EXPECT_NEAR(sphere.offset(0), offset_true(0), 0.01f) << "offset X: " << sphere.offset(0);
+	EXPECT_NEAR(sphere.offset(1), offset_true(1), 0.01f) << "offset Y: " << sphere.offset(1);
+	EXPECT_NEAR(sphere.offset(2), offset_true(2), 0.01f) << "offset Z: " << sphere.offset(2);
+}
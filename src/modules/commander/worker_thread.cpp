@@ -73,7 +73,7 @@ void WorkerThread::startTask(Request request)
 	/* initialize low priority thread */
 	pthread_attr_t low_prio_attr;
 	pthread_attr_init(&low_prio_attr);
-	pthread_attr_setstacksize(&low_prio_attr, PX4_STACK_ADJUSTED(4804));
+	pthread_attr_setstacksize(&low_prio_attr, PX4_STACK_ADJUSTED(4868));
 
 	struct sched_param param;
 	pthread_attr_getschedparam(&low_prio_attr, &param);
@@ -41,6 +41,47 @@
 
 #include "ControlAllocation.hpp"
 
+template<int N>
+static void mixKernel(const matrix::Matrix<float, ControlAllocation::NUM_ACTUATORS, ControlAllocation::NUM_AXES> &mix,
+		      const matrix::Vector<float, ControlAllocation::NUM_AXES> &control,
+		      const ControlAllocation::ActuatorVector &offset, ControlAllocation::ActuatorVector &out)
+{
+	// fixed trip counts, unrolled by the compiler
+	for (int i = 0; i < N; i++) {
+		float sum = offset(i);
+
+		for (int j = 0; j < ControlAllocation::NUM_AXES; j++) {
+			sum += mix(i, j) * control(j);
+		}
+
+		out(i) = sum;
+	}
+
+	for (int i = N; i < ControlAllocation::NUM_ACTUATORS; i++) {
+		out(i) = offset(i);
+	}
+}
+
+template<int N>
+static matrix::Vector<float, ControlAllocation::NUM_AXES> effectivenessKernel(
+	const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &effectiveness,
+	const ControlAllocation::ActuatorVector &actuator)
+{
+	matrix::Vector<float, ControlAllocation::NUM_AXES> control;
+
+	for (int j = 0; j < ControlAllocation::NUM_AXES; j++) {
+		float sum = 0.f;
+
+		for (int i = 0; i < N; i++) {
+			sum += effectiveness(j, i) * actuator(i);
+		}
+
+		control(j) = sum;
+	}
+
+	return control;
+}
+
 ControlAllocation::ControlAllocation()
 {
 	_control_allocation_scale.setAll(1.f);
@@ -60,9 +101,68 @@ ControlAllocation::setEffectivenessMatrix(
 	_actuator_trim = actuator_trim + linearization_point_clipped;
 	clipActuatorSetpoint(_actuator_trim);
 	_num_actuators = num_actuators;
+	_kernel_size = kernelSize(num_actuators);
 	_control_trim = _effectiveness * linearization_point_clipped;
 }
 
+void
+ControlAllocation::mixActuators(const matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> &mix,
+				const matrix::Vector<float, NUM_AXES> &control, const ActuatorVector &offset, ActuatorVector &out) const
+{
+	switch (_kernel_size) {
+	case 4:
+		mixKernel<4>(mix, control, offset, out);
+		break;
+
+	case 6:
+		mixKernel<6>(mix, control, offset, out);
+		break;
+
+	case 8:
+		mixKernel<8>(mix, control, offset, out);
+		break;
+
+	case 12:
+		mixKernel<12>(mix, control, offset, out);
+		break;
+
+	default:
+		mixKernel<NUM_ACTUATORS>(mix, control, offset, out);
+		break;
+	}
+}
+
+matrix::Vector<float, ControlAllocation::NUM_AXES>
+ControlAllocation::getAllocatedControl() const
+{
+	const ActuatorVector actuator = _actuator_sp - _actuator_trim;
+	matrix::Vector<float, NUM_AXES> control;
+
+	switch (_kernel_size) {
+	case 4:
+		control = effectivenessKernel<4>(_effectiveness, actuator);
+		break;
+
+	case 6:
+		control = effectivenessKernel<6>(_effectiveness, actuator);
+		break;
+
+	case 8:
+		control = effectivenessKernel<8>(_effectiveness, actuator);
+		break;
+
+	case 12:
+		control = effectivenessKernel<12>(_effectiveness, actuator);
+		break;
+
+	default:
+		control = effectivenessKernel<NUM_ACTUATORS>(_effectiveness, actuator);
+		break;
+	}
+
+	return control.emult(_control_allocation_scale);
+}
+
 void
 ControlAllocation::setActuatorSetpoint(
 	const matrix::Vector<float, ControlAllocation::NUM_ACTUATORS> &actuator_sp)
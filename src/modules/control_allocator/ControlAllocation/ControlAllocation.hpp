@@ -142,8 +142,7 @@ public:
 	 *
 	 * @return Control vector
 	 */
-	matrix::Vector<float, NUM_AXES> getAllocatedControl() const
-	{ return (_effectiveness * (_actuator_sp - _actuator_trim)).emult(_control_allocation_scale); }
+	matrix::Vector<float, NUM_AXES> getAllocatedControl() const;
 
 	/**
 	 * Get the control effectiveness matrix
@@ -228,9 +227,28 @@ public:
 
 	void setNormalizeRPY(bool normalize_rpy) { _normalize_rpy = normalize_rpy; }
 
+	/**
+	 * Actuator count of the compile-time specialized allocation kernels (4, 6, 8, 12 or 16)
+	 * used for a given number of configured actuators.
+	 */
+	static constexpr int kernelSize(int num_actuators)
+	{
+		return num_actuators <= 4 ? 4 : num_actuators <= 6 ? 6 : num_actuators <= 8 ? 8 : num_actuators <= 12 ? 12 :
+		       NUM_ACTUATORS;
+	}
+
 protected:
 	friend class ControlAllocator; // for _actuator_sp
 
+	/**
+	 * Mix a control vector: out = offset + mix * control
+	 *
+	 * Uses the kernel specialized for the configured number of actuators. The mix rows above
+	 * the configured actuators are expected to be zero, these outputs are set to the offset.
+	 */
+	void mixActuators(const matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> &mix,
+			  const matrix::Vector<float, NUM_AXES> &control, const ActuatorVector &offset, ActuatorVector &out) const;
+
 	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> _effectiveness;  ///< Effectiveness matrix
 	matrix::Vector<float, NUM_AXES> _control_allocation_scale;  	///< Scaling applied during allocation
 	matrix::Vector<float, NUM_ACTUATORS> _actuator_trim; 	///< Neutral actuator values
@@ -242,6 +260,7 @@ protected:
 	matrix::Vector<float, NUM_AXES> _control_sp;   		///< Control setpoint
 	matrix::Vector<float, NUM_AXES> _control_trim; 		///< Control at trim actuator values
 	int _num_actuators{0};
+	int _kernel_size{NUM_ACTUATORS};			///< actuator count of the allocation kernels, @see kernelSize()
 	bool _normalize_rpy{false};				///< if true, normalize roll, pitch and yaw columns
 	bool _had_actuator_failure{false};
 };
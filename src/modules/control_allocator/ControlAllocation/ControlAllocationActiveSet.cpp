@@ -0,0 +1,333 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationActiveSet.cpp
+ *
+ * Box-constrained weighted least squares Control Allocation Algorithm (active-set method)
+ */
+
+#include "ControlAllocationActiveSet.hpp"
+
+#include <mathlib/mathlib.h>
+
+template<int N>
+static void gradientKernel(const matrix::SquareMatrix<float, ControlAllocation::NUM_ACTUATORS> &hessian,
+			   const ControlAllocation::ActuatorVector &x, const ControlAllocation::ActuatorVector &linear,
+			   ControlAllocation::ActuatorVector &gradient)
+{
+	for (int i = 0; i < N; i++) {
+		float sum = -linear(i);
+
+		for (int k = 0; k < N; k++) {
+			sum += hessian(i, k) * x(k);
+		}
+
+		gradient(i) = sum;
+	}
+}
+
+ControlAllocationActiveSet::ControlAllocationActiveSet()
+{
+	// roll/pitch have priority over thrust, yaw is reduced first
+	_axis_weights(ROLL) = 10.f;
+	_axis_weights(PITCH) = 10.f;
+	_axis_weights(YAW) = 1.f;
+	_axis_weights(THRUST_X) = 3.f;
+	_axis_weights(THRUST_Y) = 3.f;
+	_axis_weights(THRUST_Z) = 3.f;
+}
+
+void
+ControlAllocationActiveSet::setEffectivenessMatrix(
+	const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &effectiveness,
+	const ActuatorVector &actuator_trim, const ActuatorVector &linearization_point, int num_actuators,
+	bool update_normalization_scale)
+{
+	ControlAllocationPseudoInverse::setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point,
+			num_actuators, update_normalization_scale);
+	_cost_update_needed = true;
+}
+
+void
+ControlAllocationActiveSet::setAxisWeights(const matrix::Vector<float, ControlAllocation::NUM_AXES> &weights)
+{
+	_axis_weights = weights;
+	_cost_update_needed = true;
+}
+
+void
+ControlAllocationActiveSet::updateCost()
+{
+	// Allocate in the same normalized control space as the pseudo-inverse:
+	// allocated_control = scale .* (B * (actuator_sp - actuator_trim))
+	_control_gain.setZero();
+	_hessian.setZero();
+
+	for (int i = 0; i < _num_actuators; i++) {
+		for (int j = 0; j < NUM_AXES; j++) {
+			const float weight_sq = _axis_weights(j) * _axis_weights(j);
+			_control_gain(i, j) = _control_allocation_scale(j) * _effectiveness(j, i) * weight_sq;
+		}
+	}
+
+	for (int i = 0; i < _num_actuators; i++) {
+		for (int k = i; k < _num_actuators; k++) {
+			float sum = 0.f;
+
+			for (int j = 0; j < NUM_AXES; j++) {
+				sum += _control_gain(i, j) * _control_allocation_scale(j) * _effectiveness(j, k);
+			}
+
+			_hessian(i, k) = sum;
+			_hessian(k, i) = sum;
+		}
+
+		_hessian(i, i) += ACTUATOR_REGULARIZATION;
+	}
+}
+
+void
+ControlAllocationActiveSet::computeGradient(const ActuatorVector &x, const ActuatorVector &control_term,
+		ActuatorVector &gradient) const
+{
+	switch (_kernel_size) {
+	case 4:
+		gradientKernel<4>(_hessian, x, control_term, gradient);
+		break;
+
+	case 6:
+		gradientKernel<6>(_hessian, x, control_term, gradient);
+		break;
+
+	case 8:
+		gradientKernel<8>(_hessian, x, control_term, gradient);
+		break;
+
+	case 12:
+		gradientKernel<12>(_hessian, x, control_term, gradient);
+		break;
+
+	default:
+		gradientKernel<NUM_ACTUATORS>(_hessian, x, control_term, gradient);
+		break;
+	}
+}
+
+bool
+ControlAllocationActiveSet::solveFreeActuators(const ActuatorVector &gradient, ActuatorVector &step)
+{
+	int free_index[NUM_ACTUATORS];
+	int num_free = 0;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_working_set[i] == 0) {
+			free_index[num_free++] = i;
+		}
+	}
+
+	step.setZero();
+
+	// Cholesky factorization of the reduced Hessian (lower triangle)
+	for (int a = 0; a < num_free; a++) {
+		for (int b = 0; b <= a; b++) {
+			float sum = _hessian(free_index[a], free_index[b]);
+
+			for (int k = 0; k < b; k++) {
+				sum -= _factor(a, k) * _factor(b, k);
+			}
+
+			if (a == b) {
+				if (sum < FLT_EPSILON) {
+					return false;
+				}
+
+				_factor(a, a) = sqrtf(sum);
+
+			} else {
+				_factor(a, b) = sum / _factor(b, b);
+			}
+		}
+	}
+
+	// forward and back substitution
+	float y[NUM_ACTUATORS];
+
+	for (int a = 0; a < num_free; a++) {
+		float sum = -gradient(free_index[a]);
+
+		for (int k = 0; k < a; k++) {
+			sum -= _factor(a, k) * y[k];
+		}
+
+		y[a] = sum / _factor(a, a);
+	}
+
+	for (int a = num_free - 1; a >= 0; a--) {
+		float sum = y[a];
+
+		for (int k = a + 1; k < num_free; k++) {
+			sum -= _factor(k, a) * y[k];
+		}
+
+		y[a] = sum / _factor(a, a);
+		step(free_index[a]) = y[a];
+	}
+
+	return true;
+}
+
+void
+ControlAllocationActiveSet::allocate()
+{
+	// Keeps the normalization scale identical to the pseudo-inverse allocation
+	updatePseudoInverse();
+
+	if (_cost_update_needed) {
+		updateCost();
+		_cost_update_needed = false;
+	}
+
+	_prev_actuator_sp = _actuator_sp;
+
+	ActuatorVector control_term;
+	mixActuators(_control_gain, _control_sp - _control_trim, ActuatorVector{}, control_term);
+
+	// Limits relative to trim, warm start from the previous solution and working set
+	ActuatorVector lower;
+	ActuatorVector upper;
+	ActuatorVector x;
+	bool fixed[NUM_ACTUATORS] {};
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_actuator_max(i) < _actuator_min(i)) {
+			// disabled actuator, stays at trim
+			fixed[i] = true;
+			_working_set[i] = -1;
+
+		} else {
+			lower(i) = _actuator_min(i) - _actuator_trim(i);
+			upper(i) = _actuator_max(i) - _actuator_trim(i);
+		}
+
+		if (_working_set[i] < 0) {
+			x(i) = lower(i);
+
+		} else if (_working_set[i] > 0) {
+			x(i) = upper(i);
+
+		} else {
+			x(i) = math::constrain(_actuator_sp(i) - _actuator_trim(i), lower(i), upper(i));
+		}
+	}
+
+	ActuatorVector step;
+	_converged = false;
+	_iterations = 0;
+
+	while (_iterations < _max_iterations) {
+		_iterations++;
+
+		ActuatorVector gradient;
+		computeGradient(x, control_term, gradient);
+
+		if (!solveFreeActuators(gradient, step)) {
+			break;
+		}
+
+		// Longest step along the unconstrained direction that stays within the limits
+		float alpha = 1.f;
+		int blocking = -1;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_working_set[i] == 0) {
+				if (x(i) + step(i) > upper(i)) {
+					const float alpha_i = (upper(i) - x(i)) / step(i);
+
+					if (alpha_i < alpha) {
+						alpha = alpha_i;
+						blocking = i;
+					}
+
+				} else if (x(i) + step(i) < lower(i)) {
+					const float alpha_i = (lower(i) - x(i)) / step(i);
+
+					if (alpha_i < alpha) {
+						alpha = alpha_i;
+						blocking = i;
+					}
+				}
+			}
+		}
+
+		x += step * alpha;
+
+		if (blocking >= 0) {
+			// add the blocking limit to the working set
+			_working_set[blocking] = (step(blocking) > 0.f) ? 1 : -1;
+			x(blocking) = (step(blocking) > 0.f) ? upper(blocking) : lower(blocking);
+			continue;
+		}
+
+		// Optimal on the current working set, release the limit with the most negative Lagrange multiplier
+		computeGradient(x, control_term, gradient);
+
+		float min_multiplier = -1e-4f;
+		int release = -1;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_working_set[i] != 0 && !fixed[i]) {
+				const float multiplier = -_working_set[i] * gradient(i);
+
+				if (multiplier < min_multiplier) {
+					min_multiplier = multiplier;
+					release = i;
+				}
+			}
+		}
+
+		if (release < 0) {
+			_converged = true;
+			break;
+		}
+
+		_working_set[release] = 0;
+	}
+
+	_actuator_sp = _actuator_trim;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		_actuator_sp(i) += x(i);
+	}
+}
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationActiveSet.hpp
+ *
+ * Control Allocation Algorithm solving the box-constrained weighted least squares problem
+ *
+ *   min  sum_j w_j^2 * (control_sp - allocated_control)_j^2 + epsilon * |actuator_sp - actuator_trim|^2
+ *   s.t. actuator_min <= actuator_sp <= actuator_max
+ *
+ * with a primal active-set method. The working set (saturated actuators) and the solution
+ * of the previous cycle are used as warm start, such that usually only few iterations are
+ * required. The number of iterations per cycle is bounded, the returned setpoint is always
+ * within the actuator limits, even if the iteration budget is exhausted before convergence.
+ *
+ * Without saturation the result matches the pseudo-inverse allocation. With saturation,
+ * the axis weights define how the allocation error is distributed between the axes.
+ */
+
+#pragma once
+
+#include "ControlAllocationPseudoInverse.hpp"
+
+class ControlAllocationActiveSet: public ControlAllocationPseudoInverse
+{
+public:
+	ControlAllocationActiveSet();
+	virtual ~ControlAllocationActiveSet() = default;
+
+	static constexpr int DEFAULT_MAX_ITERATIONS = 10;
+
+	void allocate() override;
+	void setEffectivenessMatrix(const matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> &effectiveness,
+				    const ActuatorVector &actuator_trim, const ActuatorVector &linearization_point, int num_actuators,
+				    bool update_normalization_scale) override;
+
+	/**
+	 * Set the weights of the control axes (roll, pitch, yaw, thrust x, y, z).
+	 * A higher weight gives priority to an axis in case of actuator saturation.
+	 *
+	 * @param weights Axis weights, must be positive
+	 */
+	void setAxisWeights(const matrix::Vector<float, NUM_AXES> &weights);
+
+	/**
+	 * Set the maximum number of active-set iterations per allocation cycle
+	 *
+	 * @param max_iterations Iteration budget per call to allocate()
+	 */
+	void setMaxIterations(int max_iterations) { _max_iterations = max_iterations; }
+
+	/**
+	 * @return number of iterations of the last allocation
+	 */
+	int getIterations() const { return _iterations; }
+
+	/**
+	 * @return true if the last allocation reached the optimum within the iteration budget
+	 */
+	bool converged() const { return _converged; }
+
+private:
+	/**
+	 * Recalculate the Hessian and the control gain of the quadratic cost if required
+	 */
+	void updateCost();
+
+	/**
+	 * gradient = H * x - control_term, using the kernel specialized for the number of actuators
+	 */
+	void computeGradient(const ActuatorVector &x, const ActuatorVector &control_term, ActuatorVector &gradient) const;
+
+	/**
+	 * Solve H_ff * step_f = -gradient_f on the free (not saturated) actuators
+	 *
+	 * @return false if the reduced Hessian is not positive definite
+	 */
+	bool solveFreeActuators(const ActuatorVector &gradient, ActuatorVector &step);
+
+	static constexpr float ACTUATOR_REGULARIZATION = 1e-3f; ///< weight of the actuator deviation from trim
+
+	matrix::SquareMatrix<float, NUM_ACTUATORS> _hessian;	///< B^T * W^2 * B + epsilon * I (normalized effectiveness)
+	matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> _control_gain; ///< B^T * W^2 (normalized effectiveness)
+	matrix::SquareMatrix<float, NUM_ACTUATORS> _factor;	///< Cholesky factor of the reduced Hessian (scratch)
+
+	matrix::Vector<float, NUM_AXES> _axis_weights;
+
+	int8_t _working_set[NUM_ACTUATORS] {};	///< -1: at lower limit, 1: at upper limit, 0: free
+
+	int _max_iterations{DEFAULT_MAX_ITERATIONS};
+	int _iterations{0};
+
+	bool _cost_update_needed{true};
+	bool _converged{false};
+};
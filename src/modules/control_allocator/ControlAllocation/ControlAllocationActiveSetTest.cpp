@@ -0,0 +1,282 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationActiveSetTest.cpp
+ *
+ * Tests for the active-set Control Allocation Algorithm
+ */
+
+#include <gtest/gtest.h>
+#include <ControlAllocationActiveSet.hpp>
+#include <ControlAllocationPseudoInverse.hpp>
+
+using namespace matrix;
+
+using ActuatorVector = ControlAllocation::ActuatorVector;
+using EffectivenessMatrix = Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS>;
+
+static EffectivenessMatrix quadEffectiveness()
+{
+	// quad X: front right, rear left, front left, rear right
+	static constexpr float roll[4] {-0.707f, 0.707f, 0.707f, -0.707f};
+	static constexpr float pitch[4] {0.707f, -0.707f, 0.707f, -0.707f};
+	static constexpr float yaw[4] {0.05f, 0.05f, -0.05f, -0.05f};
+
+	EffectivenessMatrix effectiveness;
+
+	for (int i = 0; i < 4; i++) {
+		effectiveness(0, i) = 6.5f * roll[i];
+		effectiveness(1, i) = 6.5f * pitch[i];
+		effectiveness(2, i) = 6.5f * yaw[i];
+		effectiveness(5, i) = -6.5f;
+	}
+
+	return effectiveness;
+}
+
+static float randomFloat(uint32_t &state, float min, float max)
+{
+	state = state * 1664525u + 1013904223u;
+	return min + (max - min) * (float)(state >> 8) / (float)(1u << 24);
+}
+
+// Cost minimized by the active-set allocation, evaluated in the normalized control space
+static float allocationCost(const ControlAllocation &method, const Vector<float, 6> &weights)
+{
+	const Vector<float, 6> control_error = method.getControlSetpoint() - method.getAllocatedControl();
+	const Vector<float, 6> weighted_error = control_error.emult(weights);
+	return weighted_error.norm_squared();
+}
+
+static void configure(ControlAllocation &method, const EffectivenessMatrix &effectiveness, int num_actuators,
+		      const ActuatorVector &actuator_min, const ActuatorVector &actuator_max)
+{
+	method.setNormalizeRPY(true);
+	method.setActuatorMin(actuator_min);
+	method.setActuatorMax(actuator_max);
+	method.setEffectivenessMatrix(effectiveness, ActuatorVector{}, ActuatorVector{}, num_actuators, true);
+}
+
+TEST(ControlAllocationActiveSetTest, UnsaturatedMatchesPseudoInverse)
+{
+	ControlAllocationActiveSet active_set;
+	ControlAllocationPseudoInverse pseudo_inverse;
+
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+
+	configure(active_set, quadEffectiveness(), 4, actuator_min, actuator_max);
+	configure(pseudo_inverse, quadEffectiveness(), 4, actuator_min, actuator_max);
+
+	Vector<float, 6> control_sp;
+	control_sp(0) = 0.05f;
+	control_sp(1) = -0.05f;
+	control_sp(2) = 0.02f;
+	control_sp(5) = -0.5f;
+
+	active_set.setControlSetpoint(control_sp);
+	pseudo_inverse.setControlSetpoint(control_sp);
+	active_set.allocate();
+	pseudo_inverse.allocate();
+
+	EXPECT_TRUE(active_set.converged());
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NEAR(active_set.getActuatorSetpoint()(i), pseudo_inverse.getActuatorSetpoint()(i), 1e-3f) << i;
+	}
+}
+
+TEST(ControlAllocationActiveSetTest, SaturatedQuadPrioritizesRollPitch)
+{
+	ControlAllocationActiveSet active_set;
+	ControlAllocationPseudoInverse pseudo_inverse;
+
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+
+	configure(active_set, quadEffectiveness(), 4, actuator_min, actuator_max);
+	configure(pseudo_inverse, quadEffectiveness(), 4, actuator_min, actuator_max);
+
+	// high thrust with a large roll demand
+	Vector<float, 6> control_sp;
+	control_sp(0) = 0.4f;
+	control_sp(2) = 0.2f;
+	control_sp(5) = -0.9f;
+
+	active_set.setControlSetpoint(control_sp);
+	pseudo_inverse.setControlSetpoint(control_sp);
+	active_set.allocate();
+	pseudo_inverse.allocate();
+	pseudo_inverse.clipActuatorSetpoint();
+
+	EXPECT_TRUE(active_set.converged());
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_GE(active_set.getActuatorSetpoint()(i), 0.f);
+		EXPECT_LE(active_set.getActuatorSetpoint()(i), 1.f);
+	}
+
+	// roll is (nearly) achieved by reducing thrust, clipping loses roll
+	const float roll_error = fabsf(control_sp(0) - active_set.getAllocatedControl()(0));
+	const float roll_error_clipped = fabsf(control_sp(0) - pseudo_inverse.getAllocatedControl()(0));
+	EXPECT_LT(roll_error, 0.5f * roll_error_clipped);
+	EXPECT_GT(active_set.getAllocatedControl()(5), control_sp(5));
+}
+
+TEST(ControlAllocationActiveSetTest, RandomHybridNotWorseThanClipping)
+{
+	// 8 motors and 4 control surfaces with random effectiveness
+	static constexpr int NUM_ACTUATORS = 12;
+	Vector<float, 6> weights;
+	weights(0) = 10.f;
+	weights(1) = 10.f;
+	weights(2) = 1.f;
+	weights(3) = 3.f;
+	weights(4) = 3.f;
+	weights(5) = 3.f;
+
+	uint32_t rand_state = 42;
+
+	for (int test = 0; test < 50; test++) {
+		EffectivenessMatrix effectiveness;
+		ActuatorVector actuator_min;
+		ActuatorVector actuator_max;
+
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			const bool motor = i < 8;
+			actuator_min(i) = motor ? 0.f : -1.f;
+			actuator_max(i) = 1.f;
+
+			for (int j = 0; j < 6; j++) {
+				effectiveness(j, i) = randomFloat(rand_state, -1.f, 1.f);
+			}
+
+			if (motor) {
+				effectiveness(5, i) = randomFloat(rand_state, -6.f, -4.f);
+			}
+		}
+
+		ControlAllocationActiveSet active_set;
+		ControlAllocationPseudoInverse pseudo_inverse;
+		active_set.setMaxIterations(100);
+		configure(active_set, effectiveness, NUM_ACTUATORS, actuator_min, actuator_max);
+		configure(pseudo_inverse, effectiveness, NUM_ACTUATORS, actuator_min, actuator_max);
+
+		Vector<float, 6> control_sp;
+
+		for (int j = 0; j < 6; j++) {
+			control_sp(j) = randomFloat(rand_state, -1.f, 1.f);
+		}
+
+		active_set.setControlSetpoint(control_sp);
+		pseudo_inverse.setControlSetpoint(control_sp);
+		active_set.allocate();
+		pseudo_inverse.allocate();
+		pseudo_inverse.clipActuatorSetpoint();
+
+		EXPECT_TRUE(active_set.converged()) << test;
+
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			EXPECT_GE(active_set.getActuatorSetpoint()(i), actuator_min(i)) << test;
+			EXPECT_LE(active_set.getActuatorSetpoint()(i), actuator_max(i)) << test;
+		}
+
+		EXPECT_LE(allocationCost(active_set, weights), allocationCost(pseudo_inverse, weights) + 1e-3f) << test;
+	}
+}
+
+TEST(ControlAllocationActiveSetTest, WarmStart)
+{
+	ControlAllocationActiveSet active_set;
+
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+	configure(active_set, quadEffectiveness(), 4, actuator_min, actuator_max);
+
+	Vector<float, 6> control_sp;
+	control_sp(0) = 0.6f;
+	control_sp(1) = 0.3f;
+	control_sp(5) = -0.95f;
+	active_set.setControlSetpoint(control_sp);
+
+	active_set.allocate();
+	EXPECT_TRUE(active_set.converged());
+	const ActuatorVector actuator_sp = active_set.getActuatorSetpoint();
+
+	// same setpoint: the previous working set is already optimal
+	active_set.allocate();
+	EXPECT_TRUE(active_set.converged());
+	EXPECT_EQ(active_set.getIterations(), 1);
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NEAR(active_set.getActuatorSetpoint()(i), actuator_sp(i), 1e-5f);
+	}
+}
+
+TEST(ControlAllocationActiveSetTest, IterationBudget)
+{
+	ControlAllocationActiveSet active_set;
+
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+
+	// disabled actuator stays at trim
+	actuator_min(3) = 1.f;
+	actuator_max(3) = 0.f;
+
+	configure(active_set, quadEffectiveness(), 4, actuator_min, actuator_max);
+	active_set.setMaxIterations(1);
+
+	Vector<float, 6> control_sp;
+	control_sp(0) = 1.f;
+	control_sp(1) = -1.f;
+	control_sp(2) = 1.f;
+	control_sp(5) = -1.f;
+	active_set.setControlSetpoint(control_sp);
+	active_set.allocate();
+
+	EXPECT_EQ(active_set.getIterations(), 1);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_GE(active_set.getActuatorSetpoint()(i), 0.f);
+		EXPECT_LE(active_set.getActuatorSetpoint()(i), 1.f);
+	}
+
+	EXPECT_FLOAT_EQ(active_set.getActuatorSetpoint()(3), 0.f);
+}
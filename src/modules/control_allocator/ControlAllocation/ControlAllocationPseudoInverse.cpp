@@ -41,6 +41,8 @@
 
 #include "ControlAllocationPseudoInverse.hpp"
 
+#include <string.h>
+
 void
 ControlAllocationPseudoInverse::setEffectivenessMatrix(
 	const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &effectiveness,
@@ -57,18 +59,83 @@ void
 ControlAllocationPseudoInverse::updatePseudoInverse()
 {
 	if (_mix_update_needed) {
-		matrix::geninv(_effectiveness, _mix);
+		// the mix only needs to be recomputed if the effectiveness or the normalization changed
+		if (updateGramMatrix() || _normalization_needs_update) {
+			matrix::geninvGram(_effectiveness, _gram, _mix);
+
+			if (_normalization_needs_update && !_had_actuator_failure) {
+				updateControlAllocationMatrixScale();
+				_normalization_needs_update = false;
+			}
 
-		if (_normalization_needs_update && !_had_actuator_failure) {
-			updateControlAllocationMatrixScale();
-			_normalization_needs_update = false;
+			normalizeControlAllocationMatrix();
 		}
 
-		normalizeControlAllocationMatrix();
 		_mix_update_needed = false;
 	}
 }
 
+bool
+ControlAllocationPseudoInverse::updateGramMatrix()
+{
+	int changed_columns[NUM_ACTUATORS];
+	int num_changed = 0;
+
+	// bitwise compare: any change, however small, has to reach the Gram matrix to avoid a slow drift
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		for (int j = 0; j < NUM_AXES; j++) {
+			if (memcmp(&_effectiveness(j, i), &_gram_effectiveness(j, i), sizeof(float)) != 0) {
+				changed_columns[num_changed++] = i;
+				break;
+			}
+		}
+	}
+
+	if (_gram_incremental_updates >= 0 && num_changed == 0) {
+		return false;
+	}
+
+	if (_gram_incremental_updates >= 0 && _gram_incremental_updates < MAX_INCREMENTAL_UPDATES
+	    && num_changed <= MAX_INCREMENTAL_COLUMNS) {
+
+		// rank-1 corrections: remove the previous and add the new contribution of each changed column
+		for (int c = 0; c < num_changed; c++) {
+			const int i = changed_columns[c];
+
+			for (int j = 0; j < NUM_AXES; j++) {
+				for (int k = j; k < NUM_AXES; k++) {
+					_gram(j, k) += _effectiveness(j, i) * _effectiveness(k, i)
+						       - _gram_effectiveness(j, i) * _gram_effectiveness(k, i);
+					_gram(k, j) = _gram(j, k);
+				}
+
+				_gram_effectiveness(j, i) = _effectiveness(j, i);
+			}
+		}
+
+		_gram_incremental_updates++;
+
+	} else {
+		for (int j = 0; j < NUM_AXES; j++) {
+			for (int k = j; k < NUM_AXES; k++) {
+				float sum = 0.f;
+
+				for (int i = 0; i < NUM_ACTUATORS; i++) {
+					sum += _effectiveness(j, i) * _effectiveness(k, i);
+				}
+
+				_gram(j, k) = sum;
+				_gram(k, j) = sum;
+			}
+		}
+
+		_gram_effectiveness = _effectiveness;
+		_gram_incremental_updates = 0;
+	}
+
+	return true;
+}
+
 void
 ControlAllocationPseudoInverse::updateControlAllocationMatrixScale()
 {
@@ -177,5 +244,5 @@ ControlAllocationPseudoInverse::allocate()
 	_prev_actuator_sp = _actuator_sp;
 
 	// Allocate
-	_actuator_sp = _actuator_trim + _mix * (_control_sp - _control_trim);
+	mixActuators(_mix, _control_sp - _control_trim, _actuator_trim, _actuator_sp);
 }
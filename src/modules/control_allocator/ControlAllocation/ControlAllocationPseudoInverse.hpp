@@ -70,7 +70,24 @@ protected:
 	void updatePseudoInverse();
 
 private:
+	/**
+	 * Update the Gram matrix B * B^T of the effectiveness matrix.
+	 *
+	 * If only a few columns changed since the last update (e.g. tilting rotors), the Gram matrix
+	 * is updated with rank-1 corrections of these columns instead of being recomputed.
+	 *
+	 * @return true if the effectiveness matrix changed
+	 */
+	bool updateGramMatrix();
+
 	void normalizeControlAllocationMatrix();
 	void updateControlAllocationMatrixScale();
 	bool _normalization_needs_update{false};
+
+	static constexpr int MAX_INCREMENTAL_COLUMNS = NUM_ACTUATORS / 2; ///< above this a full recompute is cheaper
+	static constexpr int MAX_INCREMENTAL_UPDATES = 50; ///< full recompute to bound accumulated rounding errors
+
+	matrix::SquareMatrix<float, NUM_AXES> _gram;	///< B * B^T of _gram_effectiveness
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> _gram_effectiveness; ///< effectiveness matrix of the Gram matrix
+	int _gram_incremental_updates{-1};		///< incremental updates since the last full recompute, -1 if invalid
 };
@@ -67,3 +67,110 @@ TEST(ControlAllocationTest, AllZeroCase)
 	EXPECT_EQ(actuator_sp, actuator_sp_expected);
 	EXPECT_EQ(control_allocated, control_allocated_expected);
 }
+
+TEST(ControlAllocationTest, IncrementalTiltUpdates)
+{
+	// 4 tilting rotors and 4 control surfaces, the rotor columns change at every update
+	ControlAllocationPseudoInverse method;
+	matrix::Matrix<float, 6, 16> effectiveness;
+	matrix::Vector<float, 16> actuator_max;
+	actuator_max.setAll(1.f);
+	method.setActuatorMax(actuator_max);
+
+	for (int i = 0; i < 8; i++) {
+		for (int j = 0; j < 3; j++) {
+			effectiveness(j, i) = sinf(1.3f * i + 0.7f * j);
+		}
+	}
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.1f;
+	control_sp(2) = -0.05f;
+	control_sp(3) = 0.2f;
+	control_sp(5) = -0.6f;
+
+	for (int k = 0; k <= 200; k++) {
+		const float tilt = 0.01f * k;
+
+		for (int i = 0; i < 4; i++) {
+			effectiveness(3, i) = sinf(tilt);
+			effectiveness(5, i) = -cosf(tilt);
+		}
+
+		method.setEffectivenessMatrix(effectiveness, {}, {}, 8, false);
+
+		// repeated update without a change
+		method.setEffectivenessMatrix(effectiveness, {}, {}, 8, false);
+		method.setControlSetpoint(control_sp);
+		method.allocate();
+
+		if (k % 20 == 0) {
+			// compare against a full recompute
+			ControlAllocationPseudoInverse reference;
+			reference.setActuatorMax(actuator_max);
+			reference.setEffectivenessMatrix(effectiveness, {}, {}, 8, false);
+			reference.setControlSetpoint(control_sp);
+			reference.allocate();
+
+			for (int i = 0; i < 8; i++) {
+				EXPECT_NEAR(method.getActuatorSetpoint()(i), reference.getActuatorSetpoint()(i), 1e-4f) << k;
+			}
+		}
+	}
+}
+
+TEST(ControlAllocationTest, ActuatorCountKernels)
+{
+	EXPECT_EQ(ControlAllocation::kernelSize(1), 4);
+	EXPECT_EQ(ControlAllocation::kernelSize(4), 4);
+	EXPECT_EQ(ControlAllocation::kernelSize(5), 6);
+	EXPECT_EQ(ControlAllocation::kernelSize(8), 8);
+	EXPECT_EQ(ControlAllocation::kernelSize(9), 12);
+	EXPECT_EQ(ControlAllocation::kernelSize(13), 16);
+	EXPECT_EQ(ControlAllocation::kernelSize(16), 16);
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.01f;
+	control_sp(1) = -0.02f;
+	control_sp(2) = 0.03f;
+	control_sp(3) = -0.01f;
+	control_sp(4) = 0.02f;
+	control_sp(5) = -0.03f;
+
+	// every actuator count with a full rank effectiveness matrix is allocated exactly
+	for (int num_actuators = 6; num_actuators <= 16; num_actuators++) {
+		ControlAllocationPseudoInverse method;
+		matrix::Matrix<float, 6, 16> effectiveness;
+		matrix::Vector<float, 16> actuator_min;
+		matrix::Vector<float, 16> actuator_max;
+		actuator_min.setAll(-1.f);
+		actuator_max.setAll(1.f);
+
+		uint32_t rand_state = num_actuators;
+
+		for (int i = 0; i < num_actuators; i++) {
+			for (int j = 0; j < 6; j++) {
+				rand_state = rand_state * 1664525u + 1013904223u;
+				effectiveness(j, i) = (float)(rand_state >> 8) / (float)(1u << 23) - 1.f;
+			}
+		}
+
+		method.setActuatorMin(actuator_min);
+		method.setActuatorMax(actuator_max);
+		method.setEffectivenessMatrix(effectiveness, {}, {}, num_actuators, false);
+		method.setControlSetpoint(control_sp);
+		method.allocate();
+
+		const matrix::Vector<float, 6> control_allocated = method.getAllocatedControl();
+		const matrix::Vector<float, 6> control_expected = effectiveness * method.getActuatorSetpoint();
+
+		for (int j = 0; j < 6; j++) {
+			EXPECT_NEAR(control_allocated(j), control_sp(j), 1e-4f) << num_actuators;
+			EXPECT_NEAR(control_allocated(j), control_expected(j), 1e-5f) << num_actuators;
+		}
+
+		for (int i = num_actuators; i < 16; i++) {
+			EXPECT_EQ(method.getActuatorSetpoint()(i), 0.f) << num_actuators;
+		}
+	}
+}
@@ -124,17 +124,11 @@ ControlAllocationSequentialDesaturation::mixAirmodeRP()
 	// Airmode for roll and pitch, but not yaw
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
+	matrix::Vector<float, NUM_AXES> control = _control_sp - _control_trim;
+	control(ControlAxis::YAW) = 0.f;
+	mixActuators(_mix, control, _actuator_trim, _actuator_sp);
 
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-	}
+	const ActuatorVector thrust_z = _mix.col(ControlAxis::THRUST_Z);
 
 	desaturateActuators(_actuator_sp, thrust_z);
 
@@ -148,20 +142,10 @@ ControlAllocationSequentialDesaturation::mixAirmodeRPY()
 	// Airmode for roll, pitch and yaw
 
 	// Do full mixing
-	ActuatorVector thrust_z;
-	ActuatorVector yaw;
+	mixActuators(_mix, _control_sp - _control_trim, _actuator_trim, _actuator_sp);
 
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::YAW) * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		yaw(i) = _mix(i, ControlAxis::YAW);
-	}
+	const ActuatorVector thrust_z = _mix.col(ControlAxis::THRUST_Z);
+	const ActuatorVector yaw = _mix.col(ControlAxis::YAW);
 
 	desaturateActuators(_actuator_sp, thrust_z);
 
@@ -176,21 +160,13 @@ ControlAllocationSequentialDesaturation::mixAirmodeDisabled()
 	// Airmode disabled: never allow to increase the thrust to unsaturate a motor
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
-	ActuatorVector roll;
-	ActuatorVector pitch;
+	matrix::Vector<float, NUM_AXES> control = _control_sp - _control_trim;
+	control(ControlAxis::YAW) = 0.f;
+	mixActuators(_mix, control, _actuator_trim, _actuator_sp);
 
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		roll(i) = _mix(i, ControlAxis::ROLL);
-		pitch(i) = _mix(i, ControlAxis::PITCH);
-	}
+	const ActuatorVector thrust_z = _mix.col(ControlAxis::THRUST_Z);
+	const ActuatorVector roll = _mix.col(ControlAxis::ROLL);
+	const ActuatorVector pitch = _mix.col(ControlAxis::PITCH);
 
 	// only reduce thrust
 	desaturateActuators(_actuator_sp, thrust_z, true);
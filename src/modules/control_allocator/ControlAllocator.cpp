@@ -187,6 +187,10 @@ ControlAllocator::update_allocation_method(bool force)
 				_control_allocation[i] = new ControlAllocationSequentialDesaturation();
 				break;
 
+			case AllocationMethod::ACTIVE_SET:
+				_control_allocation[i] = new ControlAllocationActiveSet();
+				break;
+
 			default:
 				PX4_ERR("Unknown allocation method");
 				break;
@@ -788,6 +792,10 @@ int ControlAllocator::print_status()
 	case AllocationMethod::AUTO:
 		PX4_INFO("Method: Auto");
 		break;
+
+	case AllocationMethod::ACTIVE_SET:
+		PX4_INFO("Method: Active set (constrained weighted least squares)");
+		break;
 	}
 
 	// Print current airframe
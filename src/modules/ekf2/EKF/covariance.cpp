@@ -230,15 +230,15 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 	// These are kinematic states and their error growth is controlled separately by the IMU noise variances
 
 	// delta angle bias states
-	process_noise.slice<3, 1>(10, 0) = sq(d_ang_bias_sig);
+	process_noise.slice<State::delta_ang_bias.dof, 1>(State::delta_ang_bias.idx, 0) = sq(d_ang_bias_sig);
 	// delta_velocity bias states
-	process_noise.slice<3, 1>(13, 0) = sq(d_vel_bias_sig);
+	process_noise.slice<State::delta_vel_bias.dof, 1>(State::delta_vel_bias.idx, 0) = sq(d_vel_bias_sig);
 	// earth frame magnetic field states
-	process_noise.slice<3, 1>(16, 0) = sq(mag_I_sig);
+	process_noise.slice<State::mag_I.dof, 1>(State::mag_I.idx, 0) = sq(mag_I_sig);
 	// body frame magnetic field states
-	process_noise.slice<3, 1>(19, 0) = sq(mag_B_sig);
+	process_noise.slice<State::mag_B.dof, 1>(State::mag_B.idx, 0) = sq(mag_B_sig);
 	// wind velocity states
-	process_noise.slice<2, 1>(22, 0) = sq(wind_vel_nsd_scaled) * dt;
+	process_noise.slice<State::wind_vel.dof, 1>(State::wind_vel.idx, 0) = sq(wind_vel_nsd_scaled) * dt;
 
 	// assign IMU noise variances
 	// inputs to the system are 3 delta angles and 3 delta velocities
@@ -267,8 +267,8 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 
 	// process noise contribution for delta angle states can be very small compared to
 	// the variances, therefore use algorithm to minimise numerical error
-	for (unsigned i = 10; i <= 12; i++) {
-		const int index = i - 10;
+	for (unsigned index = 0; index < State::delta_ang_bias.dof; index++) {
+		const unsigned i = State::delta_ang_bias.idx + index;
 
 		if (!_gyro_bias_inhibit[index]) {
 			// add process noise that is not from the IMU
@@ -282,8 +282,8 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 		}
 	}
 
-	for (int i = 13; i <= 15; i++) {
-		const int index = i - 13;
+	for (unsigned index = 0; index < State::delta_vel_bias.dof; index++) {
+		const unsigned i = State::delta_vel_bias.idx + index;
 
 		if (!_accel_bias_inhibit[index]) {
 			// add process noise that is not from the IMU
@@ -298,7 +298,7 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 	}
 
 	// add process noise that is not from the IMU
-	for (unsigned i = 16; i <= 23; i++) {
+	for (unsigned i = State::mag_I.idx; i < State::size; i++) {
 		nextP(i, i) += process_noise(i);
 	}
 
@@ -314,7 +314,7 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 	}
 
 	// covariance matrix is symmetrical, so copy upper half to lower half
-	for (unsigned row = 0; row <= 15; row++) {
+	for (unsigned row = 0; row < State::mag_I.idx; row++) {
 		for (unsigned column = 0 ; column < row; column++) {
 			P(row, column) = P(column, row) = nextP(column, row);
 		}
@@ -323,7 +323,7 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 	}
 
 	if (_control_status.flags.mag_3D) {
-		for (unsigned row = 16; row <= 21; row++) {
+		for (unsigned row = State::mag_I.idx; row < State::mag_B.idx + State::mag_B.dof; row++) {
 			for (unsigned column = 0 ; column < row; column++) {
 				P(row, column) = P(column, row) = nextP(column, row);
 			}
@@ -333,7 +333,7 @@ void Ekf::predictCovariance(const imuSample &imu_delayed)
 	}
 
 	if (_control_status.flags.wind) {
-		for (unsigned row = 22; row <= 23; row++) {
+		for (unsigned row = State::wind_vel.idx; row < State::wind_vel.idx + State::wind_vel.dof; row++) {
 			for (unsigned column = 0 ; column < row; column++) {
 				P(row, column) = P(column, row) = nextP(column, row);
 			}
@@ -541,12 +541,12 @@ void Ekf::fixCovarianceErrors(bool force_symmetry)
 
 // if the covariance correction will result in a negative variance, then
 // the covariance matrix is unhealthy and must be corrected
-bool Ekf::checkAndFixCovarianceUpdate(const SquareMatrix24f &KHP)
+bool Ekf::checkAndFixCovarianceUpdate(const Vector24f &KHP_diag)
 {
 	bool healthy = true;
 
 	for (int i = 0; i < _k_num_states; i++) {
-		if (P(i, i) < KHP(i, i)) {
+		if (P(i, i) < KHP_diag(i)) {
 			P.uncorrelateCovarianceSetVariance<1>(i, 0.0f);
 			healthy = false;
 		}
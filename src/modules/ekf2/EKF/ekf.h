@@ -50,23 +50,29 @@
 #include "height_bias_estimator.hpp"
 #include "position_bias_estimator.hpp"
 
+#include <lib/world_magnetic_model/geo_mag_declination.h>
+
 #include <uORB/topics/estimator_aid_source1d.h>
 #include <uORB/topics/estimator_aid_source2d.h>
 #include <uORB/topics/estimator_aid_source3d.h>
 
 enum class Likelihood { LOW, MEDIUM, HIGH };
 
+#ifndef FRIEND_TEST // for gtest
+#define FRIEND_TEST(a, b)
+#endif
+
 class Ekf final : public EstimatorInterface
 {
 public:
-	static constexpr uint8_t _k_num_states{24};		///< number of EKF states
+	static constexpr uint8_t _k_num_states{State::size};		///< number of EKF states
 
 	typedef matrix::Vector<float, _k_num_states> Vector24f;
 	typedef matrix::SquareMatrix<float, _k_num_states> SquareMatrix24f;
 	typedef matrix::SquareMatrix<float, 2> Matrix2f;
 	template<int ... Idxs>
 
-	using SparseVector24f = matrix::SparseVectorf<24, Idxs...>;
+	using SparseVector24f = matrix::SparseVectorf<_k_num_states, Idxs...>;
 
 	Ekf()
 	{
@@ -264,7 +270,7 @@ public:
 	void getGravityInnovRatio(float &grav_innov_ratio) const { grav_innov_ratio = Vector3f(_aid_src_gravity.test_ratio).max(); }
 
 	// get the state vector at the delayed time horizon
-	matrix::Vector<float, 24> getStateAtFusionHorizonAsVector() const;
+	matrix::Vector<float, State::size> getStateAtFusionHorizonAsVector() const;
 
 	// get the wind velocity in m/s
 	const Vector2f &getWindVelocity() const { return _state.wind_vel; };
@@ -557,6 +563,9 @@ public:
 
 private:
 
+	FRIEND_TEST(EkfSequentialFusionTest, velPosFusion);
+	FRIEND_TEST(EkfSequentialFusionTest, magFusion);
+
 	// set the internal states and status to their default value
 	void reset();
 
@@ -739,6 +748,8 @@ private:
 	// Variables used to publish the WGS-84 location of the EKF local NED origin
 	float _gps_alt_ref{NAN};		///< WGS-84 height (m)
 
+	GeoMagCache _geo_mag_cache{};		///< world magnetic model lookup of the current grid cell
+
 	// Variables used by the initial filter alignment
 	bool _is_first_imu_sample{true};
 	uint32_t _baro_counter{0};		///< number of baro samples read during initialisation
@@ -859,6 +870,14 @@ private:
 	// fuse single velocity and position measurement
 	bool fuseVelPosHeight(const float innov, const float innov_var, const int obs_index);
 
+	// fuse the axes of a velocity or position observation back to back with a single covariance clean-up
+	// stops at the first unhealthy axis, returns true if all axes were fused
+	bool fuseVelPosHeightSequential(const float *innov, const float *innov_var, const int obs_index_first,
+					const int num_axes);
+
+	// fuse single velocity and position measurement without the covariance clean-up
+	bool fuseVelPosHeightAxis(const float innov, const float innov_var, const int obs_index);
+
 	void resetVelocityTo(const Vector3f &vel, const Vector3f &new_vel_var);
 
 	void resetHorizontalVelocityTo(const Vector2f &new_horz_vel, const Vector2f &new_horz_vel_var);
@@ -994,27 +1013,25 @@ private:
 
 	bool measurementUpdate(Vector24f &K, float innovation_variance, float innovation)
 	{
-		clearInhibitedStateKalmanGains(K);
+		const bool is_healthy = measurementUpdateCovariance(K, innovation_variance);
 
-		const Vector24f KS = K * innovation_variance;
-		SquareMatrix24f KHP;
+		if (is_healthy) {
+			fixCovarianceErrors(true);
 
-		for (unsigned row = 0; row < _k_num_states; row++) {
-			for (unsigned col = 0; col < _k_num_states; col++) {
-				// Instad of literally computing KHP, use an equvalent
-				// equation involving less mathematical operations
-				KHP(row, col) = KS(row) * K(col);
-			}
+			// apply the state corrections
+			fuse(K, innovation);
 		}
 
-		const bool is_healthy = checkAndFixCovarianceUpdate(KHP);
-
-		if (is_healthy) {
-			// apply the covariance corrections
-			P -= KHP;
+		return is_healthy;
+	}
 
-			fixCovarianceErrors(true);
+	// Sequential fusion of one axis of a vector observation. Skips the covariance clean-up: the symmetric
+	// update keeps P symmetric and the caller runs fixCovarianceErrors(true) once after the last fused axis.
+	bool measurementUpdateSequential(Vector24f &K, float innovation_variance, float innovation)
+	{
+		const bool is_healthy = measurementUpdateCovariance(K, innovation_variance);
 
+		if (is_healthy) {
 			// apply the state corrections
 			fuse(K, innovation);
 		}
@@ -1022,9 +1039,32 @@ private:
 		return is_healthy;
 	}
 
+	bool measurementUpdateCovariance(Vector24f &K, float innovation_variance)
+	{
+		clearInhibitedStateKalmanGains(K);
+
+		// Instead of literally computing KHP, use the equivalent KHP = K * S * K^T,
+		// which is symmetric and therefore fully checked by its diagonal
+		Vector24f KHP_diag;
+
+		for (unsigned i = 0; i < _k_num_states; i++) {
+			KHP_diag(i) = K(i) * innovation_variance * K(i);
+		}
+
+		const bool is_healthy = checkAndFixCovarianceUpdate(KHP_diag);
+
+		if (is_healthy) {
+			// apply the covariance corrections, only the upper triangle of the rows
+			// and columns with a non-zero Kalman gain is computed
+			P.symmetricRankOneUpdate(K, -innovation_variance);
+		}
+
+		return is_healthy;
+	}
+
 	// if the covariance correction will result in a negative variance, then
 	// the covariance matrix is unhealthy and must be corrected
-	bool checkAndFixCovarianceUpdate(const SquareMatrix24f &KHP);
+	bool checkAndFixCovarianceUpdate(const Vector24f &KHP_diag);
 
 	// limit the diagonal of the covariance matrix
 	// force symmetry when the argument is true
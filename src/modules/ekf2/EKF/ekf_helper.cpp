@@ -384,17 +384,17 @@ void Ekf::getTerrainFlowInnovVar(float flow_innov_var[2]) const
 #endif // CONFIG_EKF2_OPTICAL_FLOW
 
 // get the state vector at the delayed time horizon
-matrix::Vector<float, 24> Ekf::getStateAtFusionHorizonAsVector() const
+matrix::Vector<float, State::size> Ekf::getStateAtFusionHorizonAsVector() const
 {
-	matrix::Vector<float, 24> state;
-	state.slice<4, 1>(0, 0) = _state.quat_nominal;
-	state.slice<3, 1>(4, 0) = _state.vel;
-	state.slice<3, 1>(7, 0) = _state.pos;
-	state.slice<3, 1>(10, 0) = _state.delta_ang_bias;
-	state.slice<3, 1>(13, 0) = _state.delta_vel_bias;
-	state.slice<3, 1>(16, 0) = _state.mag_I;
-	state.slice<3, 1>(19, 0) = _state.mag_B;
-	state.slice<2, 1>(22, 0) = _state.wind_vel;
+	matrix::Vector<float, State::size> state;
+	state.slice<State::quat_nominal.dof, 1>(State::quat_nominal.idx, 0) = _state.quat_nominal;
+	state.slice<State::vel.dof, 1>(State::vel.idx, 0) = _state.vel;
+	state.slice<State::pos.dof, 1>(State::pos.idx, 0) = _state.pos;
+	state.slice<State::delta_ang_bias.dof, 1>(State::delta_ang_bias.idx, 0) = _state.delta_ang_bias;
+	state.slice<State::delta_vel_bias.dof, 1>(State::delta_vel_bias.idx, 0) = _state.delta_vel_bias;
+	state.slice<State::mag_I.dof, 1>(State::mag_I.idx, 0) = _state.mag_I;
+	state.slice<State::mag_B.dof, 1>(State::mag_B.idx, 0) = _state.mag_B;
+	state.slice<State::wind_vel.dof, 1>(State::wind_vel.idx, 0) = _state.wind_vel;
 	return state;
 }
 
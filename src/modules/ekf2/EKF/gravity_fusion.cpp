@@ -83,10 +83,14 @@ void Ekf::controlGravityFusion(const imuSample &imu)
 	_aid_src_gravity.fusion_enabled = _control_status.flags.gravity_vector;
 
 	if (_aid_src_gravity.fusion_enabled && !_aid_src_gravity.innovation_rejected) {
-		// perform fusion for each axis
-		_aid_src_gravity.fused = measurementUpdate(Kx, innovation_variance(0), innovation(0))
-					 && measurementUpdate(Ky, innovation_variance(1), innovation(1))
-					 && measurementUpdate(Kz, innovation_variance(2), innovation(2));
+		// perform fusion for each axis, covariance clean-up once for all axes
+		const bool fused_x = measurementUpdateSequential(Kx, innovation_variance(0), innovation(0));
+		const bool fused_y = fused_x && measurementUpdateSequential(Ky, innovation_variance(1), innovation(1));
+		_aid_src_gravity.fused = fused_y && measurementUpdateSequential(Kz, innovation_variance(2), innovation(2));
+
+		if (fused_x) {
+			fixCovarianceErrors(true);
+		}
 
 		if (_aid_src_gravity.fused) {
 			_aid_src_gravity.time_last_fuse = imu.time_us;
@@ -160,6 +160,7 @@ bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source3d_s &aid_src_mag, bo
 
 				// we need to re-initialise covariances and abort this fusion step
 				resetMagRelatedCovariances();
+				fixCovarianceErrors(true);
 				ECL_ERR("magY %s", numerical_error_covariance_reset_string);
 				return false;
 			}
@@ -183,6 +184,7 @@ bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source3d_s &aid_src_mag, bo
 
 				// we need to re-initialise covariances and abort this fusion step
 				resetMagRelatedCovariances();
+				fixCovarianceErrors(true);
 				ECL_ERR("magZ %s", numerical_error_covariance_reset_string);
 				return false;
 			}
@@ -200,7 +202,7 @@ bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source3d_s &aid_src_mag, bo
 			}
 		}
 
-		if (measurementUpdate(Kfusion, aid_src_mag.innovation_variance[index], aid_src_mag.innovation[index])) {
+		if (measurementUpdateSequential(Kfusion, aid_src_mag.innovation_variance[index], aid_src_mag.innovation[index])) {
 			fused[index] = true;
 			limitDeclination();
 
@@ -209,6 +211,11 @@ bool Ekf::fuseMag(const Vector3f &mag, estimator_aid_source3d_s &aid_src_mag, bo
 		}
 	}
 
+	// covariance clean-up once for all axes
+	if (fused[0] || fused[1] || fused[2]) {
+		fixCovarianceErrors(true);
+	}
+
 	_fault_status.flags.bad_mag_x = !fused[0];
 	_fault_status.flags.bad_mag_y = !fused[1];
 	_fault_status.flags.bad_mag_z = !fused[2];
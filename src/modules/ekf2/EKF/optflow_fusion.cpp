@@ -157,11 +157,16 @@ void Ekf::fuseOptFlow()
 		SparseVector24f<0,1,2,3,4,5,6> Hfusion(H);
 		Vector24f Kfusion = P * Hfusion / _aid_src_optical_flow.innovation_variance[index];
 
-		if (measurementUpdate(Kfusion, _aid_src_optical_flow.innovation_variance[index], _aid_src_optical_flow.innovation[index])) {
+		if (measurementUpdateSequential(Kfusion, _aid_src_optical_flow.innovation_variance[index], _aid_src_optical_flow.innovation[index])) {
 			fused[index] = true;
 		}
 	}
 
+	// covariance clean-up once for both axes
+	if (fused[0] || fused[1]) {
+		fixCovarianceErrors(true);
+	}
+
 	_fault_status.flags.bad_optflow_X = !fused[0];
 	_fault_status.flags.bad_optflow_Y = !fused[1];
 
@@ -133,9 +133,7 @@ void Ekf::fuseVelocity(estimator_aid_source2d_s &aid_src)
 {
 	if (aid_src.fusion_enabled && !aid_src.innovation_rejected) {
 		// vx, vy
-		if (fuseVelPosHeight(aid_src.innovation[0], aid_src.innovation_variance[0], 0)
-		    && fuseVelPosHeight(aid_src.innovation[1], aid_src.innovation_variance[1], 1)
-		   ) {
+		if (fuseVelPosHeightSequential(aid_src.innovation, aid_src.innovation_variance, 0, 2)) {
 			aid_src.fused = true;
 			aid_src.time_last_fuse = _time_delayed_us;
 
@@ -149,10 +147,7 @@ void Ekf::fuseVelocity(estimator_aid_source3d_s &aid_src)
 {
 	if (aid_src.fusion_enabled && !aid_src.innovation_rejected) {
 		// vx, vy, vz
-		if (fuseVelPosHeight(aid_src.innovation[0], aid_src.innovation_variance[0], 0)
-		    && fuseVelPosHeight(aid_src.innovation[1], aid_src.innovation_variance[1], 1)
-		    && fuseVelPosHeight(aid_src.innovation[2], aid_src.innovation_variance[2], 2)
-		   ) {
+		if (fuseVelPosHeightSequential(aid_src.innovation, aid_src.innovation_variance, 0, 3)) {
 			aid_src.fused = true;
 			aid_src.time_last_fuse = _time_delayed_us;
 
@@ -166,9 +161,7 @@ void Ekf::fuseHorizontalPosition(estimator_aid_source2d_s &aid_src)
 {
 	// x & y
 	if (aid_src.fusion_enabled && !aid_src.innovation_rejected) {
-		if (fuseVelPosHeight(aid_src.innovation[0], aid_src.innovation_variance[0], 3)
-		    && fuseVelPosHeight(aid_src.innovation[1], aid_src.innovation_variance[1], 4)
-		   ) {
+		if (fuseVelPosHeightSequential(aid_src.innovation, aid_src.innovation_variance, 3, 2)) {
 			aid_src.fused = true;
 			aid_src.time_last_fuse = _time_delayed_us;
 
@@ -192,41 +185,51 @@ void Ekf::fuseVerticalPosition(estimator_aid_source1d_s &aid_src)
 // Helper function that fuses a single velocity or position measurement
 bool Ekf::fuseVelPosHeight(const float innov, const float innov_var, const int obs_index)
 {
-	Vector24f Kfusion;  // Kalman gain vector for any single observation - sequential fusion is used.
-	const unsigned state_index = obs_index + 4;  // we start with vx and this is the 4. state
+	const bool healthy = fuseVelPosHeightAxis(innov, innov_var, obs_index);
 
-	// calculate kalman gain K = PHS, where S = 1/innovation variance
-	for (int row = 0; row < _k_num_states; row++) {
-		Kfusion(row) = P(row, state_index) / innov_var;
+	if (healthy) {
+		fixCovarianceErrors(true);
 	}
 
-	clearInhibitedStateKalmanGains(Kfusion);
+	return healthy;
+}
 
-	SquareMatrix24f KHP;
+bool Ekf::fuseVelPosHeightSequential(const float *innov, const float *innov_var, const int obs_index_first,
+				     const int num_axes)
+{
+	int num_fused = 0;
 
-	for (unsigned row = 0; row < _k_num_states; row++) {
-		for (unsigned column = 0; column < _k_num_states; column++) {
-			KHP(row, column) = Kfusion(row) * P(state_index, column);
-		}
+	// stop at the first unhealthy axis
+	while ((num_fused < num_axes)
+	       && fuseVelPosHeightAxis(innov[num_fused], innov_var[num_fused], obs_index_first + num_fused)) {
+		num_fused++;
 	}
 
-	const bool healthy = checkAndFixCovarianceUpdate(KHP);
-
-	setVelPosStatus(obs_index, healthy);
+	// the covariance clean-up is only required once after the last fused axis
+	if (num_fused > 0) {
+		fixCovarianceErrors(true);
+	}
 
-	if (healthy) {
-		// apply the covariance corrections
-		P -= KHP;
+	return num_fused == num_axes;
+}
 
-		fixCovarianceErrors(true);
+bool Ekf::fuseVelPosHeightAxis(const float innov, const float innov_var, const int obs_index)
+{
+	const unsigned state_index = State::vel.idx + obs_index;  // velocity and position states are contiguous
 
-		// apply the state corrections
-		fuse(Kfusion, innov);
+	Vector24f Kfusion;  // Kalman gain vector for any single observation - sequential fusion is used.
 
-		return true;
+	// calculate kalman gain K = PHS, where S = 1/innovation variance
+	for (int row = 0; row < _k_num_states; row++) {
+		Kfusion(row) = P(row, state_index) / innov_var;
 	}
 
-	return false;
+	// H selects a single state, so KHP = K * P(state_index, :) = K * S * K^T
+	const bool healthy = measurementUpdateSequential(Kfusion, innov_var, innov);
+
+	setVelPosStatus(obs_index, healthy);
+
+	return healthy;
 }
 
 void Ekf::setVelPosStatus(const int index, const bool healthy)
@@ -60,9 +60,17 @@ void Ekf::controlZeroVelocityUpdate()
 				P(5, 5) + obs_var,
 				P(6, 6) + obs_var};
 
-			fuseVelPosHeight(innovation(0), innov_var(0), 0);
-			fuseVelPosHeight(innovation(1), innov_var(1), 1);
-			fuseVelPosHeight(innovation(2), innov_var(2), 2);
+			// the axes are fused independently, an unhealthy axis does not prevent the fusion of the others
+			bool fused_any = false;
+
+			for (int i = 0; i < 3; i++) {
+				fused_any |= fuseVelPosHeightAxis(innovation(i), innov_var(i), i);
+			}
+
+			// the covariance clean-up is only required once after the last fused axis
+			if (fused_any) {
+				fixCovarianceErrors(true);
+			}
 
 			_time_last_zero_velocity_fuse = _time_delayed_us;
 		}
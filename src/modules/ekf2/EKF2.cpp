@@ -210,6 +210,7 @@ EKF2::~EKF2()
 {
 	perf_free(_ecl_ekf_update_perf);
 	perf_free(_ecl_ekf_update_full_perf);
+	perf_free(_cycle_perf);
 	perf_free(_msg_missed_imu_perf);
 	perf_free(_msg_missed_air_data_perf);
 #if defined(CONFIG_EKF2_AIRSPEED)
@@ -345,6 +346,7 @@ int EKF2::print_status()
 
 	perf_print_counter(_ecl_ekf_update_perf);
 	perf_print_counter(_ecl_ekf_update_full_perf);
+	perf_print_counter(_cycle_perf);
 	perf_print_counter(_msg_missed_imu_perf);
 	perf_print_counter(_msg_missed_air_data_perf);
 #if defined(CONFIG_EKF2_AIRSPEED)
@@ -756,6 +758,9 @@ void EKF2::Run()
 
 		// publish ekf2_timestamps
 		_ekf2_timestamps_pub.publish(ekf2_timestamps);
+
+		// update and publication cost of this instance
+		perf_set_elapsed(_cycle_perf, hrt_elapsed_time(&ekf_update_start));
 	}
 
 	// re-schedule as backup timeout
@@ -2692,7 +2697,15 @@ int EKF2::task_spawn(int argc, char *argv[])
 					if ((vehicle_mag_sub.advertised() || mag == 0) && (vehicle_imu_sub.advertised())) {
 
 						if (!ekf2_instance_created[imu][mag]) {
-							EKF2 *ekf2_inst = new EKF2(true, px4::ins_instance_to_wq(imu), false);
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+							// dedicated work queue per instance
+							const px4::wq_config_t &wq_config = px4::ekf_instance_to_wq(multi_instances_allocated);
+#else
+							// instances sharing an IMU run sequentially on the same work queue
+							const px4::wq_config_t &wq_config = px4::ins_instance_to_wq(imu);
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
+
+							EKF2 *ekf2_inst = new EKF2(true, wq_config, false);
 
 							if (ekf2_inst && ekf2_inst->multi_init(imu, mag)) {
 								int actual_instance = ekf2_inst->instance(); // match uORB instance numbering
@@ -55,6 +55,12 @@ EKF2Selector::EKF2Selector() :
 EKF2Selector::~EKF2Selector()
 {
 	Stop();
+
+	perf_free(_latency_perf);
+	perf_free(_instance_skew_perf);
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+	perf_free(_sync_missed_perf);
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
 }
 
 void EKF2Selector::Stop()
@@ -120,7 +126,16 @@ bool EKF2Selector::SelectInstance(uint8_t ekf_instance)
 		if (_selected_instance != INVALID_INSTANCE) {
 			// switch callback registration
 			_instance[_selected_instance].estimator_attitude_sub.unregisterCallback();
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+
+			// in parallel mode the previous primary keeps running the selector unless it timed out
+			if (_instance[_selected_instance].timeout) {
+				_instance[_selected_instance].estimator_status_sub.unregisterCallback();
+			}
+
+#else
 			_instance[_selected_instance].estimator_status_sub.unregisterCallback();
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
 
 			PrintInstanceChange(_selected_instance, ekf_instance);
 		}
@@ -263,6 +278,17 @@ bool EKF2Selector::UpdateErrorScores()
 		if (_instance[i].estimator_status_sub.update(&status)) {
 
 			_instance[i].timestamp_last = status.timestamp;
+			_instance[i].timestamp_sample_last = status.timestamp_sample;
+
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+
+			// run on the status of every instance to compare them at the same sample time,
+			// registered once the instance appears or recovers from a timeout
+			if ((i >= _available_instances) || _instance[i].timeout) {
+				_instance[i].estimator_status_sub.registerCallback();
+			}
+
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
 
 			_instance[i].accel_device_id = status.accel_device_id;
 			_instance[i].gyro_device_id = status.gyro_device_id;
@@ -313,6 +339,15 @@ bool EKF2Selector::UpdateErrorScores()
 		} else if (!_instance[i].timeout && (hrt_elapsed_time(&_instance[i].timestamp_last) > status_timeout)) {
 			_instance[i].healthy.set_state_and_update(false, hrt_absolute_time());
 			_instance[i].timeout = true;
+
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+
+			// a timed out instance is no longer waited for, the primary keeps its callback until deselected
+			if (i != _selected_instance) {
+				_instance[i].estimator_status_sub.unregisterCallback();
+			}
+
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
 		}
 
 		// if the gyro used by the EKF is faulty, declare the EKF unhealthy without delay
@@ -336,7 +371,46 @@ bool EKF2Selector::UpdateErrorScores()
 	}
 
 	// update relative test ratios if primary has updated
+	bool compare = primary_updated;
+
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+
+	// instances running in parallel finish at different times, the error scores are only compared
+	// once all active instances reached the sample time of the primary
 	if (primary_updated) {
+		if (_compare_timestamp_sample != 0) {
+			// the previous sample time of the primary was never reached by all instances
+			perf_count(_sync_missed_perf);
+		}
+
+		_compare_timestamp_sample = _instance[_selected_instance].timestamp_sample_last;
+	}
+
+	compare = (_compare_timestamp_sample != 0) && InstancesSynchronized(_compare_timestamp_sample);
+
+	if (compare) {
+		_compare_timestamp_sample = 0;
+	}
+
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
+
+	if (compare) {
+		// spread of the sample times of all instances currently reporting, the error scores are
+		// compared across this window
+		uint64_t timestamp_sample_min = UINT64_MAX;
+		uint64_t timestamp_sample_max = 0;
+
+		for (uint8_t i = 0; i < _available_instances; i++) {
+			if (!_instance[i].timeout && (_instance[i].timestamp_sample_last != 0)) {
+				timestamp_sample_min = math::min(timestamp_sample_min, _instance[i].timestamp_sample_last);
+				timestamp_sample_max = math::max(timestamp_sample_max, _instance[i].timestamp_sample_last);
+			}
+		}
+
+		if (timestamp_sample_max >= timestamp_sample_min) {
+			perf_set_elapsed(_instance_skew_perf, timestamp_sample_max - timestamp_sample_min);
+		}
+
 		for (uint8_t i = 0; i < _available_instances; i++) {
 			if (i != _selected_instance) {
 
@@ -358,9 +432,24 @@ bool EKF2Selector::UpdateErrorScores()
 		}
 	}
 
-	return (primary_updated || updated);
+	return (primary_updated || updated || compare);
 }
 
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+bool EKF2Selector::InstancesSynchronized(uint64_t timestamp_sample) const
+{
+	for (uint8_t i = 0; i < _available_instances; i++) {
+		// instances are compared within half a filter update, a timed out instance is not waited for
+		if ((i != _selected_instance) && !_instance[i].timeout
+		    && (_instance[i].timestamp_sample_last + FILTER_UPDATE_PERIOD / 2 < timestamp_sample)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
+
 void EKF2Selector::PublishVehicleAttitude()
 {
 	// selected estimator_attitude -> vehicle_attitude
@@ -411,6 +500,9 @@ void EKF2Selector::PublishVehicleAttitude()
 
 			attitude.timestamp = hrt_absolute_time();
 			_vehicle_attitude_pub.publish(attitude);
+
+			// IMU sample to vehicle_attitude latency including the selector
+			perf_set_elapsed(_latency_perf, attitude.timestamp - attitude.timestamp_sample);
 		}
 	}
 }
@@ -854,4 +946,10 @@ void EKF2Selector::PrintStatus()
 			 (double)inst.combined_test_ratio, (double)inst.relative_test_ratio,
 			 (_selected_instance == i) ? "*" : "");
 	}
+
+	perf_print_counter(_latency_perf);
+	perf_print_counter(_instance_skew_perf);
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+	perf_print_counter(_sync_missed_perf);
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
 }
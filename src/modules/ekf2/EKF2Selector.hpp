@@ -41,6 +41,7 @@
 #include <px4_platform_common/time.h>
 #include <lib/hysteresis/hysteresis.h>
 #include <lib/mathlib/mathlib.h>
+#include <lib/perf/perf_counter.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
@@ -96,6 +97,11 @@ private:
 	// Update the error scores for all available instances
 	bool UpdateErrorScores();
 
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+	// true once all active instances reached the given sample time
+	bool InstancesSynchronized(uint64_t timestamp_sample) const;
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
+
 	// Subscriptions (per estimator instance)
 	struct EstimatorInstance {
 
@@ -120,6 +126,7 @@ private:
 		uORB::Subscription estimator_wind_sub;
 
 		uint64_t timestamp_last{0};
+		uint64_t timestamp_sample_last{0};
 
 		uint32_t accel_device_id{0};
 		uint32_t gyro_device_id{0};
@@ -188,6 +195,15 @@ private:
 	hrt_abstime _last_instance_change{0};
 
 	hrt_abstime _last_status_publish{0};
+
+	perf_counter_t _latency_perf{perf_alloc(PC_ELAPSED, "ekf2_selector: latency")};
+	perf_counter_t _instance_skew_perf{perf_alloc(PC_ELAPSED, "ekf2_selector: instance skew")};
+
+#if defined(CONFIG_EKF2_MULTI_INSTANCE_PARALLEL)
+	uint64_t _compare_timestamp_sample{0}; ///< primary sample time the other instances are waited for
+	perf_counter_t _sync_missed_perf{perf_alloc(PC_COUNT, "ekf2_selector: sync missed")};
+#endif // CONFIG_EKF2_MULTI_INSTANCE_PARALLEL
+
 	bool _selector_status_publish{false};
 
 	// vehicle_attitude: reset counters
@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include "EKF/ekf.h"
+
+// to run: make tests TESTFILTER=EKF_sequential_fusion
+
+static constexpr float innov[3] {0.1f, -0.2f, 0.05f};
+
+// mean runtime of op in us, every run starts from the state and covariance of ekf_init
+template<typename Op, typename Restore>
+static double runtimeUs(Op op, Ekf &ekf, const Ekf &ekf_init, Restore restore)
+{
+	static constexpr int runs = 1000;
+	double total_us = 0.;
+
+	for (int i = 0; i < runs; i++) {
+		restore(ekf, ekf_init);
+
+		const auto start = std::chrono::steady_clock::now();
+		op();
+		total_us += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	return total_us / runs;
+}
+
+TEST(EkfSequentialFusionTest, velPosFusion)
+{
+	// GIVEN: filters with all states active (complete covariance clean-up) and correlations between all states
+	auto setup = [](Ekf & ekf) {
+		ekf._control_status.flags.mag_3D = true;
+		ekf._control_status.flags.wind = true;
+		ekf.initialiseCovariance();
+		const Ekf::SquareMatrix24f P0 = ekf.P;
+
+		for (int i = 0; i < Ekf::_k_num_states; i++) {
+			for (int j = 0; j < Ekf::_k_num_states; j++) {
+				ekf.P(i, j) += 0.1f * sqrtf(P0(i, i) * P0(j, j));
+			}
+		}
+	};
+
+	Ekf ekf_init;
+	Ekf per_axis;
+	Ekf sequential;
+	setup(ekf_init);
+	setup(per_axis);
+	setup(sequential);
+
+	float innov_var[3];
+
+	for (int axis = 0; axis < 3; axis++) {
+		innov_var[axis] = ekf_init.P(State::vel.idx + axis, State::vel.idx + axis) + sq(0.5f);
+	}
+
+	// WHEN: a velocity observation is fused with a covariance clean-up after each axis and once after the last axis
+	for (int axis = 0; axis < 3; axis++) {
+		EXPECT_TRUE(per_axis.fuseVelPosHeight(innov[axis], innov_var[axis], axis));
+	}
+
+	EXPECT_TRUE(sequential.fuseVelPosHeightSequential(innov, innov_var, 0, 3));
+
+	// THEN: the states and covariances only differ by the rounding of the intermediate clean-up,
+	// except for the accelerometer bias which depends on the variance limits applied between the axes
+	const Ekf::Vector24f state_per_axis = per_axis.getStateAtFusionHorizonAsVector();
+	const Ekf::Vector24f state_sequential = sequential.getStateAtFusionHorizonAsVector();
+
+	auto is_accel_bias = [](int i) {
+		return (i >= (int)State::delta_vel_bias.idx) && (i < (int)(State::delta_vel_bias.idx + State::delta_vel_bias.dof));
+	};
+
+	for (int i = 0; i < Ekf::_k_num_states; i++) {
+		if (is_accel_bias(i)) {
+			continue;
+		}
+
+		EXPECT_NEAR(state_per_axis(i), state_sequential(i), 1e-6f) << "state " << i;
+
+		for (int j = 0; j < Ekf::_k_num_states; j++) {
+			if (!is_accel_bias(j)) {
+				EXPECT_NEAR(per_axis.P(i, j), sequential.P(i, j), 1e-5f * sqrtf(ekf_init.P(i, i) * ekf_init.P(j, j)))
+						<< "P(" << i << ", " << j << ")";
+			}
+		}
+	}
+
+	// AND: report the runtime of both paths, it depends on the host and is not checked
+	auto restore = [](Ekf & ekf, const Ekf & init) {
+		ekf._state = init._state;
+		ekf.P = init.P;
+	};
+
+	const double per_axis_us = runtimeUs([&]() {
+		for (int axis = 0; axis < 3; axis++) {
+			per_axis.fuseVelPosHeight(innov[axis], innov_var[axis], axis);
+		}
+	}, per_axis, ekf_init, restore);
+
+	const double sequential_us = runtimeUs([&]() {
+		sequential.fuseVelPosHeightSequential(innov, innov_var, 0, 3);
+	}, sequential, ekf_init, restore);
+
+	printf("3 axis vel fusion: %.3f us (clean-up per axis), %.3f us (sequential)\n", per_axis_us, sequential_us);
+}
+
+TEST(EkfSequentialFusionTest, magFusion)
+{
+	// GIVEN: a filter with magnetic field states, correlated with all other states
+	Ekf ekf_init;
+	ekf_init._control_status.flags.mag_3D = true;
+	ekf_init._control_status.flags.wind = true;
+	ekf_init._state.quat_nominal = Quatf(Eulerf(0.1f, -0.2f, 0.5f));
+	ekf_init._state.mag_I = Vector3f(0.2f, 0.02f, 0.4f);
+	ekf_init.initialiseCovariance();
+	const Ekf::SquareMatrix24f P0 = ekf_init.P;
+
+	for (int i = 0; i < Ekf::_k_num_states; i++) {
+		for (int j = 0; j < Ekf::_k_num_states; j++) {
+			ekf_init.P(i, j) += 0.1f * sqrtf(P0(i, i) * P0(j, j));
+		}
+	}
+
+	// measurement with the given innovations
+	const Vector3f mag = ekf_init._state.quat_nominal.rotateVectorInverse(ekf_init._state.mag_I)
+			     + ekf_init._state.mag_B - Vector3f(innov);
+
+	Ekf ekf;
+	auto restore = [](Ekf & ekf_restored, const Ekf & init) {
+		ekf_restored._control_status = init._control_status;
+		ekf_restored._state = init._state;
+		ekf_restored.P = init.P;
+	};
+	restore(ekf, ekf_init);
+
+	// WHEN: a 3 axis magnetometer measurement is fused
+	estimator_aid_source3d_s aid_src{};
+	EXPECT_TRUE(ekf.fuseMag(mag, aid_src));
+
+	// THEN: all axes are fused, the innovations are the given ones
+	// and the covariance clean-up leaves P symmetric with reduced magnetic field variances
+	EXPECT_TRUE(aid_src.fused);
+	EXPECT_NEAR(aid_src.innovation[0], innov[0], 1e-6f);
+	EXPECT_TRUE(ekf.P.isBlockSymmetric<Ekf::_k_num_states>(0));
+
+	for (int axis = 0; axis < 3; axis++) {
+		const int index = State::mag_I.idx + axis;
+		EXPECT_LT(ekf.P(index, index), ekf_init.P(index, index));
+	}
+
+	// AND: report the runtime, it depends on the host and is not checked
+	const double mag_us = runtimeUs([&]() { ekf.fuseMag(mag, aid_src); }, ekf, ekf_init, restore);
+
+	printf("3 axis mag fusion: %.3f us (sequential)\n", mag_us);
+}
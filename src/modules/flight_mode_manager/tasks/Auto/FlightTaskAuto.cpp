@@ -93,6 +93,7 @@ bool FlightTaskAuto::updateInitialize()
 	_sub_home_position.update();
 	_sub_vehicle_status.update();
 	_sub_triplet_setpoint.update();
+	_sub_triplet_geometry.update();
 
 	// require valid reference and valid target
 	ret = ret && _evaluateGlobalReference() && _evaluateTriplets();
@@ -401,8 +402,8 @@ bool FlightTaskAuto::_evaluateTriplets()
 		_lock_position_xy.setAll(NAN);
 
 		// Convert from global to local frame.
-		_reference_position.project(_sub_triplet_setpoint.get().current.lat, _sub_triplet_setpoint.get().current.lon,
-					    tmp_target(0), tmp_target(1));
+		_projectToLocalFrame(_sub_triplet_setpoint.get().current, _sub_triplet_geometry.get().current,
+				     tmp_target(0), tmp_target(1));
 	}
 
 	tmp_target(2) = -(_sub_triplet_setpoint.get().current.alt - _reference_altitude);
@@ -441,8 +442,8 @@ bool FlightTaskAuto::_evaluateTriplets()
 		_prev_prev_wp = _triplet_prev_wp;
 
 		if (_isFinite(_sub_triplet_setpoint.get().previous) && _sub_triplet_setpoint.get().previous.valid) {
-			_reference_position.project(_sub_triplet_setpoint.get().previous.lat,
-						    _sub_triplet_setpoint.get().previous.lon, _triplet_prev_wp(0), _triplet_prev_wp(1));
+			_projectToLocalFrame(_sub_triplet_setpoint.get().previous, _sub_triplet_geometry.get().previous,
+					     _triplet_prev_wp(0), _triplet_prev_wp(1));
 			_triplet_prev_wp(2) = -(_sub_triplet_setpoint.get().previous.alt - _reference_altitude);
 
 		} else {
@@ -455,8 +456,8 @@ bool FlightTaskAuto::_evaluateTriplets()
 			_triplet_next_wp = _triplet_target;
 
 		} else if (_isFinite(_sub_triplet_setpoint.get().next) && _sub_triplet_setpoint.get().next.valid) {
-			_reference_position.project(_sub_triplet_setpoint.get().next.lat,
-						    _sub_triplet_setpoint.get().next.lon, _triplet_next_wp(0), _triplet_next_wp(1));
+			_projectToLocalFrame(_sub_triplet_setpoint.get().next, _sub_triplet_geometry.get().next,
+					     _triplet_next_wp(0), _triplet_next_wp(1));
 			_triplet_next_wp(2) = -(_sub_triplet_setpoint.get().next.alt - _reference_altitude);
 
 		} else {
@@ -624,6 +625,24 @@ bool FlightTaskAuto::_evaluateGlobalReference()
 	return PX4_ISFINITE(_reference_altitude) && PX4_ISFINITE(ref_lat) && PX4_ISFINITE(ref_lon);
 }
 
+void FlightTaskAuto::_projectToLocalFrame(const position_setpoint_s &sp, const float local[2], float &x, float &y)
+{
+	// navigator publishes the local geometry of every triplet, only project if it was computed
+	// for another triplet or local frame reference
+	const position_setpoint_triplet_geometry_s &geometry = _sub_triplet_geometry.get();
+
+	if ((geometry.triplet_timestamp == _sub_triplet_setpoint.get().timestamp)
+	    && (geometry.ref_timestamp == _sub_vehicle_local_position.get().ref_timestamp)
+	    && _sub_vehicle_local_position.get().xy_global
+	    && PX4_ISFINITE(local[0]) && PX4_ISFINITE(local[1])) {
+		x = local[0];
+		y = local[1];
+
+	} else {
+		_reference_position.project(sp.lat, sp.lon, x, y);
+	}
+}
+
 State FlightTaskAuto::_getCurrentState()
 {
 	// Calculate the vehicle current state based on the Navigator triplets and the current position.
@@ -41,6 +41,7 @@
 
 #include "FlightTask.hpp"
 #include <uORB/topics/position_setpoint_triplet.h>
+#include <uORB/topics/position_setpoint_triplet_geometry.h>
 #include <uORB/topics/position_setpoint.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/manual_control_setpoint.h>
@@ -187,6 +188,7 @@ private:
 	bool _yaw_lock{false}; /**< if within acceptance radius, lock yaw to current yaw */
 
 	uORB::SubscriptionData<position_setpoint_triplet_s> _sub_triplet_setpoint{ORB_ID(position_setpoint_triplet)};
+	uORB::SubscriptionData<position_setpoint_triplet_geometry_s> _sub_triplet_geometry{ORB_ID(position_setpoint_triplet_geometry)};
 
 	matrix::Vector3f
 	_triplet_target; /**< current triplet from navigator which may differ from the intenal one (_target) depending on the vehicle state. */
@@ -210,6 +212,8 @@ private:
 	bool _evaluateTriplets(); /**< Checks and sets triplets. */
 	bool _isFinite(const position_setpoint_s &sp); /**< Checks if all waypoint triplets are finite. */
 	bool _evaluateGlobalReference(); /**< Check is global reference is available. */
+	void _projectToLocalFrame(const position_setpoint_s &sp, const float local[2], float &x,
+				  float &y); /**< Local position of a triplet setpoint, precomputed by navigator if available. */
 	State _getCurrentState(); /**< Computes the current vehicle state based on the vehicle position and navigator triplets. */
 	void _set_heading_from_mode(); /**< @see  MPC_YAW_MODE */
 };
@@ -1020,6 +1020,29 @@ FixedwingPositionControl::handle_setpoint_type(const position_setpoint_s &pos_sp
 	return position_sp_type;
 }
 
+bool
+FixedwingPositionControl::tripletGeometryValidFor(const position_setpoint_s &setpoint,
+		const position_setpoint_s &triplet_setpoint) const
+{
+	// the setpoint might have been modified (e.g. moved for a VTOL transition)
+	return (_pos_sp_triplet_geometry.triplet_timestamp == _pos_sp_triplet.timestamp)
+	       && (_pos_sp_triplet_geometry.ref_timestamp == _global_local_proj_ref.getProjectionReferenceTimestamp())
+	       && (fabs(setpoint.lat - triplet_setpoint.lat) < DBL_EPSILON)
+	       && (fabs(setpoint.lon - triplet_setpoint.lon) < DBL_EPSILON);
+}
+
+Vector2f
+FixedwingPositionControl::getLocalSetpointPosition(const position_setpoint_s &setpoint,
+		const position_setpoint_s &triplet_setpoint, const float triplet_setpoint_local[2]) const
+{
+	if (tripletGeometryValidFor(setpoint, triplet_setpoint)
+	    && PX4_ISFINITE(triplet_setpoint_local[0]) && PX4_ISFINITE(triplet_setpoint_local[1])) {
+		return Vector2f(triplet_setpoint_local[0], triplet_setpoint_local[1]);
+	}
+
+	return _global_local_proj_ref.project(setpoint.lat, setpoint.lon);
+}
+
 void
 FixedwingPositionControl::control_auto_position(const float control_interval, const Vector2d &curr_pos,
 		const Vector2f &ground_speed, const position_setpoint_s &pos_sp_prev, const position_setpoint_s &pos_sp_curr)
@@ -1031,7 +1054,10 @@ FixedwingPositionControl::control_auto_position(const float control_interval, co
 	/* current waypoint (the one currently heading for) */
 	curr_wp = Vector2d(pos_sp_curr.lat, pos_sp_curr.lon);
 
-	if (_position_setpoint_previous_valid && pos_sp_prev.type != position_setpoint_s::SETPOINT_TYPE_TAKEOFF) {
+	const bool prev_wp_is_setpoint = _position_setpoint_previous_valid
+					 && pos_sp_prev.type != position_setpoint_s::SETPOINT_TYPE_TAKEOFF;
+
+	if (prev_wp_is_setpoint) {
 		prev_wp(0) = pos_sp_prev.lat;
 		prev_wp(1) = pos_sp_prev.lon;
 
@@ -1062,8 +1088,12 @@ FixedwingPositionControl::control_auto_position(const float control_interval, co
 	    ((pos_sp_prev.type == position_setpoint_s::SETPOINT_TYPE_POSITION) ||
 	     (pos_sp_prev.type == position_setpoint_s::SETPOINT_TYPE_LOITER))
 	   ) {
-		const float d_curr_prev = get_distance_to_next_waypoint((double)curr_wp(0), (double)curr_wp(1),
-					  pos_sp_prev.lat, pos_sp_prev.lon);
+		const bool geometry_valid = tripletGeometryValidFor(pos_sp_prev, _pos_sp_triplet.previous)
+					    && tripletGeometryValidFor(pos_sp_curr, _pos_sp_triplet.current)
+					    && PX4_ISFINITE(_pos_sp_triplet_geometry.previous_current_distance);
+
+		const float d_curr_prev = geometry_valid ? _pos_sp_triplet_geometry.previous_current_distance :
+					  get_distance_to_next_waypoint((double)curr_wp(0), (double)curr_wp(1), pos_sp_prev.lat, pos_sp_prev.lon);
 
 		// Do not try to find a solution if the last waypoint is inside the acceptance radius of the current one
 		if (d_curr_prev > math::max(acc_rad, fabsf(pos_sp_curr.loiter_radius))) {
@@ -1093,8 +1123,10 @@ FixedwingPositionControl::control_auto_position(const float control_interval, co
 				_param_fw_airspd_min.get(), ground_speed);
 
 	Vector2f curr_pos_local{_local_pos.x, _local_pos.y};
-	Vector2f curr_wp_local = _global_local_proj_ref.project(curr_wp(0), curr_wp(1));
-	Vector2f prev_wp_local = _global_local_proj_ref.project(prev_wp(0), prev_wp(1));
+	Vector2f curr_wp_local = getLocalSetpointPosition(pos_sp_curr, _pos_sp_triplet.current,
+				 _pos_sp_triplet_geometry.current);
+	Vector2f prev_wp_local = prev_wp_is_setpoint ? getLocalSetpointPosition(pos_sp_prev, _pos_sp_triplet.previous,
+				 _pos_sp_triplet_geometry.previous) : _global_local_proj_ref.project(prev_wp(0), prev_wp(1));
 
 	_npfg.setAirspeedNom(target_airspeed * _eas2tas);
 	_npfg.setAirspeedMax(_param_fw_airspd_max.get() * _eas2tas);
@@ -1228,7 +1260,7 @@ FixedwingPositionControl::control_auto_loiter(const float control_interval, cons
 	}
 
 	Vector2f curr_pos_local{_local_pos.x, _local_pos.y};
-	Vector2f curr_wp_local{_global_local_proj_ref.project(curr_wp(0), curr_wp(1))};
+	Vector2f curr_wp_local{getLocalSetpointPosition(pos_sp_curr, _pos_sp_triplet.current, _pos_sp_triplet_geometry.current)};
 	Vector2f vehicle_to_loiter_center{curr_wp_local - curr_pos_local};
 
 	const bool close_to_circle = vehicle_to_loiter_center.norm() < loiter_radius + _npfg.switchDistance(500);
@@ -2185,6 +2217,7 @@ FixedwingPositionControl::Run()
 			if (_trajectory_setpoint_sub.update(&trajectory_setpoint)) {
 				bool valid_setpoint = false;
 				_pos_sp_triplet = {}; // clear any existing
+				_pos_sp_triplet_geometry = {};
 				_pos_sp_triplet.timestamp = trajectory_setpoint.timestamp;
 				_pos_sp_triplet.current.timestamp = trajectory_setpoint.timestamp;
 				_pos_sp_triplet.current.cruising_speed = NAN; // ignored
@@ -2253,6 +2286,8 @@ FixedwingPositionControl::Run()
 				// reset the altitude foh (first order hold) logic
 				_min_current_sp_distance_xy = FLT_MAX;
 			}
+
+			_pos_sp_triplet_geometry_sub.update(&_pos_sp_triplet_geometry);
 		}
 
 		airspeed_poll();
@@ -79,6 +79,7 @@
 #include <uORB/topics/position_controller_landing_status.h>
 #include <uORB/topics/position_controller_status.h>
 #include <uORB/topics/position_setpoint_triplet.h>
+#include <uORB/topics/position_setpoint_triplet_geometry.h>
 #include <uORB/topics/tecs_status.h>
 #include <uORB/topics/trajectory_setpoint.h>
 #include <uORB/topics/vehicle_air_data.h>
@@ -197,6 +198,7 @@ private:
 	uORB::Subscription _global_pos_sub{ORB_ID(vehicle_global_position)};
 	uORB::Subscription _manual_control_setpoint_sub{ORB_ID(manual_control_setpoint)};
 	uORB::Subscription _pos_sp_triplet_sub{ORB_ID(position_setpoint_triplet)};
+	uORB::Subscription _pos_sp_triplet_geometry_sub{ORB_ID(position_setpoint_triplet_geometry)};
 	uORB::Subscription _trajectory_setpoint_sub{ORB_ID(trajectory_setpoint)};
 	uORB::Subscription _vehicle_air_data_sub{ORB_ID(vehicle_air_data)};
 	uORB::Subscription _vehicle_angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
@@ -219,6 +221,7 @@ private:
 
 	manual_control_setpoint_s _manual_control_setpoint{};
 	position_setpoint_triplet_s _pos_sp_triplet{};
+	position_setpoint_triplet_geometry_s _pos_sp_triplet_geometry{};
 	vehicle_attitude_setpoint_s _att_sp{};
 	vehicle_control_mode_s _control_mode{};
 	vehicle_local_position_s _local_pos{};
@@ -475,6 +478,29 @@ private:
 	void get_waypoint_heading_distance(float heading, position_setpoint_s &waypoint_prev,
 					   position_setpoint_s &waypoint_next, bool flag_init);
 
+	/**
+	 * @brief Checks if the triplet geometry published by navigator belongs to the current triplet and local frame reference
+	 *
+	 * @param setpoint Position setpoint, possibly modified from the one in the triplet
+	 * @param triplet_setpoint Corresponding setpoint of the triplet
+	 * @return true if the geometry of triplet_setpoint can be used for setpoint
+	 */
+	bool tripletGeometryValidFor(const position_setpoint_s &setpoint, const position_setpoint_s &triplet_setpoint) const;
+
+	/**
+	 * @brief Returns the local horizontal position of a setpoint
+	 *
+	 * Uses the local position precomputed by navigator if valid (see tripletGeometryValidFor()),
+	 * and projects the global position otherwise.
+	 *
+	 * @param setpoint Position setpoint, possibly modified from the one in the triplet
+	 * @param triplet_setpoint Corresponding setpoint of the triplet
+	 * @param triplet_setpoint_local Local position of triplet_setpoint from the triplet geometry [m]
+	 * @return Local horizontal position (North, East) [m]
+	 */
+	Vector2f getLocalSetpointPosition(const position_setpoint_s &setpoint, const position_setpoint_s &triplet_setpoint,
+					  const float triplet_setpoint_local[2]) const;
+
 	/**
 	 * @brief Return the terrain estimate during takeoff or takeoff_alt if terrain estimate is not available
 	 *
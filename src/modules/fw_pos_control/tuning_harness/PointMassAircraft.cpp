@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file PointMassAircraft.cpp
+ */
+
+#include "PointMassAircraft.hpp"
+
+#include <lib/mathlib/mathlib.h>
+#include <lib/geo/geo.h>
+
+using matrix::Vector3f;
+
+namespace fw_tuning_harness
+{
+
+static constexpr float AIRSPEED_MIN = 1.f; // avoids the singularity of the flight path dynamics at zero airspeed
+
+void PointMassAircraft::reset(const Vector3f &position, float airspeed, float heading)
+{
+	_state.position = position;
+	_state.airspeed = math::max(airspeed, AIRSPEED_MIN);
+	_state.flight_path_angle = 0.f;
+	_state.heading = heading;
+	_state.roll = 0.f;
+	_state.pitch = trimPitch(_state.airspeed);
+	_state.throttle = trimThrottle(_state.airspeed);
+}
+
+float PointMassAircraft::liftCoefficient(float angle_of_attack) const
+{
+	return math::constrain(_param.cl0 + _param.cl_alpha * angle_of_attack, -_param.cl_max, _param.cl_max);
+}
+
+void PointMassAircraft::update(float dt, float roll_setpoint, float pitch_setpoint, float throttle_setpoint,
+			       const Vector3f &wind)
+{
+	// first order attitude and thrust responses
+	_state.roll += (roll_setpoint - _state.roll) * math::min(dt / _param.roll_time_const, 1.f);
+	_state.pitch += (pitch_setpoint - _state.pitch) * math::min(dt / _param.pitch_time_const, 1.f);
+	_state.throttle += (math::constrain(throttle_setpoint, 0.f, 1.f) - _state.throttle)
+			   * math::min(dt / _param.throttle_time_const, 1.f);
+
+	const float airspeed = _state.airspeed;
+	const float gamma = _state.flight_path_angle;
+	const float dynamic_pressure_area = 0.5f * _param.air_density * airspeed * airspeed * _param.wing_area;
+
+	const float angle_of_attack = _state.pitch - gamma;
+	const float cl = liftCoefficient(angle_of_attack);
+	const float lift = dynamic_pressure_area * cl;
+	const float drag = dynamic_pressure_area * (_param.cd0 + _param.induced_drag_factor * cl * cl);
+	const float thrust = _param.thrust_max * _state.throttle * math::max(1.f - airspeed / _param.prop_airspeed_max, 0.f);
+
+	// forces normal to the flight path, the thrust is aligned with the body x-axis
+	const float normal_force = lift + thrust * sinf(angle_of_attack);
+	const float mass = _param.mass;
+
+	const float airspeed_dot = (thrust * cosf(angle_of_attack) - drag) / mass - CONSTANTS_ONE_G * sinf(gamma);
+	const float gamma_dot = (normal_force * cosf(_state.roll) - mass * CONSTANTS_ONE_G * cosf(gamma)) / (mass * airspeed);
+	const float heading_dot = normal_force * sinf(_state.roll) / (mass * airspeed * math::max(cosf(gamma), 0.1f));
+
+	_state.position += (airVelocity() + wind) * dt;
+	_state.airspeed = math::max(airspeed + airspeed_dot * dt, AIRSPEED_MIN);
+	_state.flight_path_angle = math::constrain(gamma + gamma_dot * dt, -M_PI_2_F + 0.1f, M_PI_2_F - 0.1f);
+	_state.heading = matrix::wrap_pi(_state.heading + heading_dot * dt);
+}
+
+Vector3f PointMassAircraft::airVelocity() const
+{
+	const float horizontal_speed = _state.airspeed * cosf(_state.flight_path_angle);
+	return Vector3f(horizontal_speed * cosf(_state.heading), horizontal_speed * sinf(_state.heading),
+			-_state.airspeed * sinf(_state.flight_path_angle));
+}
+
+float PointMassAircraft::trimPitch(float airspeed) const
+{
+	const float dynamic_pressure_area = 0.5f * _param.air_density * airspeed * airspeed * _param.wing_area;
+	const float cl = _param.mass * CONSTANTS_ONE_G / dynamic_pressure_area;
+	return (cl - _param.cl0) / _param.cl_alpha;
+}
+
+float PointMassAircraft::trimThrottle(float airspeed) const
+{
+	const float angle_of_attack = trimPitch(airspeed);
+	const float dynamic_pressure_area = 0.5f * _param.air_density * airspeed * airspeed * _param.wing_area;
+	const float cl = liftCoefficient(angle_of_attack);
+	const float drag = dynamic_pressure_area * (_param.cd0 + _param.induced_drag_factor * cl * cl);
+	const float thrust_available = _param.thrust_max * math::max(1.f - airspeed / _param.prop_airspeed_max, 0.f);
+
+	if (thrust_available < FLT_EPSILON) {
+		return 1.f;
+	}
+
+	return math::constrain(drag / (thrust_available * cosf(angle_of_attack)), 0.f, 1.f);
+}
+
+} // namespace fw_tuning_harness
@@ -0,0 +1,122 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file PointMassAircraft.hpp
+ *
+ * Point mass fixed-wing model for closed loop tuning of the position controller.
+ *
+ * Roll, pitch and thrust follow their setpoints with a first order response. Lift and drag
+ * result from the angle of attack between the pitch and the air relative flight path angle,
+ * using a linear lift curve and a parabolic drag polar (comparable to a single wing segment
+ * of the SIH aerodynamic model).
+ */
+
+#pragma once
+
+#include <matrix/math.hpp>
+
+namespace fw_tuning_harness
+{
+
+class PointMassAircraft
+{
+public:
+	struct Param {
+		float mass{2.f};			///< [kg]
+		float wing_area{0.45f};			///< [m^2]
+		float cl0{0.3f};			///< lift coefficient at zero angle of attack
+		float cl_alpha{5.f};			///< lift curve slope [1/rad]
+		float cl_max{1.2f};			///< lift coefficient at stall
+		float cd0{0.03f};			///< parasitic drag coefficient
+		float induced_drag_factor{0.05f};	///< k in CD = CD0 + k * CL^2
+		float thrust_max{15.f};			///< static thrust at full throttle [N]
+		float prop_airspeed_max{40.f};		///< airspeed at which the propeller stops producing thrust [m/s]
+		float roll_time_const{0.3f};		///< [s]
+		float pitch_time_const{0.3f};		///< [s]
+		float throttle_time_const{0.1f};	///< [s]
+		float air_density{1.225f};		///< [kg/m^3]
+	};
+
+	struct State {
+		matrix::Vector3f position;		///< NED [m]
+		float airspeed;				///< true airspeed [m/s]
+		float flight_path_angle;		///< air relative, positive up [rad]
+		float heading;				///< air relative course [rad]
+		float roll;				///< [rad]
+		float pitch;				///< [rad]
+		float throttle;				///< [0, 1]
+	};
+
+	explicit PointMassAircraft(const Param &param) : _param(param) {}
+
+	/**
+	 * Reset to steady level flight
+	 *
+	 * @param position NED [m]
+	 * @param airspeed true airspeed [m/s]
+	 * @param heading [rad]
+	 */
+	void reset(const matrix::Vector3f &position, float airspeed, float heading);
+
+	/**
+	 * Integrate the dynamics over one time step (explicit Euler)
+	 *
+	 * @param dt time step [s]
+	 * @param roll_setpoint [rad]
+	 * @param pitch_setpoint [rad]
+	 * @param throttle_setpoint [0, 1]
+	 * @param wind wind velocity NED [m/s]
+	 */
+	void update(float dt, float roll_setpoint, float pitch_setpoint, float throttle_setpoint,
+		    const matrix::Vector3f &wind);
+
+	const State &state() const { return _state; }
+
+	/** velocity relative to the air mass, NED [m/s] */
+	matrix::Vector3f airVelocity() const;
+
+	/** pitch for steady level flight at the given true airspeed [rad] */
+	float trimPitch(float airspeed) const;
+
+	/** throttle for steady level flight at the given true airspeed [0, 1] */
+	float trimThrottle(float airspeed) const;
+
+private:
+	float liftCoefficient(float angle_of_attack) const;
+
+	Param _param;
+	State _state{};
+};
+
+} // namespace fw_tuning_harness
@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "PointMassAircraft.hpp"
+
+#include <lib/geo/geo.h>
+
+using namespace fw_tuning_harness;
+using matrix::Vector3f;
+
+static constexpr float DT = 0.005f;
+
+TEST(PointMassAircraftTest, TrimHoldsLevelFlight)
+{
+	const PointMassAircraft::Param param{};
+	PointMassAircraft aircraft(param);
+	aircraft.reset(Vector3f(0.f, 0.f, -100.f), 15.f, 0.f);
+
+	const float pitch_trim = aircraft.trimPitch(15.f);
+	const float throttle_trim = aircraft.trimThrottle(15.f);
+	EXPECT_GT(throttle_trim, 0.f);
+	EXPECT_LT(throttle_trim, 1.f);
+
+	for (int i = 0; i < 2000; i++) {
+		aircraft.update(DT, 0.f, pitch_trim, throttle_trim, Vector3f{});
+	}
+
+	// 10 seconds of flight straight north, without climbing or losing speed
+	EXPECT_NEAR(aircraft.state().airspeed, 15.f, 0.1f);
+	EXPECT_NEAR(aircraft.state().position(0), 150.f, 1.f);
+	EXPECT_NEAR(aircraft.state().position(1), 0.f, 0.01f);
+	EXPECT_NEAR(aircraft.state().position(2), -100.f, 0.5f);
+}
+
+TEST(PointMassAircraftTest, CoordinatedTurnRate)
+{
+	const PointMassAircraft::Param param{};
+	PointMassAircraft aircraft(param);
+	aircraft.reset(Vector3f(0.f, 0.f, -100.f), 15.f, 0.f);
+
+	// bank 30 degrees at the angle of attack of the increased load factor, full throttle against the induced drag
+	const float roll = math::radians(30.f);
+	const float pitch = aircraft.trimPitch(15.f * sqrtf(cosf(roll)));
+
+	for (int i = 0; i < 400; i++) {
+		aircraft.update(DT, roll, pitch, 1.f, Vector3f{});
+	}
+
+	const float heading_start = aircraft.state().heading;
+
+	for (int i = 0; i < 200; i++) {
+		aircraft.update(DT, roll, pitch, 1.f, Vector3f{});
+	}
+
+	const float turn_rate = matrix::wrap_pi(aircraft.state().heading - heading_start);
+	EXPECT_NEAR(turn_rate, CONSTANTS_ONE_G * tanf(roll) / aircraft.state().airspeed, 0.05f);
+}
+
+TEST(PointMassAircraftTest, WindDriftsGroundTrack)
+{
+	const PointMassAircraft::Param param{};
+	PointMassAircraft aircraft(param);
+	aircraft.reset(Vector3f(0.f, 0.f, -100.f), 15.f, 0.f);
+
+	for (int i = 0; i < 200; i++) {
+		aircraft.update(DT, 0.f, aircraft.trimPitch(15.f), aircraft.trimThrottle(15.f), Vector3f(0.f, 5.f, 0.f));
+	}
+
+	// airspeed is unaffected by the constant wind, the ground track is not
+	EXPECT_NEAR(aircraft.state().airspeed, 15.f, 0.1f);
+	EXPECT_NEAR(aircraft.state().position(1), 5.f, 0.01f);
+}
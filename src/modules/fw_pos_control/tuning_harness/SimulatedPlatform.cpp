@@ -0,0 +1,81 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SimulatedPlatform.cpp
+ */
+
+#include "SimulatedPlatform.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+#include <px4_platform_common/log.h>
+
+static thread_local hrt_abstime simulated_time{0};
+
+static constexpr const char *log_level_str[_PX4_LOG_LEVEL_PANIC + 1] = { "DEBUG", "INFO", "WARN", "ERROR", "PANIC" };
+
+hrt_abstime hrt_absolute_time()
+{
+	return simulated_time;
+}
+
+__EXPORT void px4_log_modulename(int level, const char *module_name, const char *fmt, ...)
+{
+	if (level < _PX4_LOG_LEVEL_WARN) {
+		return;
+	}
+
+	va_list argptr;
+	va_start(argptr, fmt);
+	fprintf(stderr, "%s \t[%s] ", log_level_str[level], module_name);
+	vfprintf(stderr, fmt, argptr);
+	fprintf(stderr, "\n");
+	va_end(argptr);
+}
+
+namespace fw_tuning_harness
+{
+
+void setSimulatedTime(hrt_abstime time)
+{
+	simulated_time = time;
+}
+
+void advanceSimulatedTime(hrt_abstime delta)
+{
+	simulated_time += delta;
+}
+
+} // namespace fw_tuning_harness
@@ -0,0 +1,283 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file TuningScenario.cpp
+ */
+
+#include "TuningScenario.hpp"
+#include "SimulatedPlatform.hpp"
+
+#include <chrono>
+#include <random>
+
+#include <lib/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
+#include <lib/npfg/npfg.hpp>
+#include <lib/tecs/TECS.hpp>
+
+using matrix::Vector2f;
+using matrix::Vector3f;
+using namespace time_literals;
+
+namespace fw_tuning_harness
+{
+
+static constexpr int NUM_WAYPOINTS = 5;
+static constexpr float START_ALTITUDE = 100.f; // [m]
+static constexpr float TURN_ANGLE_MAX = math::radians(150.f);
+static constexpr float ACCEPTANCE_RADIUS = 500.f; // upper bound, NPFG reduces it to its switch distance
+
+Scenario generateScenario(const ScenarioConfig &config, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+	Scenario scenario{};
+	scenario.seed = seed;
+	scenario.start_position = Vector3f(0.f, 0.f, -START_ALTITUDE);
+	scenario.start_heading = matrix::wrap_pi(2.f * M_PI_F * unit(rng));
+	scenario.num_waypoints = NUM_WAYPOINTS;
+
+	Vector3f position = scenario.start_position;
+	float leg_bearing = scenario.start_heading;
+
+	for (int i = 0; i < scenario.num_waypoints; i++) {
+		if (i > 0) {
+			leg_bearing = matrix::wrap_pi(leg_bearing + (2.f * unit(rng) - 1.f) * TURN_ANGLE_MAX);
+		}
+
+		const float leg_length = config.leg_length_min + (config.leg_length_max - config.leg_length_min) * unit(rng);
+		position(0) += leg_length * cosf(leg_bearing);
+		position(1) += leg_length * sinf(leg_bearing);
+		position(2) = -START_ALTITUDE + (2.f * unit(rng) - 1.f) * config.altitude_change_max;
+		scenario.waypoints[i] = position;
+	}
+
+	const float wind_speed = config.wind_speed_max * unit(rng);
+	const float wind_direction = 2.f * M_PI_F * unit(rng);
+	scenario.wind = Vector3f(wind_speed * cosf(wind_direction), wind_speed * sinf(wind_direction), 0.f);
+
+	return scenario;
+}
+
+static void configureControllers(TECS &tecs, NPFG &npfg, const ControllerParams &params, const ScenarioConfig &config)
+{
+	// same as FixedwingPositionControl::parameters_update(), using the parameter defaults where not swept
+	npfg.setPeriod(params.npfg_period);
+	npfg.setDamping(params.npfg_damping);
+	npfg.enableMinGroundSpeed(true);
+	npfg.enableTrackKeeping(true);
+	npfg.enablePeriodLB(true);
+	npfg.enablePeriodUB(true);
+	npfg.setMinGroundSpeed(5.f);
+	npfg.setMaxTrackKeepingMinGroundSpeed(5.f);
+	npfg.setRollTimeConst(params.npfg_roll_time_const);
+	npfg.setSwitchDistanceMultiplier(0.32f);
+	npfg.setRollLimit(config.roll_limit);
+	npfg.setRollSlewRate(math::radians(90.f));
+	npfg.setPeriodSafetyFactor(1.5f);
+
+	tecs.set_max_climb_rate(params.fw_t_clmb_max);
+	tecs.set_max_sink_rate(params.fw_t_sink_max);
+	tecs.set_min_sink_rate(params.fw_t_sink_min);
+	tecs.set_speed_weight(params.fw_t_spdweight);
+	tecs.set_equivalent_airspeed_trim(config.airspeed_trim);
+	tecs.set_equivalent_airspeed_min(config.airspeed_min);
+	tecs.set_equivalent_airspeed_max(config.airspeed_max);
+	tecs.set_throttle_damp(params.fw_t_thr_damp);
+	tecs.set_integrator_gain_throttle(params.fw_t_i_gain_thr);
+	tecs.set_integrator_gain_pitch(params.fw_t_i_gain_pit);
+	tecs.set_throttle_slewrate(0.f);
+	tecs.set_vertical_accel_limit(params.fw_t_vert_acc);
+	tecs.set_roll_throttle_compensation(params.fw_t_rll2thr);
+	tecs.set_pitch_damping(params.fw_t_ptch_damp);
+	tecs.set_altitude_error_time_constant(params.fw_t_alt_tc);
+	tecs.set_altitude_rate_ff(params.fw_t_hrate_ff);
+	tecs.set_airspeed_error_time_constant(params.fw_t_tas_tc);
+	tecs.set_ste_rate_time_const(params.fw_t_ste_r_tc);
+	tecs.set_seb_rate_ff_gain(params.fw_t_seb_r_ff);
+}
+
+/**
+ * Waypoint following as in FixedwingPositionControl::navigateWaypoints()
+ *
+ * @return unit tangent of the tracked path
+ */
+static Vector2f navigateWaypoints(NPFG &npfg, const Vector2f &waypoint_A, const Vector2f &waypoint_B,
+			      const Vector2f &vehicle_pos, const Vector2f &ground_vel, const Vector2f &wind_vel)
+{
+	Vector2f vector_A_to_B = waypoint_B - waypoint_A;
+	const Vector2f vector_A_to_vehicle = vehicle_pos - waypoint_A;
+
+	if (vector_A_to_B.norm() < FLT_EPSILON) {
+		if (vector_A_to_vehicle.norm() < FLT_EPSILON) {
+			return Vector2f{};
+		}
+
+		vector_A_to_B = -vector_A_to_vehicle;
+
+	} else if ((vector_A_to_B.dot(vector_A_to_vehicle) < -FLT_EPSILON)
+		   && (vector_A_to_vehicle.norm() > npfg.switchDistance(ACCEPTANCE_RADIUS))) {
+		vector_A_to_B = -vector_A_to_vehicle;
+	}
+
+	const Vector2f unit_path_tangent = vector_A_to_B.normalized();
+	npfg.guideToPath(vehicle_pos, ground_vel, wind_vel, unit_path_tangent, waypoint_A, 0.f);
+	return unit_path_tangent;
+}
+
+ScenarioResult runScenario(const Scenario &scenario, const ControllerParams &params,
+			   const PointMassAircraft::Param &aircraft_param, const ScenarioConfig &config)
+{
+	const auto run_start = std::chrono::steady_clock::now();
+
+	const float dt = 1.f / config.control_rate;
+	const int substeps = math::max(config.physics_substeps, 1);
+	const hrt_abstime dt_us = static_cast<hrt_abstime>(1e6f * dt);
+
+	// the gusts are a first order Gauss-Markov process per axis
+	std::mt19937 rng(scenario.seed);
+	std::normal_distribution<float> normal(0.f, 1.f);
+	const float gust_decay = expf(-dt / config.gust_time_const);
+	const float gust_drive = config.gust_std_dev * sqrtf(1.f - gust_decay * gust_decay);
+	Vector3f gust{};
+
+	PointMassAircraft aircraft(aircraft_param);
+	aircraft.reset(scenario.start_position, config.airspeed_trim, scenario.start_heading);
+
+	const float throttle_trim = aircraft.trimThrottle(config.airspeed_trim);
+
+	TECS tecs;
+	NPFG npfg;
+	configureControllers(tecs, npfg, params, config);
+	npfg.setDt(dt);
+
+	setSimulatedTime(1_s);
+	tecs.initialize(-scenario.start_position(2), 0.f, config.airspeed_trim, 1.f);
+
+	float roll_sp = 0.f;
+	float pitch_sp = aircraft.state().pitch;
+	float throttle_sp = aircraft.state().throttle;
+	float airspeed_prev = aircraft.state().airspeed;
+
+	int waypoint_index = 0;
+	int samples = 0;
+	double crosstrack_error_sq_sum = 0.0;
+	double altitude_error_sq_sum = 0.0;
+	double airspeed_error_sq_sum = 0.0;
+
+	ScenarioResult result{};
+	result.airspeed_min = aircraft.state().airspeed;
+	float time = 0.f;
+
+	while (time < config.max_duration) {
+		// environment and plant
+		gust = gust * gust_decay + Vector3f(normal(rng), normal(rng), normal(rng)) * gust_drive;
+		const Vector3f wind = scenario.wind + gust;
+
+		for (int i = 0; i < substeps; i++) {
+			aircraft.update(dt / substeps, roll_sp, pitch_sp, throttle_sp, wind);
+		}
+
+		advanceSimulatedTime(dt_us);
+		time += dt;
+
+		// ideal state estimate, wind estimate without gusts
+		const PointMassAircraft::State &state = aircraft.state();
+		const Vector3f ground_vel = aircraft.airVelocity() + wind;
+		const Vector2f position_xy(state.position(0), state.position(1));
+		const Vector2f ground_vel_xy(ground_vel(0), ground_vel(1));
+		const Vector2f wind_xy(scenario.wind(0), scenario.wind(1));
+		const float altitude = -state.position(2);
+		const float airspeed_derivative = (state.airspeed - airspeed_prev) / dt;
+		airspeed_prev = state.airspeed;
+
+		const Vector2f current_xy(scenario.waypoints[waypoint_index](0), scenario.waypoints[waypoint_index](1));
+
+		if (Vector2f(current_xy - position_xy).norm() < npfg.switchDistance(ACCEPTANCE_RADIUS)
+		    && ++waypoint_index >= scenario.num_waypoints) {
+			result.completed = true;
+			break;
+		}
+
+		const Vector3f &waypoint = scenario.waypoints[waypoint_index];
+		const Vector2f waypoint_B(waypoint(0), waypoint(1));
+		const Vector3f &previous = waypoint_index > 0 ? scenario.waypoints[waypoint_index - 1] : scenario.start_position;
+		const Vector2f waypoint_A(previous(0), previous(1));
+
+		// lateral guidance
+		npfg.setAirspeedNom(config.airspeed_trim);
+		npfg.setAirspeedMax(config.airspeed_max);
+		const Vector2f unit_path_tangent = navigateWaypoints(npfg, waypoint_A, waypoint_B, position_xy, ground_vel_xy,
+						   wind_xy);
+		roll_sp = npfg.getRollSetpoint();
+		const float airspeed_sp = npfg.getAirspeedRef();
+
+		// longitudinal control
+		tecs.set_load_factor(1.f / math::max(cosf(state.roll), 0.1f));
+		tecs.update(state.pitch, altitude, -waypoint(2), airspeed_sp, state.airspeed, 1.f, 0.f, 1.f,
+			    throttle_trim, throttle_trim, config.pitch_min, config.pitch_max, config.climb_rate_target,
+			    config.sink_rate_target, airspeed_derivative, -ground_vel(2));
+		pitch_sp = tecs.get_pitch_setpoint();
+		throttle_sp = tecs.get_throttle_setpoint();
+
+		// metrics
+		const float crosstrack_error = fabsf(unit_path_tangent % Vector2f(position_xy - waypoint_A));
+		const float altitude_error = fabsf(tecs.getStatus().altitude_reference - altitude);
+		const float airspeed_error = airspeed_sp - state.airspeed;
+
+		crosstrack_error_sq_sum += static_cast<double>(crosstrack_error * crosstrack_error);
+		altitude_error_sq_sum += static_cast<double>(altitude_error * altitude_error);
+		airspeed_error_sq_sum += static_cast<double>(airspeed_error * airspeed_error);
+		samples++;
+
+		result.crosstrack_error_max = math::max(result.crosstrack_error_max, crosstrack_error);
+		result.altitude_error_max = math::max(result.altitude_error_max, altitude_error);
+		result.airspeed_min = math::min(result.airspeed_min, state.airspeed);
+	}
+
+	if (samples > 0) {
+		result.crosstrack_error_rms = static_cast<float>(sqrt(crosstrack_error_sq_sum / samples));
+		result.altitude_error_rms = static_cast<float>(sqrt(altitude_error_sq_sum / samples));
+		result.airspeed_error_rms = static_cast<float>(sqrt(airspeed_error_sq_sum / samples));
+	}
+
+	result.mission_time = time;
+	result.run_time_us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>
+			     (std::chrono::steady_clock::now() - run_start).count());
+
+	return result;
+}
+
+} // namespace fw_tuning_harness
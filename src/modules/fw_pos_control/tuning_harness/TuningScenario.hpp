@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file TuningScenario.hpp
+ *
+ * Closed loop waypoint scenarios flown by TECS and NPFG against the point mass model.
+ */
+
+#pragma once
+
+#include "PointMassAircraft.hpp"
+
+#include <cstdint>
+
+namespace fw_tuning_harness
+{
+
+/**
+ * Controller parameters swept by the harness, named and defaulted after the corresponding PX4 parameters
+ */
+struct ControllerParams {
+	float npfg_period{10.f};		///< NPFG_PERIOD
+	float npfg_damping{0.7f};		///< NPFG_DAMPING
+	float npfg_roll_time_const{0.5f};	///< NPFG_ROLL_TC
+	float fw_t_alt_tc{5.f};			///< FW_T_ALT_TC
+	float fw_t_tas_tc{5.f};			///< FW_T_TAS_TC
+	float fw_t_thr_damp{0.1f};		///< FW_T_THR_DAMP
+	float fw_t_ptch_damp{0.1f};		///< FW_T_PTCH_DAMP
+	float fw_t_i_gain_thr{0.1f};		///< FW_T_I_GAIN_THR
+	float fw_t_i_gain_pit{0.1f};		///< FW_T_I_GAIN_PIT
+	float fw_t_spdweight{1.f};		///< FW_T_SPDWEIGHT
+	float fw_t_hrate_ff{0.3f};		///< FW_T_HRATE_FF
+	float fw_t_ste_r_tc{0.4f};		///< FW_T_STE_R_TC
+	float fw_t_seb_r_ff{1.f};		///< FW_T_SEB_R_FF
+	float fw_t_vert_acc{7.f};		///< FW_T_VERT_ACC
+	float fw_t_clmb_max{5.f};		///< FW_T_CLMB_MAX
+	float fw_t_sink_max{5.f};		///< FW_T_SINK_MAX
+	float fw_t_sink_min{2.f};		///< FW_T_SINK_MIN
+	float fw_t_rll2thr{15.f};		///< FW_T_RLL2THR
+};
+
+/**
+ * Settings shared by all scenarios of a sweep
+ */
+struct ScenarioConfig {
+	float control_rate{50.f};		///< position controller rate [Hz]
+	int physics_substeps{4};		///< model integration steps per control step
+	float max_duration{300.f};		///< scenario timeout [s]
+	float airspeed_min{10.f};		///< FW_AIRSPD_MIN [m/s]
+	float airspeed_trim{15.f};		///< FW_AIRSPD_TRIM [m/s]
+	float airspeed_max{20.f};		///< FW_AIRSPD_MAX [m/s]
+	float roll_limit{0.87f};		///< FW_R_LIM [rad]
+	float pitch_min{-0.52f};		///< FW_P_LIM_MIN [rad]
+	float pitch_max{0.52f};			///< FW_P_LIM_MAX [rad]
+	float climb_rate_target{3.f};		///< FW_T_CLMB_R_SP [m/s]
+	float sink_rate_target{2.f};		///< FW_T_SINK_R_SP [m/s]
+	float leg_length_min{150.f};		///< [m]
+	float leg_length_max{500.f};		///< [m]
+	float altitude_change_max{40.f};	///< maximum altitude change between waypoints [m]
+	float wind_speed_max{5.f};		///< maximum mean horizontal wind [m/s]
+	float gust_std_dev{1.f};		///< gust standard deviation per axis [m/s]
+	float gust_time_const{2.f};		///< gust correlation time [s]
+};
+
+static constexpr int MAX_WAYPOINTS = 8;
+
+/**
+ * A randomized mission: start state, waypoints and wind
+ */
+struct Scenario {
+	matrix::Vector3f start_position;
+	float start_heading;
+	matrix::Vector3f waypoints[MAX_WAYPOINTS];	///< NED [m]
+	int num_waypoints;
+	matrix::Vector3f wind;				///< mean wind NED [m/s]
+	uint32_t seed;					///< gust noise seed
+};
+
+/**
+ * Tracking metrics of one scenario run
+ */
+struct ScenarioResult {
+	float crosstrack_error_rms;	///< [m]
+	float crosstrack_error_max;	///< [m]
+	float altitude_error_rms;	///< altitude error to the TECS altitude reference [m]
+	float altitude_error_max;	///< [m]
+	float airspeed_error_rms;	///< [m/s]
+	float airspeed_min;		///< [m/s]
+	float mission_time;		///< time to reach the last waypoint (or the timeout) [s]
+	bool completed;			///< last waypoint reached before the timeout
+	uint32_t run_time_us;		///< wall clock time spent in the simulation [us]
+};
+
+/**
+ * Generate a random waypoint mission
+ *
+ * Scenarios only depend on the seed, so every parameter set can be evaluated on the same missions.
+ */
+Scenario generateScenario(const ScenarioConfig &config, uint32_t seed);
+
+/**
+ * Fly a scenario with TECS and NPFG in closed loop
+ *
+ * Not reentrant per thread: uses the simulated clock of the calling thread.
+ */
+ScenarioResult runScenario(const Scenario &scenario, const ControllerParams &params,
+			   const PointMassAircraft::Param &aircraft_param, const ScenarioConfig &config);
+
+} // namespace fw_tuning_harness
@@ -0,0 +1,371 @@
+/****************************************************************************
+ *
+ * Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file fw_tuning_harness_main.cpp
+ *
+ * Headless Monte-Carlo tuning harness for the fixed-wing TECS and NPFG controllers.
+ *
+ * Randomly samples controller parameter sets within the given ranges and flies every set on
+ * the same randomized waypoint missions (wind, gusts, turns and altitude changes) against a
+ * point mass aircraft model, distributing the runs over worker threads. Reports the tracking
+ * metrics and run time of each run (CSV) and ranks the parameter sets by a normalized cost.
+ */
+
+#include "TuningScenario.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <getopt.h>
+
+using namespace fw_tuning_harness;
+
+namespace
+{
+
+struct ParamRange {
+	const char *name;
+	float ControllerParams::*member;
+	float min;
+	float max;
+	bool swept;
+};
+
+ParamRange param_ranges[] = {
+	{"NPFG_PERIOD", &ControllerParams::npfg_period, 0.f, 0.f, false},
+	{"NPFG_DAMPING", &ControllerParams::npfg_damping, 0.f, 0.f, false},
+	{"NPFG_ROLL_TC", &ControllerParams::npfg_roll_time_const, 0.f, 0.f, false},
+	{"FW_T_ALT_TC", &ControllerParams::fw_t_alt_tc, 0.f, 0.f, false},
+	{"FW_T_TAS_TC", &ControllerParams::fw_t_tas_tc, 0.f, 0.f, false},
+	{"FW_T_THR_DAMP", &ControllerParams::fw_t_thr_damp, 0.f, 0.f, false},
+	{"FW_T_PTCH_DAMP", &ControllerParams::fw_t_ptch_damp, 0.f, 0.f, false},
+	{"FW_T_I_GAIN_THR", &ControllerParams::fw_t_i_gain_thr, 0.f, 0.f, false},
+	{"FW_T_I_GAIN_PIT", &ControllerParams::fw_t_i_gain_pit, 0.f, 0.f, false},
+	{"FW_T_SPDWEIGHT", &ControllerParams::fw_t_spdweight, 0.f, 0.f, false},
+	{"FW_T_HRATE_FF", &ControllerParams::fw_t_hrate_ff, 0.f, 0.f, false},
+	{"FW_T_STE_R_TC", &ControllerParams::fw_t_ste_r_tc, 0.f, 0.f, false},
+	{"FW_T_SEB_R_FF", &ControllerParams::fw_t_seb_r_ff, 0.f, 0.f, false},
+	{"FW_T_VERT_ACC", &ControllerParams::fw_t_vert_acc, 0.f, 0.f, false},
+	{"FW_T_CLMB_MAX", &ControllerParams::fw_t_clmb_max, 0.f, 0.f, false},
+	{"FW_T_SINK_MAX", &ControllerParams::fw_t_sink_max, 0.f, 0.f, false},
+	{"FW_T_SINK_MIN", &ControllerParams::fw_t_sink_min, 0.f, 0.f, false},
+	{"FW_T_RLL2THR", &ControllerParams::fw_t_rll2thr, 0.f, 0.f, false},
+};
+
+// normalization of the cost terms, a parameter set scoring 1 per term is considered acceptable
+static constexpr float CROSSTRACK_ERROR_NORM = 5.f;	// [m]
+static constexpr float ALTITUDE_ERROR_NORM = 2.f;	// [m]
+static constexpr float AIRSPEED_ERROR_NORM = 1.f;	// [m/s]
+static constexpr float INCOMPLETE_PENALTY = 10.f;
+
+struct ParamSetSummary {
+	int index;
+	float cost;
+	float crosstrack_error_rms;
+	float altitude_error_rms;
+	float airspeed_error_rms;
+	float airspeed_min;
+	int completed;
+};
+
+void usage(const char *name)
+{
+	printf("Usage: %s [options] [-p NAME=min:max ...]\n\n"
+	       "Fly randomized waypoint missions with TECS and NPFG against a point mass aircraft model,\n"
+	       "sweeping the controller parameters given with -p uniformly within their ranges.\n"
+	       "Parameter set 0 always uses the defaults as baseline.\n\n"
+	       "  -n <count>     number of parameter sets (default 16)\n"
+	       "  -s <count>     scenarios per parameter set (default 64)\n"
+	       "  -j <threads>   worker threads (default: hardware concurrency)\n"
+	       "  -r <seed>      random seed (default 1)\n"
+	       "  -w <m/s>       maximum mean wind speed (default 5)\n"
+	       "  -g <m/s>       gust standard deviation (default 1)\n"
+	       "  -t <s>         scenario timeout (default 300)\n"
+	       "  -o <file>      write per run results as CSV\n"
+	       "  -p NAME=a:b    sweep parameter NAME within [a, b]\n"
+	       "  -l             list the parameters and their defaults\n\n"
+	       "Cost: rms crosstrack / %.0f m + rms altitude / %.0f m + rms airspeed / %.0f m/s, +%.0f per incomplete run\n",
+	       name, (double)CROSSTRACK_ERROR_NORM, (double)ALTITUDE_ERROR_NORM, (double)AIRSPEED_ERROR_NORM,
+	       (double)INCOMPLETE_PENALTY);
+}
+
+bool parseRange(const char *arg)
+{
+	const char *equal = strchr(arg, '=');
+	float min = 0.f;
+	float max = 0.f;
+
+	if (equal == nullptr || sscanf(equal + 1, "%f:%f", &min, &max) != 2 || min > max) {
+		fprintf(stderr, "invalid parameter range '%s', expected NAME=min:max\n", arg);
+		return false;
+	}
+
+	for (ParamRange &range : param_ranges) {
+		if (strlen(range.name) == static_cast<size_t>(equal - arg) && strncmp(range.name, arg, equal - arg) == 0) {
+			range.min = min;
+			range.max = max;
+			range.swept = true;
+			return true;
+		}
+	}
+
+	fprintf(stderr, "unknown parameter in '%s' (list them with -l)\n", arg);
+	return false;
+}
+
+float cost(const ScenarioResult &result)
+{
+	return result.crosstrack_error_rms / CROSSTRACK_ERROR_NORM + result.altitude_error_rms / ALTITUDE_ERROR_NORM
+	       + result.airspeed_error_rms / AIRSPEED_ERROR_NORM + (result.completed ? 0.f : INCOMPLETE_PENALTY);
+}
+
+void writeCsv(const char *file_name, const std::vector<ControllerParams> &param_sets,
+	      const std::vector<ScenarioResult> &results, int num_scenarios)
+{
+	FILE *file = fopen(file_name, "w");
+
+	if (file == nullptr) {
+		fprintf(stderr, "failed to open %s\n", file_name);
+		return;
+	}
+
+	fprintf(file, "param_set,scenario");
+
+	for (const ParamRange &range : param_ranges) {
+		fprintf(file, ",%s", range.name);
+	}
+
+	fprintf(file, ",crosstrack_rms,crosstrack_max,altitude_rms,altitude_max,airspeed_rms,airspeed_min,"
+		"mission_time,completed,run_time_us\n");
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const ControllerParams &params = param_sets[i / num_scenarios];
+		const ScenarioResult &result = results[i];
+		fprintf(file, "%zu,%zu", i / num_scenarios, i % num_scenarios);
+
+		for (const ParamRange &range : param_ranges) {
+			fprintf(file, ",%.4f", (double)(params.*range.member));
+		}
+
+		fprintf(file, ",%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%d,%u\n",
+			(double)result.crosstrack_error_rms, (double)result.crosstrack_error_max,
+			(double)result.altitude_error_rms, (double)result.altitude_error_max,
+			(double)result.airspeed_error_rms, (double)result.airspeed_min,
+			(double)result.mission_time, result.completed, result.run_time_us);
+	}
+
+	fclose(file);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	int num_param_sets = 16;
+	int num_scenarios = 64;
+	int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+	uint32_t seed = 1;
+	const char *csv_file = nullptr;
+
+	ScenarioConfig config{};
+	const PointMassAircraft::Param aircraft_param{};
+
+	int ch;
+
+	while ((ch = getopt(argc, argv, "n:s:j:r:w:g:t:o:p:lh")) != -1) {
+		switch (ch) {
+		case 'n': num_param_sets = atoi(optarg); break;
+
+		case 's': num_scenarios = atoi(optarg); break;
+
+		case 'j': num_threads = atoi(optarg); break;
+
+		case 'r': seed = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+
+		case 'w': config.wind_speed_max = strtof(optarg, nullptr); break;
+
+		case 'g': config.gust_std_dev = strtof(optarg, nullptr); break;
+
+		case 't': config.max_duration = strtof(optarg, nullptr); break;
+
+		case 'o': csv_file = optarg; break;
+
+		case 'p':
+			if (!parseRange(optarg)) {
+				return 1;
+			}
+
+			break;
+
+		case 'l': {
+				const ControllerParams defaults{};
+
+				for (const ParamRange &range : param_ranges) {
+					printf("%-16s %.3f\n", range.name, (double)(defaults.*range.member));
+				}
+
+				return 0;
+			}
+
+		default:
+			usage(argv[0]);
+			return ch == 'h' ? 0 : 1;
+		}
+	}
+
+	if (num_param_sets < 1 || num_scenarios < 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	num_threads = std::max(num_threads, 1);
+
+	// parameter set 0 is the baseline, the others are sampled uniformly within the swept ranges
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	std::vector<ControllerParams> param_sets(num_param_sets);
+
+	for (int i = 1; i < num_param_sets; i++) {
+		for (const ParamRange &range : param_ranges) {
+			if (range.swept) {
+				param_sets[i].*range.member = range.min + (range.max - range.min) * unit(rng);
+			}
+		}
+	}
+
+	// common random numbers: every parameter set flies the same scenarios
+	std::vector<Scenario> scenarios(num_scenarios);
+
+	for (int i = 0; i < num_scenarios; i++) {
+		scenarios[i] = generateScenario(config, seed * 7919u + static_cast<uint32_t>(i));
+	}
+
+	const int num_runs = num_param_sets * num_scenarios;
+	std::vector<ScenarioResult> results(num_runs);
+	std::atomic<int> next_run{0};
+
+	printf("running %d parameter sets x %d scenarios on %d threads\n", num_param_sets, num_scenarios, num_threads);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	auto worker = [&]() {
+		for (int run = next_run++; run < num_runs; run = next_run++) {
+			results[run] = runScenario(scenarios[run % num_scenarios], param_sets[run / num_scenarios], aircraft_param,
+						   config);
+		}
+	};
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < num_threads; i++) {
+		threads.emplace_back(worker);
+	}
+
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	const double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (csv_file) {
+		writeCsv(csv_file, param_sets, results, num_scenarios);
+	}
+
+	// per parameter set summary
+	std::vector<ParamSetSummary> summaries(num_param_sets);
+	double simulated_time = 0.0;
+	double run_time = 0.0;
+	uint32_t run_time_max = 0;
+
+	for (int i = 0; i < num_param_sets; i++) {
+		ParamSetSummary &summary = summaries[i];
+		summary = ParamSetSummary{i, 0.f, 0.f, 0.f, 0.f, INFINITY, 0};
+
+		for (int j = 0; j < num_scenarios; j++) {
+			const ScenarioResult &result = results[i * num_scenarios + j];
+			summary.cost += cost(result) / num_scenarios;
+			summary.crosstrack_error_rms += result.crosstrack_error_rms / num_scenarios;
+			summary.altitude_error_rms += result.altitude_error_rms / num_scenarios;
+			summary.airspeed_error_rms += result.airspeed_error_rms / num_scenarios;
+			summary.airspeed_min = std::min(summary.airspeed_min, result.airspeed_min);
+			summary.completed += result.completed;
+
+			simulated_time += static_cast<double>(result.mission_time);
+			run_time += result.run_time_us * 1e-6;
+			run_time_max = std::max(run_time_max, result.run_time_us);
+		}
+	}
+
+	printf("%d runs in %.2f s wall time (%.0f runs/s), %.0f s simulated\n", num_runs, wall_time, num_runs / wall_time,
+	       simulated_time);
+	printf("run time per scenario: mean %.2f ms, max %.2f ms, %.0fx real time per thread\n\n",
+	       1e3 * run_time / num_runs, 1e-3 * run_time_max, simulated_time / run_time);
+
+	const ParamSetSummary baseline = summaries[0];
+	std::sort(summaries.begin(), summaries.end(), [](const ParamSetSummary & a, const ParamSetSummary & b) {
+		return a.cost < b.cost;
+	});
+
+	printf("%-5s %8s %10s %10s %10s %10s %10s\n", "set", "cost", "xtrack[m]", "alt[m]", "tas[m/s]", "tas_min", "completed");
+
+	auto print_summary = [&](const ParamSetSummary & summary) {
+		printf("%-5d %8.3f %10.2f %10.2f %10.2f %10.2f %6d/%-3d", summary.index, (double)summary.cost,
+		       (double)summary.crosstrack_error_rms, (double)summary.altitude_error_rms, (double)summary.airspeed_error_rms,
+		       (double)summary.airspeed_min, summary.completed, num_scenarios);
+
+		for (const ParamRange &range : param_ranges) {
+			if (range.swept) {
+				printf(" %s=%.3f", range.name, (double)(param_sets[summary.index].*range.member));
+			}
+		}
+
+		printf("\n");
+	};
+
+	print_summary(baseline);
+	printf("best:\n");
+
+	for (int i = 0; i < std::min(num_param_sets, 5); i++) {
+		print_summary(summaries[i]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,233 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file FFTBackend.hpp
+ *
+ * FFT backends for GyroFFT, selected at compile time (CONFIG_GYRO_FFT_FLOAT).
+ *
+ * Each backend applies a Hann window to N q15 gyro samples and computes the real FFT.
+ * The output is interleaved [real[0], imag[0], real[1], imag[1] ... real[N/2], imag[N/2]]
+ * of type output_t. The spectrum scaling differs between the backends, the peak
+ * detection only uses ratios.
+ */
+
+#pragma once
+
+#include <lib/mathlib/math/RealFFT.hpp>
+#include <px4_platform_common/defines.h>
+
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+namespace gyro_fft
+{
+
+/**
+ * CMSIS-DSP q15 fixed point FFT, fast on Cortex-M with DSP extensions
+ */
+class FFTBackendQ15
+{
+public:
+	using output_t = q15_t;
+
+	static constexpr const char *name() { return "q15"; }
+
+	~FFTBackendQ15()
+	{
+		delete[] _hanning_window;
+		delete[] _fft_input_buffer;
+		delete[] _fft_outupt_buffer;
+	}
+
+	static bool supported(int N)
+	{
+		return (N == 256) || (N == 512) || (N == 1024);
+	}
+
+	bool init(int N)
+	{
+		// arm_rfft_init_q15(&_rfft_q15, N, 0, 1) manually inlined to save flash
+		_rfft_q15.pTwiddleAReal = (q15_t *) realCoefAQ15;
+		_rfft_q15.pTwiddleBReal = (q15_t *) realCoefBQ15;
+		_rfft_q15.ifftFlagR = 0;
+		_rfft_q15.bitReverseFlagR = 1;
+
+		switch (N) {
+		// case 128:
+		// 	_rfft_q15.fftLenReal = 128;
+		// 	_rfft_q15.twidCoefRModifier = 64U;
+		// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len64;
+		// 	break;
+
+		case 256:
+			_rfft_q15.fftLenReal = 256;
+			_rfft_q15.twidCoefRModifier = 32U;
+			_rfft_q15.pCfft = &arm_cfft_sR_q15_len128;
+			break;
+
+		case 512:
+			_rfft_q15.fftLenReal = 512;
+			_rfft_q15.twidCoefRModifier = 16U;
+			_rfft_q15.pCfft = &arm_cfft_sR_q15_len256;
+			break;
+
+		case 1024:
+			_rfft_q15.fftLenReal = 1024;
+			_rfft_q15.twidCoefRModifier = 8U;
+			_rfft_q15.pCfft = &arm_cfft_sR_q15_len512;
+			break;
+
+		// case 2048:
+		// 	_rfft_q15.fftLenReal = 2048;
+		// 	_rfft_q15.twidCoefRModifier = 4U;
+		// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len1024;
+		// 	break;
+
+		// case 4096:
+		// 	_rfft_q15.fftLenReal = 4096;
+		// 	_rfft_q15.twidCoefRModifier = 2U;
+		// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len2048;
+		// 	break;
+
+		default:
+			return false;
+		}
+
+		_length = N;
+		_hanning_window = new q15_t[N];
+		_fft_input_buffer = new q15_t[N];
+		_fft_outupt_buffer = new q15_t[N * 2];
+
+		if (!_hanning_window || !_fft_input_buffer || !_fft_outupt_buffer) {
+			return false;
+		}
+
+		// init Hanning window
+		for (int n = 0; n < N; n++) {
+			const float hanning_value = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (N - 1)));
+			arm_float_to_q15(&hanning_value, &_hanning_window[n], 1);
+		}
+
+		return true;
+	}
+
+	output_t *transform(q15_t *input)
+	{
+		arm_mult_q15(input, _hanning_window, _fft_input_buffer, _length);
+		arm_rfft_q15(&_rfft_q15, _fft_input_buffer, _fft_outupt_buffer);
+		return _fft_outupt_buffer;
+	}
+
+private:
+	arm_rfft_instance_q15 _rfft_q15{};
+
+	q15_t *_hanning_window{nullptr};
+	q15_t *_fft_input_buffer{nullptr};
+	q15_t *_fft_outupt_buffer{nullptr};
+
+	int _length{0};
+};
+
+/**
+ * float32 FFT (math::RealFFT), portable and auto-vectorized on x86 and ARM64 (SITL, companion computers)
+ */
+class FFTBackendFloat
+{
+public:
+	using output_t = float;
+
+	static constexpr const char *name() { return "float"; }
+
+	~FFTBackendFloat()
+	{
+		delete[] _hanning_window;
+		delete[] _fft_input_buffer;
+		delete[] _fft_outupt_buffer;
+	}
+
+	static bool supported(int N)
+	{
+		return math::RealFFT::supported(N) && (N >= 256) && (N <= 4096);
+	}
+
+	bool init(int N)
+	{
+		if (!supported(N) || !_rfft.init(N)) {
+			return false;
+		}
+
+		_length = N;
+		_hanning_window = new float[N];
+		_fft_input_buffer = new float[N];
+		_fft_outupt_buffer = new float[N + 2];
+
+		if (!_hanning_window || !_fft_input_buffer || !_fft_outupt_buffer) {
+			return false;
+		}
+
+		// init Hanning window (same as the q15 backend)
+		for (int n = 0; n < N; n++) {
+			_hanning_window[n] = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (N - 1)));
+		}
+
+		return true;
+	}
+
+	output_t *transform(q15_t *input)
+	{
+		for (int n = 0; n < _length; n++) {
+			_fft_input_buffer[n] = input[n] * _hanning_window[n];
+		}
+
+		_rfft.forward(_fft_input_buffer, _fft_outupt_buffer);
+		return _fft_outupt_buffer;
+	}
+
+private:
+	math::RealFFT _rfft{};
+
+	float *_hanning_window{nullptr};
+	float *_fft_input_buffer{nullptr};
+	float *_fft_outupt_buffer{nullptr};
+
+	int _length{0};
+};
+
+#if defined(CONFIG_GYRO_FFT_FLOAT)
+using FFTBackend = FFTBackendFloat;
+#else
+using FFTBackend = FFTBackendQ15;
+#endif
+
+} // namespace gyro_fft
@@ -59,92 +59,46 @@ GyroFFT::~GyroFFT()
 	perf_free(_fft_perf);
 	perf_free(_gyro_generation_gap_perf);
 	perf_free(_gyro_fifo_generation_gap_perf);
+	perf_free(_sliding_dft_perf);
+	perf_free(_sliding_dft_init_failed_perf);
 
 	delete[] _gyro_data_buffer_x;
 	delete[] _gyro_data_buffer_y;
 	delete[] _gyro_data_buffer_z;
-	delete[] _hanning_window;
-	delete[] _fft_input_buffer;
-	delete[] _fft_outupt_buffer;
 	delete[] _peak_magnitudes_all;
+	delete[] _sliding_dft_output_buffer;
 }
 
 bool GyroFFT::init()
 {
-	bool buffers_allocated = false;
-
-	// arm_rfft_init_q15(&_rfft_q15, _imu_gyro_fft_len, 0, 1) manually inlined to save flash
-	_rfft_q15.pTwiddleAReal = (q15_t *) realCoefAQ15;
-	_rfft_q15.pTwiddleBReal = (q15_t *) realCoefBQ15;
-	_rfft_q15.ifftFlagR = 0;
-	_rfft_q15.bitReverseFlagR = 1;
-
-	switch (_param_imu_gyro_fft_len.get()) {
-	// case 128:
-	// 	buffers_allocated = AllocateBuffers<128>();
-	// 	_rfft_q15.fftLenReal = 128;
-	// 	_rfft_q15.twidCoefRModifier = 64U;
-	// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len64;
-	// 	break;
-
-	case 256:
-		buffers_allocated = AllocateBuffers<256>();
-		_rfft_q15.fftLenReal = 256;
-		_rfft_q15.twidCoefRModifier = 32U;
-		_rfft_q15.pCfft = &arm_cfft_sR_q15_len128;
-		break;
-
-	case 512:
-		buffers_allocated = AllocateBuffers<512>();
-		_rfft_q15.fftLenReal = 512;
-		_rfft_q15.twidCoefRModifier = 16U;
-		_rfft_q15.pCfft = &arm_cfft_sR_q15_len256;
-		break;
-
-	case 1024:
-		buffers_allocated = AllocateBuffers<1024>();
-		_rfft_q15.fftLenReal = 1024;
-		_rfft_q15.twidCoefRModifier = 8U;
-		_rfft_q15.pCfft = &arm_cfft_sR_q15_len512;
-		break;
-
-	// case 2048:
-	// 	buffers_allocated = AllocateBuffers<2048>();
-	// 	_rfft_q15.fftLenReal = 2048;
-	// 	_rfft_q15.twidCoefRModifier = 4U;
-	// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len1024;
-	// 	break;
-
-//	case 4096:
-//		buffers_allocated = AllocateBuffers<4096>();
-//		_rfft_q15.fftLenReal = 4096;
-//		_rfft_q15.twidCoefRModifier = 2U;
-//		_rfft_q15.pCfft = &arm_cfft_sR_q15_len2048;
-//		break;
-
-	// case 8192:
-	// 	buffers_allocated = AllocateBuffers<8192>();
-	// 	_rfft_q15.fftLenReal = 8192;
-	// 	_rfft_q15.twidCoefRModifier = 1U;
-	// 	_rfft_q15.pCfft = &arm_cfft_sR_q15_len4096;
-	// 	break;
-
-	default:
+	_sliding_dft = (_param_imu_gyro_fft_mod.get() == 1);
+
+	const bool length_supported = _sliding_dft ? math::RealFFT::supported(_param_imu_gyro_fft_len.get())
+				      : gyro_fft::FFTBackend::supported(_param_imu_gyro_fft_len.get());
+
+	if (!length_supported) {
 		// otherwise default to 256
 		PX4_ERR("Invalid IMU_GYRO_FFT_LEN=%" PRId32 ", resetting", _param_imu_gyro_fft_len.get());
-		buffers_allocated = AllocateBuffers<256>();
 		_param_imu_gyro_fft_len.set(256);
 		_param_imu_gyro_fft_len.commit();
-		break;
 	}
 
-	if (buffers_allocated) {
-		_imu_gyro_fft_len = _param_imu_gyro_fft_len.get();
+	_imu_gyro_fft_len = _param_imu_gyro_fft_len.get();
+
+	if (AllocateBuffers(_imu_gyro_fft_len)) {
+
+		if (_sliding_dft) {
+			if (!SlidingDFTInit()) {
+				PX4_ERR("sliding DFT init failed");
+				return false;
+			}
+
+			_sliding_dft_perf = perf_alloc(PC_ELAPSED, MODULE_NAME": sliding DFT");
+			_sliding_dft_init_failed_perf = perf_alloc(PC_COUNT, MODULE_NAME": sliding DFT init failed");
 
-		// init Hanning window
-		for (int n = 0; n < _imu_gyro_fft_len; n++) {
-			const float hanning_value = 0.5f * (1.f - cosf(2.f * M_PI_F * n / (_imu_gyro_fft_len - 1)));
-			arm_float_to_q15(&hanning_value, &_hanning_window[n], 1);
+		} else if (!_fft.init(_imu_gyro_fft_len)) {
+			PX4_ERR("%s FFT init failed", gyro_fft::FFTBackend::name());
+			return false;
 		}
 
 		if (!SensorSelectionUpdate(true)) {
@@ -154,17 +108,59 @@ bool GyroFFT::init()
 		return true;
 	}
 
+	// buffers are freed in the destructor
 	PX4_ERR("failed to allocate buffers");
-	delete[] _gyro_data_buffer_x;
-	delete[] _gyro_data_buffer_y;
-	delete[] _gyro_data_buffer_z;
-	delete[] _hanning_window;
-	delete[] _fft_input_buffer;
-	delete[] _fft_outupt_buffer;
-
 	return false;
 }
 
+bool GyroFFT::SlidingDFTInit()
+{
+	// only compute the bins covering [IMU_GYRO_FFT_MIN, IMU_GYRO_FFT_MAX], plus one on each side for the peak interpolation
+	const float resolution_hz = _gyro_sample_rate_hz / _imu_gyro_fft_len;
+	const int bin_min = math::max((int)ceilf(_param_imu_gyro_fft_min.get() / resolution_hz), 2);
+	const int bin_max = math::min((int)floorf(_param_imu_gyro_fft_max.get() / resolution_hz), _imu_gyro_fft_len / 2 - 3);
+
+	bool success = (bin_max >= bin_min);
+
+	for (auto &sliding_dft : _sliding_dft_axis) {
+		success = success && sliding_dft.init(_imu_gyro_fft_len, bin_min - 1, bin_max + 1);
+	}
+
+	if (!success) {
+		// don't keep estimating peaks with the bins of the previous sample rate
+		for (auto &sliding_dft : _sliding_dft_axis) {
+			sliding_dft.deallocate();
+		}
+
+		return false;
+	}
+
+	// estimate the peaks every 1/16 window (instead of every 1/4 window with the block FFT),
+	// staggered across the axes to spread the load evenly
+	_sliding_dft_hop = math::max(_imu_gyro_fft_len / 16, 1);
+
+	for (int axis = 0; axis < 3; axis++) {
+		_sliding_dft_hop_counter[axis] = axis * _sliding_dft_hop / 3;
+	}
+
+	_sliding_dft_sample_rate_hz = _gyro_sample_rate_hz;
+
+	return true;
+}
+
+void GyroFFT::Reset()
+{
+	_fft_buffer_index[0] = 0;
+	_fft_buffer_index[1] = 0;
+	_fft_buffer_index[2] = 0;
+
+	if (_sliding_dft) {
+		for (auto &sliding_dft : _sliding_dft_axis) {
+			sliding_dft.reset();
+		}
+	}
+}
+
 bool GyroFFT::SensorSelectionUpdate(bool force)
 {
 	if (_sensor_selection_sub.updated() || (_selected_sensor_device_id == 0) || force) {
@@ -266,7 +262,8 @@ static inline float tau(float x)
 	return (0.25f * p1 - sqrtf(6.f) / 24.f * p2);
 }
 
-float GyroFFT::EstimatePeakFrequencyBin(q15_t fft[], int peak_index)
+template<typename T>
+float GyroFFT::EstimatePeakFrequencyBin(T fft[], int peak_index)
 {
 	if (peak_index >= 2) {
 		// find peak location using Quinn's Second Estimator (2020-06-14: http://dspguru.com/dsp/howtos/how-to-interpolate-fft-peak/)
@@ -321,11 +318,23 @@ void GyroFFT::Run()
 		_parameter_update_sub.copy(&param_update);
 
 		updateParams();
+
+		// the bin range depends on IMU_GYRO_FFT_MIN/MAX, retry a failed sliding DFT init
+		_sliding_dft_init_failed = false;
 	}
 
 	const bool selection_updated = SensorSelectionUpdate();
 	VehicleIMUStatusUpdate(selection_updated);
 
+	if (_sliding_dft && !_sliding_dft_init_failed && (fabsf(_gyro_sample_rate_hz - _sliding_dft_sample_rate_hz) > 1.f)) {
+		// bin range depends on the actual sample rate, on failure not retried until the parameters change
+		if (!SlidingDFTInit()) {
+			PX4_ERR("sliding DFT init failed (%.1f Hz)", (double)_gyro_sample_rate_hz);
+			perf_count(_sliding_dft_init_failed_perf);
+			_sliding_dft_init_failed = true;
+		}
+	}
+
 	// reset
 	_fft_updated = false;
 
@@ -336,9 +345,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_fifo_sub.update(&sensor_gyro_fifo)) {
 			if (_sensor_gyro_fifo_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				Reset();
 
 				perf_count(_gyro_fifo_generation_gap_perf);
 			}
@@ -347,15 +354,19 @@ void GyroFFT::Run()
 
 			if (fabsf(sensor_gyro_fifo.scale - _fifo_last_scale) > FLT_EPSILON) {
 				// force reset if scale has changed
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				Reset();
 
 				_fifo_last_scale = sensor_gyro_fifo.scale;
 			}
 
 			int16_t *input[] {sensor_gyro_fifo.x, sensor_gyro_fifo.y, sensor_gyro_fifo.z};
-			Update(sensor_gyro_fifo.timestamp_sample, input, sensor_gyro_fifo.samples);
+
+			if (_sliding_dft) {
+				UpdateSlidingDFT(sensor_gyro_fifo.timestamp_sample, input, sensor_gyro_fifo.samples);
+
+			} else {
+				Update(sensor_gyro_fifo.timestamp_sample, input, sensor_gyro_fifo.samples);
+			}
 		}
 
 	} else {
@@ -365,9 +376,7 @@ void GyroFFT::Run()
 		while (_sensor_gyro_sub.update(&sensor_gyro)) {
 			if (_sensor_gyro_sub.get_last_generation() != _gyro_last_generation + 1) {
 				// force reset if we've missed a sample
-				_fft_buffer_index[0] = 0;
-				_fft_buffer_index[1] = 0;
-				_fft_buffer_index[2] = 0;
+				Reset();
 
 				perf_count(_gyro_generation_gap_perf);
 			}
@@ -380,7 +389,13 @@ void GyroFFT::Run()
 			int16_t gyro_z[1] {(int16_t)roundf(sensor_gyro.z * gyro_scale)};
 
 			int16_t *input[] {gyro_x, gyro_y, gyro_z};
-			Update(sensor_gyro.timestamp_sample, input, 1);
+
+			if (_sliding_dft) {
+				UpdateSlidingDFT(sensor_gyro.timestamp_sample, input, 1);
+
+			} else {
+				Update(sensor_gyro.timestamp_sample, input, 1);
+			}
 		}
 	}
 
@@ -410,12 +425,11 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 			if ((buffer_index >= _imu_gyro_fft_len) && !_fft_updated) {
 				perf_begin(_fft_perf);
 
-				arm_mult_q15(gyro_data_buffer[axis], _hanning_window, _fft_input_buffer, _imu_gyro_fft_len);
-				arm_rfft_q15(&_rfft_q15, _fft_input_buffer, _fft_outupt_buffer);
+				gyro_fft::FFTBackend::output_t *fft_outupt_buffer = _fft.transform(gyro_data_buffer[axis]);
 
 				_fft_updated = true;
 
-				FindPeaks(timestamp_sample, axis, _fft_outupt_buffer);
+				FindPeaks(timestamp_sample, axis, fft_outupt_buffer, 1, _imu_gyro_fft_len / 2 - 1);
 
 				// reset
 				// shift buffer (3/4 overlap)
@@ -429,7 +443,37 @@ void GyroFFT::Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint
 	}
 }
 
-void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer)
+void GyroFFT::UpdateSlidingDFT(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N)
+{
+	perf_begin(_sliding_dft_perf);
+
+	for (int axis = 0; axis < 3; axis++) {
+		math::SlidingDFT &sliding_dft = _sliding_dft_axis[axis];
+
+		if (sliding_dft.length() == 0) {
+			// not initialized
+			continue;
+		}
+
+		for (int n = 0; n < N; n++) {
+			sliding_dft.update(input[axis][n]);
+
+			if (sliding_dft.valid() && (++_sliding_dft_hop_counter[axis] >= _sliding_dft_hop)) {
+				_sliding_dft_hop_counter[axis] = 0;
+
+				// windowed bins [bin_first, bin_last], peaks are only searched within so neighbours are available
+				sliding_dft.windowedSpectrum(_sliding_dft_output_buffer);
+				FindPeaks(timestamp_sample, axis, _sliding_dft_output_buffer, sliding_dft.bin_first() + 1, sliding_dft.bin_last() - 1);
+			}
+		}
+	}
+
+	perf_end(_sliding_dft_perf);
+}
+
+template<typename T>
+void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, T *fft_outupt_buffer, int bin_first,
+			int bin_last)
 {
 	const float resolution_hz = _gyro_sample_rate_hz / _imu_gyro_fft_len;
 
@@ -437,15 +481,13 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 	float bin_mag_sum = 0;
 
 	// FFT output buffer is ordered [real[0], imag[0], real[1], imag[1], real[2], imag[2] ... real[(N/2)-1], imag[(N/2)-1]
-	for (uint16_t fft_index = 2; fft_index < _imu_gyro_fft_len; fft_index += 2) {
+	for (int bin_index = bin_first; bin_index <= bin_last; bin_index++) {
 
-		const float real = fft_outupt_buffer[fft_index];
-		const float imag = fft_outupt_buffer[fft_index + 1];
+		const float real = fft_outupt_buffer[2 * bin_index];
+		const float imag = fft_outupt_buffer[2 * bin_index + 1];
 
 		const float fft_magnitude = sqrtf(real * real + imag * imag);
 
-		int bin_index = fft_index / 2;
-
 		_peak_magnitudes_all[bin_index] = fft_magnitude;
 		bin_mag_sum += fft_magnitude;
 	}
@@ -460,7 +502,7 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 		float largest_peak = 0;
 		int largest_peak_index = 0;
 
-		for (int bin_index = 1; bin_index < _imu_gyro_fft_len; bin_index++) {
+		for (int bin_index = bin_first; bin_index <= bin_last; bin_index++) {
 
 			const float freq_hz = bin_index * resolution_hz;
 
@@ -509,7 +551,8 @@ void GyroFFT::FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *ff
 			if (PX4_ISFINITE(adjusted_bin)) {
 				const float freq_adjusted = resolution_hz * adjusted_bin;
 
-				const float snr = 10.f * log10f((_imu_gyro_fft_len - 1) * peak_magnitude[peak_new] /
+				// (N - 1) with the full spectrum
+				const float snr = 10.f * log10f((2 * (bin_last - bin_first + 1) + 1) * peak_magnitude[peak_new] /
 								(bin_mag_sum - peak_magnitude[peak_new]));
 
 				if (PX4_ISFINITE(freq_adjusted)
@@ -702,12 +745,15 @@ int GyroFFT::task_spawn(int argc, char *argv[])
 
 int GyroFFT::print_status()
 {
-	PX4_INFO("gyro sample rate: %.3f Hz", (double)_gyro_sample_rate_hz);
+	PX4_INFO("gyro sample rate: %.3f Hz, %s", (double)_gyro_sample_rate_hz,
+		 _sliding_dft ? "sliding DFT" : gyro_fft::FFTBackend::name());
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_cycle_interval_perf);
 	perf_print_counter(_fft_perf);
 	perf_print_counter(_gyro_generation_gap_perf);
 	perf_print_counter(_gyro_fifo_generation_gap_perf);
+	perf_print_counter(_sliding_dft_perf);
+	perf_print_counter(_sliding_dft_init_failed_perf);
 	return 0;
 }
 
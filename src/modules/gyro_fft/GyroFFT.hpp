@@ -35,6 +35,7 @@
 #define GYRO_FFT_HPP
 
 #include <lib/mathlib/math/filter/MedianFilter.hpp>
+#include <lib/mathlib/math/filter/SlidingDFT.hpp>
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
@@ -53,8 +54,7 @@
 #include <uORB/topics/sensor_selection.h>
 #include <uORB/topics/vehicle_imu_status.h>
 
-#include "arm_math.h"
-#include "arm_const_structs.h"
+#include "FFTBackend.hpp"
 
 using namespace time_literals;
 
@@ -85,31 +85,37 @@ private:
 			sensor_gyro_fft_s::peak_frequencies_x[0]);
 
 	void Run() override;
-	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, q15_t *fft_outupt_buffer);
-	inline float EstimatePeakFrequencyBin(q15_t fft[], int peak_index);
+	template<typename T>
+	inline void FindPeaks(const hrt_abstime &timestamp_sample, int axis, T *fft_outupt_buffer, int bin_first, int bin_last);
+	template<typename T>
+	inline float EstimatePeakFrequencyBin(T fft[], int peak_index);
 	inline void Publish();
+	void Reset();
 	bool SensorSelectionUpdate(bool force = false);
+	bool SlidingDFTInit();
 	void Update(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
+	void UpdateSlidingDFT(const hrt_abstime &timestamp_sample, int16_t *input[], uint8_t N);
 	inline void UpdateOutput(const hrt_abstime &timestamp_sample, int axis, float peak_frequencies[MAX_NUM_PEAKS],
 				 float peak_snr[MAX_NUM_PEAKS], int num_peaks_found);
 	void VehicleIMUStatusUpdate(bool force = false);
 
-	template<size_t N>
-	bool AllocateBuffers()
+	bool AllocateBuffers(int N)
 	{
+		_peak_magnitudes_all = new float[N];
+
+		if (_sliding_dft) {
+			// the sliding DFT keeps its own sample history, only the spectrum output is needed
+			_sliding_dft_output_buffer = new float[N] {};
+
+			return (_peak_magnitudes_all && _sliding_dft_output_buffer);
+		}
+
 		_gyro_data_buffer_x = new q15_t[N];
 		_gyro_data_buffer_y = new q15_t[N];
 		_gyro_data_buffer_z = new q15_t[N];
-		_hanning_window = new q15_t[N];
-		_fft_input_buffer = new q15_t[N];
-		_fft_outupt_buffer = new q15_t[N * 2];
-
-		_peak_magnitudes_all = new float[N];
 
 		return (_gyro_data_buffer_x && _gyro_data_buffer_y && _gyro_data_buffer_z
-			&& _hanning_window
-			&& _fft_input_buffer
-			&& _fft_outupt_buffer);
+			&& _peak_magnitudes_all);
 	}
 
 	uORB::Publication<sensor_gyro_fft_s> _sensor_gyro_fft_pub{ORB_ID(sensor_gyro_fft)};
@@ -127,22 +133,30 @@ private:
 	perf_counter_t _fft_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": FFT")};
 	perf_counter_t _gyro_generation_gap_perf{nullptr};
 	perf_counter_t _gyro_fifo_generation_gap_perf{nullptr};
+	perf_counter_t _sliding_dft_perf{nullptr};
+	perf_counter_t _sliding_dft_init_failed_perf{nullptr};
 
 	uint32_t _selected_sensor_device_id{0};
 
 	bool _gyro_fifo{false};
 
-	arm_rfft_instance_q15 _rfft_q15;
+	gyro_fft::FFTBackend _fft{};
 
 	q15_t *_gyro_data_buffer_x{nullptr};
 	q15_t *_gyro_data_buffer_y{nullptr};
 	q15_t *_gyro_data_buffer_z{nullptr};
-	q15_t *_hanning_window{nullptr};
-	q15_t *_fft_input_buffer{nullptr};
-	q15_t *_fft_outupt_buffer{nullptr};
 
 	float *_peak_magnitudes_all{nullptr};
 
+	// sliding DFT mode (IMU_GYRO_FFT_MOD), one spectrum per axis restricted to [IMU_GYRO_FFT_MIN, IMU_GYRO_FFT_MAX]
+	math::SlidingDFT _sliding_dft_axis[3] {};
+	float *_sliding_dft_output_buffer{nullptr};
+	float _sliding_dft_sample_rate_hz{0.f};
+	int _sliding_dft_hop{0};
+	int _sliding_dft_hop_counter[3] {};
+	bool _sliding_dft{false};
+	bool _sliding_dft_init_failed{false};
+
 	float _gyro_sample_rate_hz{8000}; // 8 kHz default
 
 	float _fifo_last_scale{0};
@@ -164,6 +178,7 @@ private:
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::IMU_GYRO_FFT_LEN>) _param_imu_gyro_fft_len,
+		(ParamInt<px4::params::IMU_GYRO_FFT_MOD>) _param_imu_gyro_fft_mod,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MIN>) _param_imu_gyro_fft_min,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_MAX>) _param_imu_gyro_fft_max,
 		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr
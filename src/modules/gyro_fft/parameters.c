@@ -83,3 +83,18 @@ PARAM_DEFINE_INT32(IMU_GYRO_FFT_LEN, 512);
 * @group Sensors
 */
 PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_SNR, 10.f);
+
+/**
+* IMU gyro FFT mode.
+*
+* Block FFT: a windowed FFT of IMU_GYRO_FFT_LEN samples is computed once a quarter of the window
+* has been refilled, causing load spikes and infrequent updates.
+* Sliding DFT: only the bins within [IMU_GYRO_FFT_MIN, IMU_GYRO_FFT_MAX] are updated on every gyro sample
+* and peaks are estimated every 1/16 window. The load is constant and proportional to the frequency range.
+*
+* @value 0 Block FFT
+* @value 1 Sliding DFT
+* @reboot_required true
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_FFT_MOD, 0);
@@ -495,6 +495,10 @@ bool Logger::initialize_topics()
 		sdlog_profile = SDLogProfileMask::DEFAULT;
 	}
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	_work_queue_trace = (sdlog_profile & SDLogProfileMask::WORK_QUEUE_TRACE);
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	LoggedTopics logged_topics;
 	logged_topics.set_rate_factor(_rate_factor);
 
@@ -607,6 +611,14 @@ void Logger::run()
 		max_msg_size = _event_subscription.get_topic()->o_size;
 	}
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+	if (_work_item_trace_subscription.get_topic()->o_size > max_msg_size) {
+		max_msg_size = _work_item_trace_subscription.get_topic()->o_size;
+	}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	max_msg_size += sizeof(ulog_message_data_s);
 
 	if (sizeof(ulog_message_logging_s) > (size_t)max_msg_size) {
@@ -740,6 +752,14 @@ void Logger::run()
 				}
 			}
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+			if (_work_queue_trace) {
+				handle_work_queue_trace();
+			}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 			/* wait for lock on log buffer */
 			_writer.lock();
 
@@ -1024,6 +1044,95 @@ bool Logger::handle_event_updates(uint32_t &total_bytes)
 	return data_written;
 }
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+void Logger::handle_work_queue_trace()
+{
+	// describe WorkItems started since the last call
+	if (px4::WorkQueueTraceMaxItemId() > _work_queue_trace_names_max_id) {
+		write_work_queue_trace_names(LogType::Full);
+	}
+
+	px4::wq_trace_record_t records[work_item_trace_s::MAX_RECORDS];
+
+	_writer.lock();
+	px4::WorkQueueTraceDrain(records, work_item_trace_s::MAX_RECORDS, &Logger::work_queue_trace_drain_cb, this);
+	_writer.unlock();
+}
+
+void Logger::work_queue_trace_drain_cb(const px4::wq_config_t &config, uint8_t wq_index,
+				       const px4::wq_trace_record_t *records, size_t num_records, uint32_t dropped, void *arg)
+{
+	Logger *logger = static_cast<Logger *>(arg);
+
+	work_item_trace_s trace{};
+	trace.timestamp = (num_records > 0) ? records[0].time_scheduled : hrt_absolute_time();
+
+	for (size_t i = 1; i < num_records; i++) {
+		trace.timestamp = math::min(trace.timestamp, records[i].time_scheduled);
+	}
+
+	trace.wq_index = wq_index;
+	trace.count = static_cast<uint8_t>(num_records);
+	trace.dropped = static_cast<uint16_t>(math::min(dropped, (uint32_t)UINT16_MAX));
+
+	for (size_t i = 0; i < num_records; i++) {
+		const px4::wq_trace_record_t &record = records[i];
+
+		trace.item_id[i] = record.item_id;
+		trace.schedule_offset[i] = static_cast<uint32_t>(record.time_scheduled - trace.timestamp);
+		trace.start_delay[i] = static_cast<uint16_t>(math::min(record.time_start - record.time_scheduled,
+				       (hrt_abstime)UINT16_MAX));
+		trace.run_time[i] = static_cast<uint16_t>(math::min(record.run_time, (uint32_t)UINT16_MAX));
+	}
+
+	const size_t msg_size = sizeof(ulog_message_data_s) + logger->_work_item_trace_subscription.get_topic()->o_size_no_padding;
+	const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+	const uint16_t write_msg_id = logger->_work_item_trace_subscription.msg_id;
+
+	//write one byte after another (because of alignment)
+	logger->_msg_buffer[0] = (uint8_t)write_msg_size;
+	logger->_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+	logger->_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+	logger->_msg_buffer[3] = (uint8_t)write_msg_id;
+	logger->_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+	memcpy(logger->_msg_buffer + sizeof(ulog_message_data_s), &trace, sizeof(trace));
+
+	logger->write_message(LogType::Full, logger->_msg_buffer, msg_size);
+}
+
+void Logger::write_work_queue_trace_names(LogType type)
+{
+	WorkQueueTraceNamesContext context{this, type, _work_queue_trace_names_max_id + 1, _work_queue_trace_names_max_id >= 0};
+
+	// get the max id first, items started during the iteration are described in the next call
+	_work_queue_trace_names_max_id = px4::WorkQueueTraceMaxItemId();
+
+	px4::WorkQueueTraceNames(&Logger::work_queue_trace_name_cb, &context);
+}
+
+void Logger::work_queue_trace_name_cb(const px4::wq_config_t &config, uint8_t wq_index, int item_id,
+				      const char *item_name, void *arg)
+{
+	WorkQueueTraceNamesContext *context = static_cast<WorkQueueTraceNamesContext *>(arg);
+
+	// entries: 'q <wq index> <wq name>' and 'i <item id> <wq index> <item name>'
+	char entry[64];
+
+	if (item_id < 0) {
+		snprintf(entry, sizeof(entry), "q %" PRIu8 " %s\n", wq_index, config.name);
+
+	} else if (item_id >= context->min_item_id) {
+		snprintf(entry, sizeof(entry), "i %i %" PRIu8 " %s\n", item_id, wq_index, item_name);
+
+	} else {
+		return;
+	}
+
+	context->logger->write_info_multiple(context->type, "wq_trace_names", entry, context->is_continued);
+	context->is_continued = true;
+}
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 void Logger::publish_logger_status()
 {
 	if (hrt_elapsed_time(&_logger_status_last) >= 1_s) {
@@ -1424,6 +1533,15 @@ void Logger::start_log_file(LogType type)
 		write_console_output();
 		write_events_file(LogType::Full);
 		write_excluded_optional_topics(type);
+
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+		if (_work_queue_trace) {
+			_work_queue_trace_names_max_id = -1;
+			write_work_queue_trace_names(type);
+		}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
 	}
 
 	write_all_add_logged_msg(type);
@@ -1434,6 +1552,14 @@ void Logger::start_log_file(LogType type)
 	if (type == LogType::Full) {
 		/* reset performance counters to get in-flight min and max values in post flight log */
 		perf_reset_all();
+
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+		if (_work_queue_trace) {
+			px4::WorkQueueTraceEnable(true);
+		}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
 	}
 
 	_statistics[(int)type].start_time_file = hrt_absolute_time();
@@ -1447,6 +1573,14 @@ void Logger::stop_log_file(LogType type)
 	}
 
 	if (type == LogType::Full) {
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+		if (_work_queue_trace) {
+			px4::WorkQueueTraceEnable(false);
+		}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(PrintLoadReason::Postflight);
 		_writer.set_need_reliable_transfer(false);
@@ -1793,6 +1927,14 @@ void Logger::write_formats(LogType type)
 
 	write_format(type, *_event_subscription.get_topic(), written_formats, msg, sub_count);
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+	if (_work_queue_trace && (type == LogType::Full)) {
+		write_format(type, *_work_item_trace_subscription.get_topic(), written_formats, msg, sub_count);
+	}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	_writer.unlock();
 }
 
@@ -1819,6 +1961,14 @@ void Logger::write_all_add_logged_msg(LogType type)
 
 	write_add_logged_msg(type, _event_subscription); // always add, even if not valid
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+
+	if (_work_queue_trace && (type == LogType::Full)) {
+		write_add_logged_msg(type, _work_item_trace_subscription); // never valid, drained from the work queues
+	}
+
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	_writer.unlock();
 
 	if (!added_subscriptions) {
@@ -57,6 +57,11 @@
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/parameter_update.h>
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+#include <uORB/topics/work_item_trace.h>
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 extern "C" __EXPORT int logger_main(int argc, char *argv[]);
 
 using namespace time_literals;
@@ -341,6 +346,30 @@ private:
 
 	void adjust_subscription_updates();
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	/**
+	 * Drain the work queue trace buffers and write them as work_item_trace messages
+	 */
+	void handle_work_queue_trace();
+
+	/**
+	 * Write the work queue and WorkItem names as 'wq_trace_names' info messages
+	 */
+	void write_work_queue_trace_names(LogType type);
+
+	static void work_queue_trace_drain_cb(const px4::wq_config_t &config, uint8_t wq_index,
+					      const px4::wq_trace_record_t *records, size_t num_records, uint32_t dropped, void *arg);
+	static void work_queue_trace_name_cb(const px4::wq_config_t &config, uint8_t wq_index, int item_id,
+					     const char *item_name, void *arg);
+
+	struct WorkQueueTraceNamesContext {
+		Logger *logger;
+		LogType type;
+		int min_item_id;
+		bool is_continued;
+	};
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	uint8_t						*_msg_buffer{nullptr};
 	int						_msg_buffer_len{0};
 
@@ -363,6 +392,12 @@ private:
 	uint16_t 					_event_sequence_offset{0}; ///< event sequence offset to account for skipped (not logged) messages
 	uint16_t 					_event_sequence_offset_mission{0};
 
+#if defined(CONFIG_WORK_QUEUE_TRACE)
+	LoggerSubscription				_work_item_trace_subscription{ORB_ID::work_item_trace}; ///< not published, drained from the work queues
+	bool						_work_queue_trace{false}; ///< enabled by the logging profile
+	int						_work_queue_trace_names_max_id{-1}; ///< highest item id written to 'wq_trace_names'
+#endif // CONFIG_WORK_QUEUE_TRACE
+
 	uint8_t						_excluded_optional_topic_ids[LoggedTopics::MAX_EXCLUDED_OPTIONAL_TOPICS_NUM];
 	int						_num_excluded_optional_topic_ids{0};
 
@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "triplet_geometry.h"
+
+#include <lib/geo/geo.h>
+#include <px4_platform_common/defines.h>
+
+using namespace matrix;
+
+// to run: make tests TESTFILTER=TripletGeometry
+
+class TripletGeometryTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_local_pos.ref_timestamp = 1234567;
+		_local_pos.ref_lat = 47.397742;
+		_local_pos.ref_lon = 8.545594;
+		_local_pos.ref_alt = 488.f;
+		_local_pos.xy_global = true;
+		_local_pos.z_global = true;
+
+		_triplet.timestamp = 7654321;
+		setSetpoint(_triplet.previous, 47.398, 8.546);
+		setSetpoint(_triplet.current, 47.4032, 8.5521);
+		setSetpoint(_triplet.next, 47.712, 8.311);
+	}
+
+	static void setSetpoint(position_setpoint_s &sp, double lat, double lon)
+	{
+		sp.valid = true;
+		sp.lat = lat;
+		sp.lon = lon;
+		sp.alt = 520.f;
+	}
+
+	// fallback of FlightTaskAuto::_projectToLocalFrame()
+	Vector2f projectFlightTaskAuto(const position_setpoint_s &sp) const
+	{
+		MapProjection reference_position;
+		reference_position.initReference(_local_pos.ref_lat, _local_pos.ref_lon);
+		Vector2f local;
+		reference_position.project(sp.lat, sp.lon, local(0), local(1));
+		return local;
+	}
+
+	// fallback of FixedwingPositionControl::getLocalSetpointPosition()
+	Vector2f projectFixedwing(const position_setpoint_s &sp) const
+	{
+		MapProjection global_local_proj_ref;
+		global_local_proj_ref.initReference(_local_pos.ref_lat, _local_pos.ref_lon, _local_pos.ref_timestamp);
+		return global_local_proj_ref.project(sp.lat, sp.lon);
+	}
+
+	position_setpoint_triplet_s _triplet{};
+	vehicle_local_position_s _local_pos{};
+};
+
+TEST_F(TripletGeometryTest, matchesControllerProjection)
+{
+	// WHEN: navigator computes the geometry of a valid triplet
+	position_setpoint_triplet_geometry_s geometry{};
+	computeTripletGeometry(_triplet, _local_pos, geometry);
+
+	// THEN: it is identified by the triplet and the local frame reference
+	EXPECT_EQ(geometry.triplet_timestamp, _triplet.timestamp);
+	EXPECT_EQ(geometry.ref_timestamp, _local_pos.ref_timestamp);
+
+	// AND: the local setpoints match the projection of the position controllers
+	const position_setpoint_s *setpoints[3] {&_triplet.previous, &_triplet.current, &_triplet.next};
+	const float *local[3] {geometry.previous, geometry.current, geometry.next};
+
+	for (int i = 0; i < 3; i++) {
+		const Vector2f flight_task_auto = projectFlightTaskAuto(*setpoints[i]);
+		const Vector2f fixedwing = projectFixedwing(*setpoints[i]);
+
+		EXPECT_FLOAT_EQ(local[i][0], flight_task_auto(0));
+		EXPECT_FLOAT_EQ(local[i][1], flight_task_auto(1));
+		EXPECT_FLOAT_EQ(local[i][0], fixedwing(0));
+		EXPECT_FLOAT_EQ(local[i][1], fixedwing(1));
+	}
+
+	// AND: the segment length matches the altitude first order hold of the fixed wing controller
+	const float d_curr_prev = get_distance_to_next_waypoint(_triplet.current.lat, _triplet.current.lon,
+				  _triplet.previous.lat, _triplet.previous.lon);
+	EXPECT_FLOAT_EQ(geometry.previous_current_distance, d_curr_prev);
+}
+
+TEST_F(TripletGeometryTest, invalidSetpoint)
+{
+	// GIVEN: a triplet without next setpoint
+	_triplet.next.valid = false;
+
+	// WHEN: navigator computes the geometry
+	position_setpoint_triplet_geometry_s geometry{};
+	computeTripletGeometry(_triplet, _local_pos, geometry);
+
+	// THEN: the next setpoint is not available, the controllers don't use it
+	EXPECT_TRUE(PX4_ISFINITE(geometry.current[0]));
+	EXPECT_FALSE(PX4_ISFINITE(geometry.next[0]));
+	EXPECT_FALSE(PX4_ISFINITE(geometry.next[1]));
+	EXPECT_TRUE(PX4_ISFINITE(geometry.previous_current_distance));
+
+	// WHEN: there is no previous setpoint either
+	_triplet.previous.valid = false;
+	computeTripletGeometry(_triplet, _local_pos, geometry);
+
+	// THEN: the segment length is not available
+	EXPECT_FALSE(PX4_ISFINITE(geometry.previous[0]));
+	EXPECT_FALSE(PX4_ISFINITE(geometry.previous_current_distance));
+}
+
+TEST_F(TripletGeometryTest, noGlobalReference)
+{
+	// GIVEN: a local frame without global reference
+	_local_pos.xy_global = false;
+
+	// WHEN: navigator computes the geometry
+	position_setpoint_triplet_geometry_s geometry{};
+	computeTripletGeometry(_triplet, _local_pos, geometry);
+
+	// THEN: no local setpoint is available and the controllers fall back to their own projection
+	EXPECT_FALSE(PX4_ISFINITE(geometry.previous[0]));
+	EXPECT_FALSE(PX4_ISFINITE(geometry.current[0]));
+	EXPECT_FALSE(PX4_ISFINITE(geometry.next[0]));
+
+	// AND: the segment length doesn't depend on the local frame
+	EXPECT_TRUE(PX4_ISFINITE(geometry.previous_current_distance));
+}
@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "triplet_geometry.h"
+
+#include <lib/geo/geo.h>
+#include <px4_platform_common/defines.h>
+
+void computeTripletGeometry(const position_setpoint_triplet_s &triplet, const vehicle_local_position_s &local_pos,
+			    position_setpoint_triplet_geometry_s &geometry)
+{
+	geometry.triplet_timestamp = triplet.timestamp;
+	geometry.ref_timestamp = local_pos.ref_timestamp;
+
+	// same local frame reference as the position controllers
+	MapProjection ref_pos;
+
+	if (local_pos.xy_global) {
+		ref_pos.initReference(local_pos.ref_lat, local_pos.ref_lon, local_pos.ref_timestamp);
+	}
+
+	const position_setpoint_s *setpoints[3] {&triplet.previous, &triplet.current, &triplet.next};
+	float *local[3] {geometry.previous, geometry.current, geometry.next};
+	bool horizontal_valid[3];
+
+	for (int i = 0; i < 3; i++) {
+		const position_setpoint_s &sp = *setpoints[i];
+		horizontal_valid[i] = sp.valid && PX4_ISFINITE(sp.lat) && PX4_ISFINITE(sp.lon);
+
+		if (horizontal_valid[i] && ref_pos.isInitialized()) {
+			ref_pos.project(sp.lat, sp.lon, local[i][0], local[i][1]);
+
+		} else {
+			local[i][0] = NAN;
+			local[i][1] = NAN;
+		}
+	}
+
+	if (horizontal_valid[0] && horizontal_valid[1]) {
+		geometry.previous_current_distance = get_distance_to_next_waypoint(triplet.previous.lat, triplet.previous.lon,
+						     triplet.current.lat, triplet.current.lon);
+
+	} else {
+		geometry.previous_current_distance = NAN;
+	}
+}
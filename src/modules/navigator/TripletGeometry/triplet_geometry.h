@@ -0,0 +1,57 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file triplet_geometry.h
+ * Local frame geometry of the position setpoint triplet, published by navigator
+ * for the position controllers.
+ */
+
+#pragma once
+
+#include <uORB/topics/position_setpoint_triplet.h>
+#include <uORB/topics/position_setpoint_triplet_geometry.h>
+#include <uORB/topics/vehicle_local_position.h>
+
+/**
+ * Compute the local frame geometry of a position setpoint triplet
+ *
+ * The setpoints are projected with the same local frame reference as the position controllers use,
+ * such that they match the projection of the global setpoints done in the controllers.
+ *
+ * @param triplet Position setpoint triplet, its timestamp identifies the geometry
+ * @param local_pos Local position providing the local frame reference
+ * @param geometry Resulting geometry, all fields except timestamp are set
+ */
+void computeTripletGeometry(const position_setpoint_triplet_s &triplet, const vehicle_local_position_s &local_pos,
+			    position_setpoint_triplet_geometry_s &geometry);
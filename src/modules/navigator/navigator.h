@@ -54,6 +54,7 @@
 #include "navigation.h"
 
 #include "GeofenceBreachAvoidance/geofence_breach_avoidance.h"
+#include "TripletGeometry/triplet_geometry.h"
 
 #include <lib/adsb/AdsbConflict.h>
 #include <lib/perf/perf_counter.h>
@@ -70,6 +71,7 @@
 #include <uORB/topics/position_controller_landing_status.h>
 #include <uORB/topics/position_controller_status.h>
 #include <uORB/topics/position_setpoint_triplet.h>
+#include <uORB/topics/position_setpoint_triplet_geometry.h>
 #include <uORB/topics/transponder_report.h>
 #include <uORB/topics/vehicle_command.h>
 #include <uORB/topics/vehicle_command_ack.h>
@@ -328,6 +330,7 @@ private:
 	uORB::Publication<geofence_result_s>		_geofence_result_pub{ORB_ID(geofence_result)};
 	uORB::Publication<mission_result_s>		_mission_result_pub{ORB_ID(mission_result)};
 	uORB::Publication<position_setpoint_triplet_s>	_pos_sp_triplet_pub{ORB_ID(position_setpoint_triplet)};
+	uORB::Publication<position_setpoint_triplet_geometry_s>	_pos_sp_triplet_geometry_pub{ORB_ID(position_setpoint_triplet_geometry)};
 	uORB::Publication<vehicle_command_ack_s>	_vehicle_cmd_ack_pub{ORB_ID(vehicle_command_ack)};
 	uORB::Publication<vehicle_command_s>		_vehicle_cmd_pub{ORB_ID(vehicle_command)};
 	uORB::Publication<vehicle_roi_s>		_vehicle_roi_pub{ORB_ID(vehicle_roi)};
@@ -362,6 +365,7 @@ private:
 	bool		_geofence_violation_warning_sent{false};	/**< prevents spaming to mavlink */
 	bool		_can_loiter_at_sp{false};			/**< flags if current position SP can be used to loiter */
 	bool		_pos_sp_triplet_updated{false};			/**< flags if position SP triplet needs to be published */
+	uint64_t	_pos_sp_triplet_geometry_ref_timestamp{0};	/**< local frame reference of the last published triplet geometry */
 	bool 		_pos_sp_triplet_published_invalid_once{false};	/**< flags if position SP triplet has been published once to UORB */
 	bool		_mission_result_updated{false};			/**< flags if mission result has seen an update */
 
@@ -404,6 +408,11 @@ private:
 	 */
 	void publish_position_setpoint_triplet();
 
+	/**
+	 * Publish the local frame geometry of the current position setpoint triplet
+	 */
+	void publish_position_setpoint_triplet_geometry();
+
 	/**
 	 * Publish the mission result so commander and mavlink know what is going on
 	 */
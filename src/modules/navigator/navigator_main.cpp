@@ -882,6 +882,10 @@ void Navigator::run()
 
 		if (_pos_sp_triplet_updated) {
 			publish_position_setpoint_triplet();
+
+		} else if ((_pos_sp_triplet.timestamp != 0) && (_local_pos.ref_timestamp != _pos_sp_triplet_geometry_ref_timestamp)) {
+			// the local frame reference changed, the local geometry of the triplet needs to be updated
+			publish_position_setpoint_triplet_geometry();
 		}
 
 		if (_mission_result_updated) {
@@ -1078,6 +1082,18 @@ void Navigator::publish_position_setpoint_triplet()
 	_pos_sp_triplet.timestamp = hrt_absolute_time();
 	_pos_sp_triplet_pub.publish(_pos_sp_triplet);
 	_pos_sp_triplet_updated = false;
+
+	publish_position_setpoint_triplet_geometry();
+}
+
+void Navigator::publish_position_setpoint_triplet_geometry()
+{
+	position_setpoint_triplet_geometry_s geometry{};
+	computeTripletGeometry(_pos_sp_triplet, _local_pos, geometry);
+	geometry.timestamp = hrt_absolute_time();
+	_pos_sp_triplet_geometry_pub.publish(geometry);
+
+	_pos_sp_triplet_geometry_ref_timestamp = _local_pos.ref_timestamp;
 }
 
 float Navigator::get_default_acceptance_radius()
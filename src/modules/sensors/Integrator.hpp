@@ -75,6 +75,47 @@ public:
 		}
 	}
 
+	/**
+	 * Put a block of equally spaced raw samples (e.g. a sensor FIFO transfer) into the integral.
+	 *
+	 * The block counts as a single sample towards the reset samples requirement, so reset boundaries
+	 * (see integral_ready()) always fall between blocks and stay aligned with the sensor messages.
+	 *
+	 * @param samples	x, y, z raw sample arrays
+	 * @param scale		raw sample scale
+	 * @param N		number of samples
+	 * @param dt		time covered by the whole block
+	 */
+	inline void put(const int16_t *samples[3], const float scale, const uint8_t N, const float dt)
+	{
+		if ((N > 0) && (dt > DT_MIN) && (_integral_dt + dt < DT_MAX)) {
+			_integrated_samples++;
+			_integral_dt += dt;
+
+			// trapezoidal integration (equally spaced)
+			const float dt_scale = (dt / N) * scale;
+
+			for (int axis = 0; axis < 3; axis++) {
+				int32_t sum = 0;
+
+				for (int n = 0; n < N - 1; n++) {
+					sum += samples[axis][n];
+				}
+
+				const float last = samples[axis][N - 1] * scale;
+				_alpha(axis) += 0.5f * (dt / N) * (_last_val(axis) + last) + sum * dt_scale;
+				_last_val(axis) = last;
+			}
+
+		} else {
+			reset();
+
+			if (N > 0) {
+				_last_val = matrix::Vector3f{samples[0][N - 1] * scale, samples[1][N - 1] * scale, samples[2][N - 1] * scale};
+			}
+		}
+	}
+
 	/**
 	 * Set reset interval during runtime. This won't reset the integrator.
 	 *
@@ -186,6 +227,77 @@ public:
 		}
 	}
 
+	/**
+	 * Put a block of equally spaced raw samples (e.g. a sensor FIFO transfer) into the integral,
+	 * computing the coning corrections at the raw sample rate.
+	 *
+	 * The block counts as a single sample towards the reset samples requirement, so reset boundaries
+	 * (see integral_ready()) always fall between blocks and stay aligned with the sensor messages.
+	 *
+	 * @param samples	x, y, z raw sample arrays
+	 * @param scale		raw sample scale
+	 * @param N		number of samples
+	 * @param dt		time covered by the whole block
+	 */
+	inline void put(const int16_t *samples[3], const float scale, const uint8_t N, const float dt)
+	{
+		if ((N > 0) && (dt > DT_MIN) && (_integral_dt + dt < DT_MAX)) {
+			_integrated_samples++;
+			_integral_dt += dt;
+
+			const float half_dt = 0.5f * (dt / N);
+
+			// same recursion as put(val, dt) per sample, state kept in scalars
+			float last_val[3] {_last_val(0), _last_val(1), _last_val(2)};
+			float alpha[3] {_alpha(0), _alpha(1), _alpha(2)};
+			float last_alpha[3] {_last_alpha(0), _last_alpha(1), _last_alpha(2)};
+			float last_delta_alpha[3] {_last_delta_alpha(0), _last_delta_alpha(1), _last_delta_alpha(2)};
+			float beta[3] {_beta(0), _beta(1), _beta(2)};
+
+			for (int n = 0; n < N; n++) {
+				const float val[3] {samples[0][n] *scale, samples[1][n] *scale, samples[2][n] *scale};
+
+				// trapezoidal integration
+				const float delta_alpha[3] {
+					(val[0] + last_val[0]) *half_dt,
+					(val[1] + last_val[1]) *half_dt,
+					(val[2] + last_val[2]) *half_dt,
+				};
+
+				// coning corrections: beta += ((last_alpha + last_delta_alpha / 6) x delta_alpha) / 2
+				const float c[3] {
+					last_alpha[0] + last_delta_alpha[0] * (1.f / 6.f),
+					last_alpha[1] + last_delta_alpha[1] * (1.f / 6.f),
+					last_alpha[2] + last_delta_alpha[2] * (1.f / 6.f),
+				};
+
+				beta[0] += (c[1] * delta_alpha[2] - c[2] * delta_alpha[1]) * 0.5f;
+				beta[1] += (c[2] * delta_alpha[0] - c[0] * delta_alpha[2]) * 0.5f;
+				beta[2] += (c[0] * delta_alpha[1] - c[1] * delta_alpha[0]) * 0.5f;
+
+				for (int axis = 0; axis < 3; axis++) {
+					last_delta_alpha[axis] = delta_alpha[axis];
+					last_alpha[axis] = alpha[axis];
+					alpha[axis] += delta_alpha[axis];
+					last_val[axis] = val[axis];
+				}
+			}
+
+			_last_val = matrix::Vector3f{last_val};
+			_alpha = matrix::Vector3f{alpha};
+			_last_alpha = matrix::Vector3f{last_alpha};
+			_last_delta_alpha = matrix::Vector3f{last_delta_alpha};
+			_beta = matrix::Vector3f{beta};
+
+		} else {
+			reset();
+
+			if (N > 0) {
+				_last_val = matrix::Vector3f{samples[0][N - 1] * scale, samples[1][N - 1] * scale, samples[2][N - 1] * scale};
+			}
+		}
+	}
+
 	void reset()
 	{
 		Integrator::reset();
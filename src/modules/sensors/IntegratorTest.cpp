@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "Integrator.hpp"
+
+using namespace sensors;
+using matrix::Vector3f;
+
+static constexpr int N = 16;        // FIFO samples per message
+static constexpr float SCALE = 1e-3f;
+static constexpr float DT = 125e-6f; // 8 kHz
+
+static void fifo(int message, int16_t x[N], int16_t y[N], int16_t z[N])
+{
+	for (int n = 0; n < N; n++) {
+		const float t = (message * N + n) * DT;
+		x[n] = 3000.f * sinf(2.f * (float)M_PI * 13.f * t);
+		y[n] = 3000.f * cosf(2.f * (float)M_PI * 13.f * t);
+		z[n] = 500.f + 100.f * sinf(2.f * (float)M_PI * 40.f * t);
+	}
+}
+
+TEST(IntegratorTest, blockMatchesSamples)
+{
+	Integrator integrator_samples;
+	Integrator integrator_block;
+
+	integrator_samples.set_reset_samples(N * 4);
+	integrator_samples.set_reset_interval(1000000);
+	integrator_block.set_reset_samples(4);
+	integrator_block.set_reset_interval(1000000);
+
+	for (int message = 0; message < 4; message++) {
+		int16_t x[N], y[N], z[N];
+		fifo(message, x, y, z);
+
+		for (int n = 0; n < N; n++) {
+			integrator_samples.put(Vector3f{x[n] * SCALE, y[n] * SCALE, z[n] * SCALE}, DT);
+		}
+
+		const int16_t *samples[3] {x, y, z};
+		integrator_block.put(samples, SCALE, N, N * DT);
+
+		// reset boundary only reached after complete blocks
+		EXPECT_EQ(integrator_block.integral_ready(), message == 3);
+	}
+
+	Vector3f integral_samples;
+	Vector3f integral_block;
+	uint16_t dt_samples = 0;
+	uint16_t dt_block = 0;
+	EXPECT_TRUE(integrator_samples.reset(integral_samples, dt_samples));
+	EXPECT_TRUE(integrator_block.reset(integral_block, dt_block));
+
+	EXPECT_EQ(dt_samples, dt_block);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(integral_samples(i), integral_block(i), 1e-6f);
+	}
+}
+
+TEST(IntegratorTest, coningBlockMatchesSamples)
+{
+	IntegratorConing integrator_samples;
+	IntegratorConing integrator_block;
+
+	integrator_samples.set_reset_samples(N * 2);
+	integrator_samples.set_reset_interval(1000000);
+	integrator_block.set_reset_samples(2);
+	integrator_block.set_reset_interval(1000000);
+
+	for (int interval = 0; interval < 3; interval++) {
+		for (int message = 0; message < 2; message++) {
+			int16_t x[N], y[N], z[N];
+			fifo(interval * 2 + message, x, y, z);
+
+			for (int n = 0; n < N; n++) {
+				integrator_samples.put(Vector3f{x[n] * SCALE, y[n] * SCALE, z[n] * SCALE}, DT);
+			}
+
+			const int16_t *samples[3] {x, y, z};
+			integrator_block.put(samples, SCALE, N, N * DT);
+		}
+
+		const Vector3f coning_samples = integrator_samples.accumulated_coning_corrections();
+		const Vector3f coning_block = integrator_block.accumulated_coning_corrections();
+
+		Vector3f integral_samples;
+		Vector3f integral_block;
+		uint16_t dt_samples = 0;
+		uint16_t dt_block = 0;
+		ASSERT_TRUE(integrator_samples.reset(integral_samples, dt_samples));
+		ASSERT_TRUE(integrator_block.reset(integral_block, dt_block));
+
+		EXPECT_EQ(dt_samples, dt_block);
+
+		for (int i = 0; i < 3; i++) {
+			EXPECT_FLOAT_EQ(coning_samples(i), coning_block(i));
+			EXPECT_FLOAT_EQ(integral_samples(i), integral_block(i));
+		}
+
+		// the coning correction must be non-trivial for the rotating input
+		EXPECT_GT(coning_block.norm(), 0.f);
+	}
+}
+
+TEST(IntegratorTest, invalidBlock)
+{
+	IntegratorConing integrator;
+
+	int16_t x[N] {}, y[N] {}, z[N] {};
+	x[N - 1] = 1000;
+	const int16_t *samples[3] {x, y, z};
+
+	// dt too large: integrator reset, last sample kept for the next interval
+	integrator.put(samples, SCALE, N, 1.f);
+	EXPECT_FLOAT_EQ(integrator.integral_dt(), 0.f);
+
+	integrator.put(samples, SCALE, N, N * DT);
+	EXPECT_FLOAT_EQ(integrator.integral_dt(), N * DT);
+}
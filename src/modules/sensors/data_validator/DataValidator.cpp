@@ -64,6 +64,10 @@ void DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_
 	_error_count = error_count_in;
 	_priority = priority_in;
 
+	// the divisions are shared by all axes
+	const float event_count_inv = 1.f / _event_count;
+	const float rms_count_inv = (_event_count > 1) ? 1.f / (_event_count - 1) : 0.f;
+
 	for (unsigned i = 0; i < dimensions; i++) {
 		if (PX4_ISFINITE(val[i])) {
 			if (_time_last == 0) {
@@ -75,9 +79,9 @@ void DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_
 				float lp_val = val[i] - _lp[i];
 
 				float delta_val = lp_val - _mean[i];
-				_mean[i] += delta_val / _event_count;
+				_mean[i] += delta_val * event_count_inv;
 				_M2[i] += delta_val * (lp_val - _mean[i]);
-				_rms[i] = sqrtf(_M2[i] / (_event_count - 1));
+				_rms[i] = sqrtf(_M2[i] * rms_count_inv);
 
 				if (fabsf(_value[i] - val[i]) < 0.000001f) {
 					_value_equal_count++;
@@ -324,6 +324,24 @@ uint32_t DataValidatorGroup::get_sensor_state(unsigned index)
 	return UINT32_MAX;
 }
 
+float DataValidatorGroup::get_sensor_confidence(unsigned index, uint64_t timestamp)
+{
+	DataValidator *next = _first;
+	unsigned i = 0;
+
+	while (next != nullptr) {
+		if (i == index) {
+			return next->confidence(timestamp);
+		}
+
+		next = next->sibling();
+		i++;
+	}
+
+	// sensor index not found
+	return 0.0f;
+}
+
 uint8_t DataValidatorGroup::get_sensor_priority(unsigned index)
 {
 	DataValidator *next = _first;
@@ -104,6 +104,13 @@ public:
 	 */
 	uint32_t get_sensor_state(unsigned index);
 
+	/**
+	 * Get the confidence of the sensor with the specified index
+	 *
+	 * @return		the confidence between 0 and 1, 0 if the sensor index is not found
+	 */
+	float get_sensor_confidence(unsigned index, uint64_t timestamp);
+
 	/**
 	 * Get the priority of the sensor with the specified index
 	 *
@@ -222,6 +222,23 @@ PARAM_DEFINE_INT32(SENS_EXT_I2C_PRB, 1);
  */
 PARAM_DEFINE_INT32(SENS_IMU_MODE, 1);
 
+/**
+ * Sensors hub IMU voting decimation
+ *
+ * With multiple IMUs all of them are monitored at the full rate, the sensor
+ * selection and the inconsistency checks are only updated every SENS_IMU_VDEC
+ * IMU updates. A single IMU is only monitored every SENS_IMU_VDEC IMU updates
+ * and passed through without voting in between.
+ * Full rate voting is used for 1 second after any anomaly of the primary IMU
+ * was detected. The default of 1 always votes at the full rate.
+ *
+ * @min 1
+ * @max 8
+ * @category system
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(SENS_IMU_VDEC, 1);
+
 /**
  * Enable internal barometers
  *
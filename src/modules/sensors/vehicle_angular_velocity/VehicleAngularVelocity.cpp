@@ -56,6 +56,7 @@ VehicleAngularVelocity::~VehicleAngularVelocity()
 	perf_free(_cycle_perf);
 	perf_free(_filter_reset_perf);
 	perf_free(_selection_changed_perf);
+	perf_free(_filter_cascade_full_perf);
 
 #if !defined(CONSTRAINED_FLASH)
 	delete[] _dynamic_notch_filter_esc_rpm;
@@ -161,6 +162,18 @@ bool VehicleAngularVelocity::UpdateSampleRate()
 
 void VehicleAngularVelocity::ResetFilters(const hrt_abstime &time_now_us)
 {
+	// notch filters 0 & 1 and low-pass
+	int filter_stages_max = 3;
+
+#if !defined(CONSTRAINED_FLASH)
+	filter_stages_max += MAX_NUM_FFT_PEAKS + _esc_rpm_harmonics * MAX_NUM_ESCS;
+#endif // !CONSTRAINED_FLASH
+
+	if (!_filter_cascade.allocate(filter_stages_max)) {
+		// the filters are still reset below and applied individually
+		PX4_ERR("failed to allocate %d filter stages", filter_stages_max);
+	}
+
 	if ((_filter_sample_rate_hz > 0) && PX4_ISFINITE(_filter_sample_rate_hz)) {
 
 		const Vector3f angular_velocity_uncalibrated{GetResetAngularVelocity()};
@@ -453,6 +466,9 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 				if (_dynamic_notch_filter_esc_rpm) {
 					_esc_rpm_harmonics = esc_rpm_harmonics;
 
+					// resize filter cascade
+					_reset_filters = true;
+
 					if (_dynamic_notch_filter_esc_rpm_disable_perf == nullptr) {
 						_dynamic_notch_filter_esc_rpm_disable_perf = perf_alloc(PC_COUNT,
 								MODULE_NAME": gyro dynamic notch filter ESC RPM disable");
@@ -722,49 +738,113 @@ void VehicleAngularVelocity::UpdateDynamicNotchFFT(const hrt_abstime &time_now_u
 #endif // !CONSTRAINED_FLASH
 }
 
-float VehicleAngularVelocity::FilterAngularVelocity(int axis, float data[], int N)
+void VehicleAngularVelocity::FlushFilterCascade(float *data[3], int N)
+{
+	// apply the stages gathered so far before a filter outside of the cascade, keeping the filter order
+	if (_filter_cascade.numStages() > 0) {
+		_filter_cascade.apply(data, N);
+		_filter_cascade.store();
+		_filter_cascade.clear();
+	}
+}
+
+void VehicleAngularVelocity::AddFilterStage(math::NotchFilter<float> *filter[3], float *data[3], int N)
+{
+	if (!_filter_cascade.addStage(filter)) {
+		// cascade full or not allocated (see ResetFilters()), apply the filter directly
+		perf_count(_filter_cascade_full_perf);
+		FlushFilterCascade(data, N);
+
+		for (int axis = 0; axis < 3; axis++) {
+			if (filter[axis]) {
+				filter[axis]->applyArray(data[axis], N);
+			}
+		}
+	}
+}
+
+void VehicleAngularVelocity::AddFilterStage(math::LowPassFilter2p<float> filter[3], float *data[3], int N)
+{
+	if (!_filter_cascade.addStage(filter)) {
+		// cascade full or not allocated (see ResetFilters()), apply the filter directly
+		perf_count(_filter_cascade_full_perf);
+		FlushFilterCascade(data, N);
+
+		for (int axis = 0; axis < 3; axis++) {
+			filter[axis].applyArray(data[axis], N);
+		}
+	}
+}
+
+void VehicleAngularVelocity::FilterAngularVelocity(float *data[3], int N)
 {
+	// gather all active filter stages (same order as applied individually), then filter all axes in one pass
+	_filter_cascade.clear();
+
+	math::NotchFilter<float> *nf[3];
+
 #if !defined(CONSTRAINED_FLASH)
 
-	// Apply dynamic notch filter from ESC RPM
+	// dynamic notch filter from ESC RPM
 	if (_dynamic_notch_filter_esc_rpm) {
 		for (int esc = 0; esc < MAX_NUM_ESCS; esc++) {
 			if (_esc_available[esc]) {
 				for (int harmonic = 0; harmonic < _esc_rpm_harmonics; harmonic++) {
-					if (_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].getNotchFreq() > 0.f) {
-						_dynamic_notch_filter_esc_rpm[harmonic][axis][esc].applyArray(data, N);
+					bool active = false;
+
+					for (int axis = 0; axis < 3; axis++) {
+						auto &notch = _dynamic_notch_filter_esc_rpm[harmonic][axis][esc];
+						nf[axis] = (notch.getNotchFreq() > 0.f) ? &notch : nullptr;
+						active |= (nf[axis] != nullptr);
+					}
+
+					if (active) {
+						AddFilterStage(nf, data, N);
 					}
 				}
 			}
 		}
 	}
 
-	// Apply dynamic notch filter from FFT
+	// dynamic notch filter from FFT
 	if (_dynamic_notch_fft_available) {
 		for (int peak = MAX_NUM_FFT_PEAKS - 1; peak >= 0; peak--) {
-			if (_dynamic_notch_filter_fft[axis][peak].getNotchFreq() > 0.f) {
-				_dynamic_notch_filter_fft[axis][peak].applyArray(data, N);
+			bool active = false;
+
+			for (int axis = 0; axis < 3; axis++) {
+				auto &notch = _dynamic_notch_filter_fft[axis][peak];
+				nf[axis] = (notch.getNotchFreq() > 0.f) ? &notch : nullptr;
+				active |= (nf[axis] != nullptr);
+			}
+
+			if (active) {
+				AddFilterStage(nf, data, N);
 			}
 		}
 	}
 
 #endif // !CONSTRAINED_FLASH
 
-	// Apply general notch filter 0 (IMU_GYRO_NF0_FRQ)
-	if (_notch_filter0_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter0_velocity[axis].applyArray(data, N);
-	}
+	// general notch filter 0 (IMU_GYRO_NF0_FRQ) and 1 (IMU_GYRO_NF1_FRQ)
+	math::NotchFilter<float> *notch_filters[] {_notch_filter0_velocity, _notch_filter1_velocity};
+
+	for (auto notch_filter : notch_filters) {
+		bool active = false;
+
+		for (int axis = 0; axis < 3; axis++) {
+			nf[axis] = (notch_filter[axis].getNotchFreq() > 0.f) ? &notch_filter[axis] : nullptr;
+			active |= (nf[axis] != nullptr);
+		}
 
-	// Apply general notch filter 1 (IMU_GYRO_NF1_FRQ)
-	if (_notch_filter1_velocity[axis].getNotchFreq() > 0.f) {
-		_notch_filter1_velocity[axis].applyArray(data, N);
+		if (active) {
+			AddFilterStage(nf, data, N);
+		}
 	}
 
-	// Apply general low-pass filter (IMU_GYRO_CUTOFF)
-	_lp_filter_velocity[axis].applyArray(data, N);
+	// general low-pass filter (IMU_GYRO_CUTOFF)
+	AddFilterStage(_lp_filter_velocity, data, N);
 
-	// return last filtered sample
-	return data[N - 1];
+	FlushFilterCascade(data, N);
 }
 
 float VehicleAngularVelocity::FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N)
@@ -833,18 +913,22 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_acceleration_uncalibrated;
 
 				int16_t *raw_data_array[] {sensor_fifo_data.x, sensor_fifo_data.y, sensor_fifo_data.z};
+				float data[3][FIFO_SIZE_MAX];
 
 				for (int axis = 0; axis < 3; axis++) {
 					// copy raw int16 sensor samples to float array for filtering
-					float data[FIFO_SIZE_MAX];
-
 					for (int n = 0; n < N; n++) {
-						data[n] = sensor_fifo_data.scale * raw_data_array[axis][n];
+						data[axis][n] = sensor_fifo_data.scale * raw_data_array[axis][n];
 					}
+				}
+
+				float *data_array[] {data[0], data[1], data[2]};
+				FilterAngularVelocity(data_array, N);
 
+				for (int axis = 0; axis < 3; axis++) {
 					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data, N);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data, N);
+					angular_velocity_uncalibrated(axis) = data[axis][N - 1];
+					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data[axis], N);
 				}
 
 				// Publish
@@ -878,15 +962,16 @@ void VehicleAngularVelocity::Run()
 				Vector3f angular_velocity_uncalibrated;
 				Vector3f angular_acceleration_uncalibrated;
 
-				float raw_data_array[] {sensor_data.x, sensor_data.y, sensor_data.z};
+				// copy sensor sample to float array for filtering
+				float data[3][1] {{sensor_data.x}, {sensor_data.y}, {sensor_data.z}};
 
-				for (int axis = 0; axis < 3; axis++) {
-					// copy sensor sample to float array for filtering
-					float data[1] {raw_data_array[axis]};
+				float *data_array[] {data[0], data[1], data[2]};
+				FilterAngularVelocity(data_array);
 
+				for (int axis = 0; axis < 3; axis++) {
 					// save last filtered sample
-					angular_velocity_uncalibrated(axis) = FilterAngularVelocity(axis, data);
-					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data);
+					angular_velocity_uncalibrated(axis) = data[axis][0];
+					angular_acceleration_uncalibrated(axis) = FilterAngularAcceleration(axis, inverse_dt_s, data[axis]);
 				}
 
 				// Publish
@@ -954,6 +1039,7 @@ void VehicleAngularVelocity::PrintStatus()
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_filter_reset_perf);
 	perf_print_counter(_selection_changed_perf);
+	perf_print_counter(_filter_cascade_full_perf);
 #if !defined(CONSTRAINED_FLASH)
 	perf_print_counter(_dynamic_notch_filter_esc_rpm_disable_perf);
 	perf_print_counter(_dynamic_notch_filter_esc_rpm_init_perf);
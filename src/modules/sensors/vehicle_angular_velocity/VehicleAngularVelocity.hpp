@@ -38,6 +38,7 @@
 #include <lib/mathlib/math/Limits.hpp>
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/mathlib/math/filter/AlphaFilter.hpp>
+#include <lib/mathlib/math/filter/BiquadCascade.hpp>
 #include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
 #include <lib/mathlib/math/filter/NotchFilter.hpp>
 #include <px4_platform_common/log.h>
@@ -78,7 +79,10 @@ private:
 	bool CalibrateAndPublish(const hrt_abstime &timestamp_sample, const matrix::Vector3f &angular_velocity_uncalibrated,
 				 const matrix::Vector3f &angular_acceleration_uncalibrated);
 
-	inline float FilterAngularVelocity(int axis, float data[], int N = 1);
+	void AddFilterStage(math::NotchFilter<float> *filter[3], float *data[3], int N);
+	void AddFilterStage(math::LowPassFilter2p<float> filter[3], float *data[3], int N);
+	void FlushFilterCascade(float *data[3], int N);
+	inline void FilterAngularVelocity(float *data[3], int N = 1);
 	inline float FilterAngularAcceleration(int axis, float inverse_dt_s, float data[], int N = 1);
 
 	void DisableDynamicNotchEscRpm();
@@ -133,6 +137,9 @@ private:
 	math::NotchFilter<float> _notch_filter0_velocity[3] {};
 	math::NotchFilter<float> _notch_filter1_velocity[3] {};
 
+	// all active angular velocity filter stages of all axes, applied in one pass
+	math::BiquadCascade _filter_cascade{};
+
 #if !defined(CONSTRAINED_FLASH)
 
 	enum DynamicNotch {
@@ -180,6 +187,7 @@ private:
 	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": gyro filter")};
 	perf_counter_t _filter_reset_perf{perf_alloc(PC_COUNT, MODULE_NAME": gyro filter reset")};
 	perf_counter_t _selection_changed_perf{perf_alloc(PC_COUNT, MODULE_NAME": gyro selection changed")};
+	perf_counter_t _filter_cascade_full_perf{perf_alloc(PC_COUNT, MODULE_NAME": gyro filter cascade full")};
 
 	DEFINE_PARAMETERS(
 #if !defined(CONSTRAINED_FLASH)
@@ -485,7 +485,11 @@ bool VehicleIMU::UpdateGyro()
 
 		const Vector3f gyro_raw{gyro.x, gyro.y, gyro.z};
 		_raw_gyro_mean.update(gyro_raw);
-		_gyro_integrator.put(gyro_raw, dt);
+
+		// integrate all raw FIFO samples if available, otherwise (no FIFO) the sensor_gyro sample
+		if ((gyro.samples <= 1) || !UpdateGyroFifo(gyro, dt)) {
+			_gyro_integrator.put(gyro_raw, dt);
+		}
 
 		updated = true;
 
@@ -679,6 +683,76 @@ bool VehicleIMU::Publish()
 	return updated;
 }
 
+bool VehicleIMU::UpdateGyroFifo(const sensor_gyro_s &gyro, const float dt)
+{
+	if (!_sensor_gyro_fifo_available || (_sensor_gyro_fifo.device_id != gyro.device_id)) {
+		const hrt_abstime now = hrt_absolute_time();
+
+		if (now < _sensor_gyro_fifo_search_last + 1_s) {
+			return false;
+		}
+
+		_sensor_gyro_fifo_search_last = now;
+		_sensor_gyro_fifo_available = false;
+
+		// find the sensor_gyro_fifo instance published alongside this sensor_gyro
+		for (uint8_t i = 0; i < MAX_SENSOR_COUNT; i++) {
+			uORB::SubscriptionData<sensor_gyro_fifo_s> sensor_gyro_fifo_sub{ORB_ID(sensor_gyro_fifo), i};
+
+			if (sensor_gyro_fifo_sub.advertised() && (sensor_gyro_fifo_sub.get().device_id == gyro.device_id)) {
+				_sensor_gyro_fifo_sub.ChangeInstance(i);
+				_sensor_gyro_fifo = sensor_gyro_fifo_sub.get();
+				_sensor_gyro_fifo_available = true;
+				break;
+			}
+		}
+
+		if (!_sensor_gyro_fifo_available) {
+			return false;
+		}
+	}
+
+	// sensor_gyro_fifo is published right before the corresponding sensor_gyro, catch up without skipping ahead
+	while ((_sensor_gyro_fifo.timestamp_sample < gyro.timestamp_sample) && _sensor_gyro_fifo_sub.update(&_sensor_gyro_fifo)) {}
+
+	if ((_sensor_gyro_fifo.timestamp_sample == gyro.timestamp_sample)
+	    && (_sensor_gyro_fifo.device_id == gyro.device_id)
+	    && (_sensor_gyro_fifo.samples == gyro.samples)) {
+
+		const int16_t *samples[3] {_sensor_gyro_fifo.x, _sensor_gyro_fifo.y, _sensor_gyro_fifo.z};
+		_gyro_integrator.put(samples, _sensor_gyro_fifo.scale, _sensor_gyro_fifo.samples, dt);
+		return true;
+	}
+
+	// missed FIFO message: integrate the averaged sample as a block of equal raw samples, so the integrator
+	// state (last sample) always refers to a raw sample while the FIFO is used
+	static constexpr uint8_t FIFO_SIZE_MAX = sizeof(_sensor_gyro_fifo.x) / sizeof(_sensor_gyro_fifo.x[0]);
+	const float scale = _sensor_gyro_fifo.scale;
+	const uint8_t N = math::min(gyro.samples, FIFO_SIZE_MAX);
+
+	if ((scale > 0.f) && (N > 0)) {
+		const int16_t mean[3] {
+			(int16_t)math::constrain(roundf(gyro.x / scale), (float)INT16_MIN, (float)INT16_MAX),
+			(int16_t)math::constrain(roundf(gyro.y / scale), (float)INT16_MIN, (float)INT16_MAX),
+			(int16_t)math::constrain(roundf(gyro.z / scale), (float)INT16_MIN, (float)INT16_MAX),
+		};
+
+		int16_t block[3][FIFO_SIZE_MAX];
+
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < N; n++) {
+				block[axis][n] = mean[axis];
+			}
+		}
+
+		const int16_t *samples[3] {block[0], block[1], block[2]};
+		_gyro_integrator.put(samples, scale, N, dt);
+		return true;
+	}
+
+	return false;
+}
+
 void VehicleIMU::UpdateIntegratorConfiguration()
 {
 	if (_accel_mean_interval_us.valid() && _gyro_mean_interval_us.valid()) {
@@ -765,6 +839,10 @@ void VehicleIMU::PrintStatus()
 		     _gyro_calibration.device_id(), (double)_gyro_mean_interval_us.mean(),
 		     (double)_gyro_mean_interval_us.standard_deviation());
 
+	if (_sensor_gyro_fifo_available) {
+		PX4_INFO_RAW("[vehicle_imu] %" PRIu8 " - gyro FIFO integration\n", _instance);
+	}
+
 #if defined(DEBUG_BUILD)
 	PX4_INFO_RAW("[vehicle_imu] %" PRIu8
 		     " - gyro update sample latency: %.1f us (SD %.1f us), publish latency %.1f us (SD %.1f us)\n",
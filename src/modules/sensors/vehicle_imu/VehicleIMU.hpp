@@ -54,6 +54,7 @@
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_gyro.h>
+#include <uORB/topics/sensor_gyro_fifo.h>
 #include <uORB/topics/vehicle_control_mode.h>
 #include <uORB/topics/vehicle_imu.h>
 #include <uORB/topics/vehicle_imu_status.h>
@@ -86,6 +87,7 @@ private:
 
 	bool UpdateAccel();
 	bool UpdateGyro();
+	bool UpdateGyroFifo(const sensor_gyro_s &gyro, const float dt);
 
 	void UpdateIntegratorConfiguration();
 
@@ -96,6 +98,8 @@ private:
 	void SensorCalibrationSaveAccel();
 	void SensorCalibrationSaveGyro();
 
+	static constexpr int MAX_SENSOR_COUNT = 4;
+
 	// return the square of two floating point numbers
 	static constexpr float sq(float var) { return var * var; }
 
@@ -112,6 +116,12 @@ private:
 	uORB::Subscription _sensor_accel_sub;
 	uORB::SubscriptionCallbackWorkItem _sensor_gyro_sub;
 
+	// raw FIFO samples of the gyro (if available) for coning corrections at the raw sensor rate
+	uORB::Subscription _sensor_gyro_fifo_sub{ORB_ID(sensor_gyro_fifo)};
+	sensor_gyro_fifo_s _sensor_gyro_fifo{};
+	hrt_abstime _sensor_gyro_fifo_search_last{0};
+	bool _sensor_gyro_fifo_available{false};
+
 	uORB::Subscription _vehicle_control_mode_sub{ORB_ID(vehicle_control_mode)};
 
 	calibration::Accelerometer _accel_calibration{};
@@ -145,6 +145,34 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 {
 	const hrt_abstime time_now_us = hrt_absolute_time();
 
+	// Adaptive voting: with multiple IMUs all of them are fed into the voter every cycle to keep their timeouts
+	// and error counts current, while the selection and the inconsistency checks only run every SENS_IMU_VDEC cycles.
+	// A single IMU cannot be outvoted, it bypasses the voter entirely on the cycles in between.
+	// Any anomaly of the primary switches back to full rate voting.
+	bool voting_cycle = true;
+	bool feed_voter = true;
+
+	if (_param_sens_imu_vdec.get() > 1) {
+		if (++_voting_decimation_counter >= _param_sens_imu_vdec.get()) {
+			_voting_decimation_counter = 0;
+		}
+
+		voting_cycle = (_voting_decimation_counter == 0) || _parameter_update || _selection_changed
+			       || (_selection.accel_device_id == 0) || (_selection.gyro_device_id == 0)
+			       || ((_voting_anomaly_timestamp != 0) && (time_now_us < _voting_anomaly_timestamp + VOTING_ANOMALY_HOLDOFF));
+
+		int imu_count = 0;
+
+		for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+			if ((_accel_device_id[i] != 0) && (_accel.priority[i] > 0) && (_gyro.priority[i] > 0)) {
+				imu_count++;
+			}
+		}
+
+		_single_imu = (imu_count <= 1);
+		feed_voter = voting_cycle || !_single_imu;
+	}
+
 	for (int uorb_index = 0; uorb_index < MAX_SENSOR_COUNT; uorb_index++) {
 		vehicle_imu_s imu_report;
 
@@ -183,22 +211,41 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 
 			_last_accel_timestamp[uorb_index] = imu_report.timestamp_sample;
 
-			_accel.voter.put(uorb_index, imu_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
-					 imu_status.accel_error_count, _accel.priority[uorb_index]);
+			if (feed_voter) {
+				_accel.voter.put(uorb_index, imu_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
+						 imu_status.accel_error_count, _accel.priority[uorb_index]);
 
-			_gyro.voter.put(uorb_index, imu_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
-					imu_status.gyro_error_count, _gyro.priority[uorb_index]);
+				_gyro.voter.put(uorb_index, imu_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
+						imu_status.gyro_error_count, _gyro.priority[uorb_index]);
+			}
 		}
 	}
 
+	// the confidence of the primary is only current if the voter was fed this cycle
+	if ((_param_sens_imu_vdec.get() > 1) && feed_voter
+	    && ((_accel.voter.get_sensor_confidence(_accel.last_best_vote, time_now_us) < 1.f)
+		|| (_gyro.voter.get_sensor_confidence(_gyro.last_best_vote, time_now_us) < 1.f))) {
+		// primary timed out, went stale or reported errors
+		_voting_anomaly_timestamp = time_now_us;
+		voting_cycle = true;
+	}
+
+	_voting_cycle = voting_cycle;
+
+	if (_cycles_since_voting < UINT8_MAX) {
+		_cycles_since_voting++;
+	}
+
 	// find the best sensor
 	int accel_best_index = _accel.last_best_vote;
 	int gyro_best_index = _gyro.last_best_vote;
 
 	if (!_parameter_update) {
 		// update current accel/gyro selection, skipped on cycles where parameters update
-		_accel.voter.get_best(time_now_us, &accel_best_index);
-		_gyro.voter.get_best(time_now_us, &gyro_best_index);
+		if (voting_cycle) {
+			_accel.voter.get_best(time_now_us, &accel_best_index);
+			_gyro.voter.get_best(time_now_us, &gyro_best_index);
+		}
 
 		if (!_param_sens_imu_mode.get() && ((_selection.timestamp != 0) || (_sensor_selection_sub.updated()))) {
 			// use sensor_selection to find best
@@ -220,7 +267,7 @@ void VotedSensorsUpdate::imuPoll(struct sensor_combined_s &raw)
 				}
 			}
 
-		} else {
+		} else if (voting_cycle) {
 			// use sensor voter to find best if SENS_IMU_MODE is enabled or ORB_ID(sensor_selection) has never published
 			checkFailover(_accel, "Accel", events::px4::enums::sensor_type_t::accel);
 			checkFailover(_gyro, "Gyro", events::px4::enums::sensor_type_t::gyro);
@@ -399,14 +446,31 @@ void VotedSensorsUpdate::printStatus()
 	PX4_INFO_RAW("\n");
 	PX4_INFO_RAW("selected accel: %" PRIu32 " (%" PRIu8 ")\n", _selection.accel_device_id, _accel.last_best_vote);
 	_accel.voter.print();
+
+	PX4_INFO_RAW("\n");
+
+	if (_param_sens_imu_vdec.get() > 1) {
+		PX4_INFO_RAW("adaptive voting: decimation %" PRId32 ", %s%s\n", _param_sens_imu_vdec.get(),
+			     (_voting_anomaly_timestamp != 0) && (hrt_elapsed_time(&_voting_anomaly_timestamp) < VOTING_ANOMALY_HOLDOFF) ?
+			     "full rate (anomaly)" : "decimated", _single_imu ? ", single IMU bypass" : "");
+	}
 }
 
 void VotedSensorsUpdate::sensorsPoll(sensor_combined_s &raw)
 {
 	imuPoll(raw);
 
-	calcAccelInconsistency();
-	calcGyroInconsistency();
+	if (!_voting_cycle) {
+		// inconsistencies and status only updated on voting cycles
+		return;
+	}
+
+	// scale the inconsistency filter to the number of cycles since the last update (0.05 per cycle)
+	const float alpha = (_cycles_since_voting <= 1) ? 0.05f : 1.f - powf(0.95f, _cycles_since_voting);
+	_cycles_since_voting = 0;
+
+	calcAccelInconsistency(alpha);
+	calcGyroInconsistency(alpha);
 
 	sensors_status_imu_s status{};
 	status.accel_device_id_primary = _selection.accel_device_id;
@@ -451,7 +515,7 @@ void VotedSensorsUpdate::setRelativeTimestamps(sensor_combined_s &raw)
 	}
 }
 
-void VotedSensorsUpdate::calcAccelInconsistency()
+void VotedSensorsUpdate::calcAccelInconsistency(float alpha)
 {
 	Vector3f accel_mean{};
 	Vector3f accel_all[MAX_SENSOR_COUNT] {};
@@ -470,13 +534,13 @@ void VotedSensorsUpdate::calcAccelInconsistency()
 
 		for (int sensor_index = 0; sensor_index < MAX_SENSOR_COUNT; sensor_index++) {
 			if ((_accel_device_id[sensor_index] != 0) && (_accel.priority[sensor_index] > 0)) {
-				_accel_diff[sensor_index] = 0.95f * _accel_diff[sensor_index] + 0.05f * (accel_all[sensor_index] - accel_mean);
+				_accel_diff[sensor_index] = (1.f - alpha) * _accel_diff[sensor_index] + alpha * (accel_all[sensor_index] - accel_mean);
 			}
 		}
 	}
 }
 
-void VotedSensorsUpdate::calcGyroInconsistency()
+void VotedSensorsUpdate::calcGyroInconsistency(float alpha)
 {
 	Vector3f gyro_mean{};
 	Vector3f gyro_all[MAX_SENSOR_COUNT] {};
@@ -495,7 +559,7 @@ void VotedSensorsUpdate::calcGyroInconsistency()
 
 		for (int sensor_index = 0; sensor_index < MAX_SENSOR_COUNT; sensor_index++) {
 			if ((_gyro_device_id[sensor_index] != 0) && (_gyro.priority[sensor_index] > 0)) {
-				_gyro_diff[sensor_index] = 0.95f * _gyro_diff[sensor_index] + 0.05f * (gyro_all[sensor_index] - gyro_mean);
+				_gyro_diff[sensor_index] = (1.f - alpha) * _gyro_diff[sensor_index] + alpha * (gyro_all[sensor_index] - gyro_mean);
 			}
 		}
 	}
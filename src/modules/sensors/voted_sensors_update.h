@@ -106,6 +106,8 @@ private:
 
 	static constexpr uint8_t DEFAULT_PRIORITY = 50;
 
+	static constexpr hrt_abstime VOTING_ANOMALY_HOLDOFF{1000000}; ///< full rate voting after an anomaly of the primary IMU
+
 	struct SensorData {
 		SensorData() = delete;
 		explicit SensorData(ORB_ID meta) : subscription{{meta, 0}, {meta, 1}, {meta, 2}, {meta, 3}} {}
@@ -138,13 +140,15 @@ private:
 
 	/**
 	 * Calculates the magnitude in m/s/s of the largest difference between each accelerometer vector and the mean of all vectors
+	 * @param alpha	low pass filter gain of the difference
 	 */
-	void calcAccelInconsistency();
+	void calcAccelInconsistency(float alpha);
 
 	/**
 	 * Calculates the magnitude in rad/s of the largest difference between each gyro vector and the mean of all vectors
+	 * @param alpha	low pass filter gain of the difference
 	 */
-	void calcGyroInconsistency();
+	void calcGyroInconsistency(float alpha);
 
 	SensorData _accel{ORB_ID::sensor_accel};
 	SensorData _gyro{ORB_ID::sensor_gyro};
@@ -178,8 +182,15 @@ private:
 
 	bool _parameter_update{false};
 
+	bool _voting_cycle{true};			/**< true if all IMUs were processed and voted in the last imuPoll() */
+	uint8_t _voting_decimation_counter{0};
+	uint8_t _cycles_since_voting{0};		/**< number of imuPoll() cycles since the previous voting cycle */
+	hrt_abstime _voting_anomaly_timestamp{0};	/**< time of the last anomaly of the primary IMU */
+	bool _single_imu{false};			/**< true if at most one IMU is active, it bypasses the voter between voting cycles */
+
 	DEFINE_PARAMETERS(
-		(ParamBool<px4::params::SENS_IMU_MODE>) _param_sens_imu_mode
+		(ParamBool<px4::params::SENS_IMU_MODE>) _param_sens_imu_mode,
+		(ParamInt<px4::params::SENS_IMU_VDEC>) _param_sens_imu_vdec
 	)
 };
 
@@ -34,7 +34,6 @@
 #include "SensorMagSim.hpp"
 
 #include <drivers/drv_sensor.h>
-#include <lib/world_magnetic_model/geo_mag_declination.h>
 
 using namespace matrix;
 
@@ -113,11 +112,10 @@ void SensorMagSim::Run()
 			if (gpos.eph < 1000) {
 
 				// magnetic field data returned by the geo library using the current GPS position
-				const float mag_declination_gps = get_mag_declination_radians(gpos.lat, gpos.lon);
-				const float mag_inclination_gps = get_mag_inclination_radians(gpos.lat, gpos.lon);
-				const float mag_strength_gps = get_mag_strength_gauss(gpos.lat, gpos.lon);
+				const geo_mag_field_s &mag_field = _geo_mag_cache.get(gpos.lat, gpos.lon);
 
-				_mag_earth_pred = Dcmf(Eulerf(0, -mag_inclination_gps, mag_declination_gps)) * Vector3f(mag_strength_gps, 0, 0);
+				_mag_earth_pred = Dcmf(Eulerf(0, -mag_field.inclination_rad, mag_field.declination_rad))
+						  * Vector3f(mag_field.strength_gauss, 0, 0);
 
 				_mag_earth_available = true;
 			}
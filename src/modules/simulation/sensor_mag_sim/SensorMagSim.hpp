@@ -34,6 +34,7 @@
 #pragma once
 
 #include <lib/drivers/magnetometer/PX4Magnetometer.hpp>
+#include <lib/world_magnetic_model/geo_mag_declination.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
@@ -82,6 +83,8 @@ private:
 
 	bool _mag_earth_available{false};
 
+	GeoMagCache _geo_mag_cache{};
+
 	matrix::Vector3f _mag_earth_pred{};
 
 	perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
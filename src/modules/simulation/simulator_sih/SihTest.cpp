@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "aero.hpp"
+#include "sih.hpp"
+
+using namespace matrix;
+
+// to run: make tests TESTFILTER=Sih
+
+static constexpr float DT = 0.004f;
+
+TEST(SihTest, freeFall)
+{
+	// GIVEN: a multicopter without thrust and drag, thrown from 100 m
+	const Vector3f p0{0.f, 0.f, -100.f};
+	const Vector3f v0{1.f, 2.f, -5.f};
+	const float t = 1.f;
+	const int steps = static_cast<int>(t / DT + 0.5f);
+
+	auto simulate = [&](Sih::Integrator integrator) {
+		Sih sih;
+		sih._sih_kdv.set(0.f);
+		sih._sih_kdw.set(0.f);
+		sih.parameters_updated();
+		sih.init_variables();
+		sih._vehicle = Sih::VehicleType::MC;
+		sih._integrator = integrator;
+		sih._p_I = p0;
+		sih._v_I = v0;
+
+		// WHEN: we integrate the equations of motion
+		for (int i = 0; i < steps; i++) {
+			sih.generate_force_and_torques();
+			sih.equations_of_motion(DT);
+		}
+
+		const Vector3f p_expected = p0 + v0 * t + Vector3f(0.f, 0.f, 0.5f * CONSTANTS_ONE_G * t * t);
+		return (sih._p_I - p_expected).norm();
+	};
+
+	// THEN: RK4 is exact up to the float round-off, Euler forward lags by half a step of gravity
+	const float error_rk4 = simulate(Sih::Integrator::RK4);
+	const float error_euler = simulate(Sih::Integrator::Euler);
+
+	EXPECT_LT(error_rk4, 2e-3f);
+	EXPECT_NEAR(error_euler, 0.5f * CONSTANTS_ONE_G * t * DT, 2e-3f);
+	EXPECT_LT(error_rk4, 0.1f * error_euler);
+}
+
+TEST(SihTest, constantTorque)
+{
+	// GIVEN: a multicopter at rest with a constant roll torque, no angular damping
+	const float t = 0.5f;
+	const int steps = static_cast<int>(t / DT + 0.5f);
+	float alpha = 0.f;
+
+	auto simulate = [&](Sih::Integrator integrator) {
+		Sih sih;
+		sih._sih_kdw.set(0.f);
+		sih.parameters_updated();
+		sih.init_variables();
+		sih._vehicle = Sih::VehicleType::MC;
+		sih._integrator = integrator;
+		sih._p_I = Vector3f(0.f, 0.f, -100.f);
+		sih._u[1] = sih._u[2] = 0.05f;
+
+		// WHEN: we integrate the equations of motion
+		for (int i = 0; i < steps; i++) {
+			sih.generate_force_and_torques();
+			sih.equations_of_motion(DT);
+		}
+
+		// the body rates stay about the principal roll axis
+		alpha = sih._Mt_B(0) / sih._I(0, 0);
+		EXPECT_NEAR(sih._w_B(0), alpha * t, 1e-4f);
+
+		return fabsf(2.f * atan2f(sih._q(1), sih._q(0)) - 0.5f * alpha * t * t);
+	};
+
+	// THEN: RK4 gives the quadratic roll angle, Euler forward lags by half a step of the rate
+	const float error_rk4 = simulate(Sih::Integrator::RK4);
+	const float error_euler = simulate(Sih::Integrator::Euler);
+
+	EXPECT_GT(alpha, 1.f);
+	EXPECT_LT(error_rk4, 1e-4f);
+	EXPECT_NEAR(error_euler, 0.5f * alpha * t * DT, 2e-4f);
+}
+
+TEST(SihTest, rk4KeepsInitialForces)
+{
+	// GIVEN: a rotating and moving multicopter with drag
+	Sih sih;
+	sih.parameters_updated();
+	sih.init_variables();
+	sih._vehicle = Sih::VehicleType::MC;
+	sih._integrator = Sih::Integrator::RK4;
+	sih._p_I = Vector3f(0.f, 0.f, -100.f);
+	sih._v_I = Vector3f(3.f, -1.f, 2.f);
+	sih._q = Quatf(Eulerf(0.3f, -0.2f, 1.f));
+	sih._w_B = Vector3f(2.f, -1.f, 0.5f);
+	sih._u[0] = sih._u[1] = sih._u[2] = sih._u[3] = 0.4f;
+
+	const Quatf q0 = sih._q;
+	sih.generate_force_and_torques();
+	const Vector3f T_B = sih._T_B;
+	const Vector3f Fa_I = sih._Fa_I;
+	const Vector3f Mt_B = sih._Mt_B;
+	const Vector3f Ma_B = sih._Ma_B;
+
+	// WHEN: we integrate one step
+	sih.equations_of_motion(DT);
+
+	// THEN: the sensors see the transformation and the forces of the initial state, not the ones of the last stage
+	EXPECT_TRUE(isEqual(sih._C_IB, Dcmf(q0)));
+	EXPECT_TRUE(isEqual(sih._T_B, T_B));
+	EXPECT_TRUE(isEqual(sih._Fa_I, Fa_I));
+	EXPECT_TRUE(isEqual(sih._Mt_B, Mt_B));
+	EXPECT_TRUE(isEqual(sih._Ma_B, Ma_B));
+	EXPECT_FALSE(isEqual(sih._q, q0));
+}
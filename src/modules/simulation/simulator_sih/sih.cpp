@@ -53,6 +53,10 @@ using namespace math;
 using namespace matrix;
 using namespace time_literals;
 
+// IMU noise standard deviations of a single sample per time step, from [1]
+static constexpr float ACCEL_NOISE_STD[3] {0.5f, 1.7f, 1.4f};	// [m/s^2]
+static constexpr float GYRO_NOISE_STD[3] {0.14f, 0.07f, 0.03f};	// [rad/s]
+
 Sih::Sih() :
 	ModuleParams(nullptr)
 {}
@@ -214,7 +218,7 @@ void Sih::sensor_step()
 
 	equations_of_motion(dt);
 
-	reconstruct_sensors_signals(now);
+	reconstruct_sensors_signals(now, dt);
 
 	if ((_vehicle == VehicleType::FW || _vehicle == VehicleType::TS) && now - _airspeed_time >= 50_ms) {
 		_airspeed_time = now;
@@ -264,11 +268,27 @@ void Sih::parameters_updated()
 	_distance_snsr_override = _sih_distance_snsr_override.get();
 
 	_T_TAU = _sih_thrust_tau.get();
+
+	_integrator = static_cast<Integrator>(constrain(_sih_integ.get(), static_cast<typeof _sih_integ.get()>(0),
+					      static_cast<typeof _sih_integ.get()>(2)));
+
+	const int imu_fifo_samples = constrain(_sih_imu_fifo.get(), 1, IMU_FIFO_SAMPLES_MAX);
+
+	if (imu_fifo_samples != _imu_fifo_samples) {
+		// single samples are published as float, FIFO bursts as scaled integers
+		const bool fifo = imu_fifo_samples > 1;
+		_px4_accel.set_scale(fifo ? ACCEL_FIFO_SCALE : 1.f);
+		_px4_gyro.set_scale(fifo ? GYRO_FIFO_SCALE : 1.f);
+		_imu_fifo_samples = imu_fifo_samples;
+	}
 }
 
 void Sih::init_variables()
 {
-	srand(1234);    // initialize the random seed once before calling generate_wgn()
+	// every noise stream has its own seed for reproducible runs
+	const uint64_t seed = static_cast<uint32_t>(_sih_noise_seed.get());
+	_imu_noise.reset(2 * seed);
+	_airspeed_noise.reset(2 * seed + 1);
 
 	_p_I = Vector3f(0.0f, 0.0f, 0.0f);
 	_v_I = Vector3f(0.0f, 0.0f, 0.0f);
@@ -418,31 +438,176 @@ void Sih::equations_of_motion(const float dt)
 		}
 
 	} else {
-		// integration: Euler forward
-		_p_I = _p_I + _p_I_dot * dt;
-		_v_I = _v_I + _v_I_dot * dt;
-		_q = _q * _dq;
-		_q.normalize();
-		// integration Runge-Kutta 4
-		// rk4_update(_p_I, _v_I, _q, _w_B);
-		_w_B = constrain(_w_B + _w_B_dot * dt, -6.0f * M_PI_F, 6.0f * M_PI_F);
+		switch (_integrator) {
+		case Integrator::RK4:
+			rk4_update(dt);
+			break;
+
+		case Integrator::SemiImplicitEuler:
+			// integration: semi-implicit Euler, the positions use the updated velocities
+			_v_I = _v_I + _v_I_dot * dt;
+			_p_I = _p_I + _v_I * dt;
+			_w_B = constrain(_w_B + _w_B_dot * dt, -6.0f * M_PI_F, 6.0f * M_PI_F);
+			_q = _q * Quatf::expq(0.5f * dt * _w_B);
+			_q.normalize();
+			break;
+
+		case Integrator::Euler:
+		default:
+			// integration: Euler forward
+			_p_I = _p_I + _p_I_dot * dt;
+			_v_I = _v_I + _v_I_dot * dt;
+			_q = _q * _dq;
+			_q.normalize();
+			_w_B = constrain(_w_B + _w_B_dot * dt, -6.0f * M_PI_F, 6.0f * M_PI_F);
+			break;
+		}
+
 		_grounded = false;
 	}
 }
 
-void Sih::reconstruct_sensors_signals(const hrt_abstime &time_now_us)
+Sih::RigidBodyDerivative Sih::compute_derivative(const RigidBodyState &state)
+{
+	_p_I = state.p_I;
+	_v_I = state.v_I;
+	_q = state.q;
+	_w_B = state.w_B;
+	_C_IB = matrix::Dcm<float>(_q);
+
+	generate_force_and_torques();
+
+	RigidBodyDerivative derivative;
+	derivative.p_I_dot = _v_I;
+	derivative.v_I_dot = (_W_I + _Fa_I + _C_IB * _T_B) / _MASS;
+	derivative.w_B = _w_B;
+	derivative.w_B_dot = _Im1 * (_Mt_B + _Ma_B - _w_B.cross(_I * _w_B));
+	return derivative;
+}
+
+Sih::RigidBodyState Sih::propagate(const RigidBodyState &state, const RigidBodyDerivative &derivative, const float h)
+{
+	RigidBodyState next;
+	next.p_I = state.p_I + derivative.p_I_dot * h;
+	next.v_I = state.v_I + derivative.v_I_dot * h;
+	next.q = state.q * Quatf::expq(0.5f * h * derivative.w_B);
+	next.q.normalize();
+	next.w_B = state.w_B + derivative.w_B_dot * h;
+	return next;
+}
+
+void Sih::rk4_update(const float dt)
+{
+	// the stages re-evaluate the forces and torques at the intermediate states,
+	// the attitude is advanced with the weighted body rates on the exponential map [3]
+	const RigidBodyState x0{_p_I, _v_I, _q, _w_B};
+
+	// the stages overwrite the forces and torques, keep the ones of the initial state
+	const Vector3f T_B{_T_B};
+	const Vector3f Fa_I{_Fa_I};
+	const Vector3f Mt_B{_Mt_B};
+	const Vector3f Ma_B{_Ma_B};
+	const Vector3f v_B{_v_B};
+
+	const RigidBodyDerivative k1 = compute_derivative(x0);
+	const RigidBodyDerivative k2 = compute_derivative(propagate(x0, k1, 0.5f * dt));
+	const RigidBodyDerivative k3 = compute_derivative(propagate(x0, k2, 0.5f * dt));
+	const RigidBodyDerivative k4 = compute_derivative(propagate(x0, k3, dt));
+
+	RigidBodyDerivative k;
+	k.p_I_dot = (k1.p_I_dot + 2.f * (k2.p_I_dot + k3.p_I_dot) + k4.p_I_dot) / 6.f;
+	k.v_I_dot = (k1.v_I_dot + 2.f * (k2.v_I_dot + k3.v_I_dot) + k4.v_I_dot) / 6.f;
+	k.w_B = (k1.w_B + 2.f * (k2.w_B + k3.w_B) + k4.w_B) / 6.f;
+	k.w_B_dot = (k1.w_B_dot + 2.f * (k2.w_B_dot + k3.w_B_dot) + k4.w_B_dot) / 6.f;
+
+	const RigidBodyState x1 = propagate(x0, k, dt);
+
+	// same as the Euler integrators, the body to inertial transformation and the forces are the ones at the start of the step
+	_C_IB = matrix::Dcm<float>(x0.q);
+	_T_B = T_B;
+	_Fa_I = Fa_I;
+	_Mt_B = Mt_B;
+	_Ma_B = Ma_B;
+	_v_B = v_B;
+
+	_p_I = x1.p_I;
+	_v_I = x1.v_I;
+	_q = x1.q;
+	_w_B = constrain(x1.w_B, -6.0f * M_PI_F, 6.0f * M_PI_F);
+
+	// the accelerometer measures the mean acceleration over the step
+	_p_I_dot = k.p_I_dot;
+	_v_I_dot = k.v_I_dot;
+	_w_B_dot = k.w_B_dot;
+}
+
+void Sih::reconstruct_sensors_signals(const hrt_abstime &time_now_us, const float dt)
 {
 	// The sensor signals reconstruction and noise levels are from [1]
 	// [1] Bulka, Eitan, and Meyer Nahon. "Autonomous fixed-wing aerobatics: from theory to flight."
 	//     In 2018 IEEE International Conference on Robotics and Automation (ICRA), pp. 6573-6580. IEEE, 2018.
 
 	// IMU
-	Vector3f acc = _C_IB.transpose() * (_v_I_dot - Vector3f(0.0f, 0.0f, CONSTANTS_ONE_G)) + noiseGauss3f(0.5f, 1.7f, 1.4f);
-	Vector3f gyro = _w_B + noiseGauss3f(0.14f, 0.07f, 0.03f);
+	const Vector3f specific_force = _C_IB.transpose() * (_v_I_dot - Vector3f(0.0f, 0.0f, CONSTANTS_ONE_G));
+
+	if (_imu_fifo_samples > 1) {
+		send_imu_fifo(time_now_us, dt, specific_force);
+
+	} else {
+		Vector3f acc = specific_force + noiseGauss3f(_imu_noise, ACCEL_NOISE_STD[0], ACCEL_NOISE_STD[1], ACCEL_NOISE_STD[2]);
+		Vector3f gyro = _w_B + noiseGauss3f(_imu_noise, GYRO_NOISE_STD[0], GYRO_NOISE_STD[1], GYRO_NOISE_STD[2]);
+
+		// update IMU every iteration
+		_px4_accel.update(time_now_us, acc(0), acc(1), acc(2));
+		_px4_gyro.update(time_now_us, gyro(0), gyro(1), gyro(2));
+	}
+
+	_specific_force_prev = specific_force;
+	_w_B_prev = _w_B;
+}
+
+void Sih::send_imu_fifo(const hrt_abstime &time_now_us, const float dt, const Vector3f &specific_force)
+{
+	const int N = _imu_fifo_samples;
+
+	// the noise of the individual samples is scaled such that their mean over the time step
+	// has the noise level of a single sample per step
+	const float noise_scale = sqrtf(static_cast<float>(N));
+
+	for (int axis = 0; axis < 3; axis++) {
+		_imu_noise.fill(_accel_noise[axis], N);
+		_imu_noise.fill(_gyro_noise[axis], N);
+	}
+
+	_accel_fifo.timestamp_sample = time_now_us;
+	_accel_fifo.dt = dt * 1e6f / N;
+	_accel_fifo.samples = N;
+
+	_gyro_fifo.timestamp_sample = time_now_us;
+	_gyro_fifo.dt = _accel_fifo.dt;
+	_gyro_fifo.samples = N;
+
+	int16_t *accel_data[3] {_accel_fifo.x, _accel_fifo.y, _accel_fifo.z};
+	int16_t *gyro_data[3] {_gyro_fifo.x, _gyro_fifo.y, _gyro_fifo.z};
+
+	for (int axis = 0; axis < 3; axis++) {
+		const float accel_std = ACCEL_NOISE_STD[axis] * noise_scale;
+		const float gyro_std = GYRO_NOISE_STD[axis] * noise_scale;
+
+		for (int i = 0; i < N; i++) {
+			// the true signals are interpolated linearly over the time step, the last sample is at time_now_us
+			const float ratio = static_cast<float>(i + 1) / N;
+			const float accel = _specific_force_prev(axis) + ratio * (specific_force(axis) - _specific_force_prev(axis))
+					    + _accel_noise[axis][i] * accel_std;
+			const float gyro = _w_B_prev(axis) + ratio * (_w_B(axis) - _w_B_prev(axis)) + _gyro_noise[axis][i] * gyro_std;
+
+			accel_data[axis][i] = static_cast<int16_t>(constrain(roundf(accel / ACCEL_FIFO_SCALE), -32768.f, 32767.f));
+			gyro_data[axis][i] = static_cast<int16_t>(constrain(roundf(gyro / GYRO_FIFO_SCALE), -32768.f, 32767.f));
+		}
+	}
 
-	// update IMU every iteration
-	_px4_accel.update(time_now_us, acc(0), acc(1), acc(2));
-	_px4_gyro.update(time_now_us, gyro(0), gyro(1), gyro(2));
+	_px4_accel.updateFIFO(_accel_fifo);
+	_px4_gyro.updateFIFO(_gyro_fifo);
 }
 
 void Sih::send_airspeed(const hrt_abstime &time_now_us)
@@ -450,7 +615,7 @@ void Sih::send_airspeed(const hrt_abstime &time_now_us)
 	// TODO: send differential pressure instead?
 	airspeed_s airspeed{};
 	airspeed.timestamp_sample = time_now_us;
-	airspeed.true_airspeed_m_s = fmaxf(0.1f, _v_B(0) + generate_wgn() * 0.2f);
+	airspeed.true_airspeed_m_s = fmaxf(0.1f, _v_B(0) + _airspeed_noise.next() * 0.2f);
 	airspeed.indicated_airspeed_m_s = airspeed.true_airspeed_m_s * sqrtf(_wing_l.get_rho() / RHO);
 	airspeed.air_temperature_celsius = NAN;
 	airspeed.confidence = 0.7f;
@@ -565,38 +730,9 @@ void Sih::publish_ground_truth(const hrt_abstime &time_now_us)
 	}
 }
 
-float Sih::generate_wgn()   // generate white Gaussian noise sample with std=1
-{
-	// algorithm 1:
-	// float temp=((float)(rand()+1))/(((float)RAND_MAX+1.0f));
-	// return sqrtf(-2.0f*logf(temp))*cosf(2.0f*M_PI_F*rand()/RAND_MAX);
-	// algorithm 2: from BlockRandGauss.hpp
-	static float V1, V2, S;
-	static bool phase = true;
-	float X;
-
-	if (phase) {
-		do {
-			float U1 = (float)rand() / (float)RAND_MAX;
-			float U2 = (float)rand() / (float)RAND_MAX;
-			V1 = 2.0f * U1 - 1.0f;
-			V2 = 2.0f * U2 - 1.0f;
-			S = V1 * V1 + V2 * V2;
-		} while (S >= 1.0f || fabsf(S) < 1e-8f);
-
-		X = V1 * float(sqrtf(-2.0f * float(logf(S)) / S));
-
-	} else {
-		X = V2 * float(sqrtf(-2.0f * float(logf(S)) / S));
-	}
-
-	phase = !phase;
-	return X;
-}
-
-Vector3f Sih::noiseGauss3f(float stdx, float stdy, float stdz)
+Vector3f Sih::noiseGauss3f(math::GaussianNoise<> &noise, float stdx, float stdy, float stdz)
 {
-	return Vector3f(generate_wgn() * stdx, generate_wgn() * stdy, generate_wgn() * stdz);
+	return Vector3f(noise.next() * stdx, noise.next() * stdy, noise.next() * stdz);
 }
 
 int Sih::print_status()
@@ -619,6 +755,17 @@ int Sih::print_status()
 		_ts[4].get_vS().print();
 	}
 
+	if (_integrator == Integrator::RK4) {
+		PX4_INFO("Integrator: Runge-Kutta 4");
+
+	} else if (_integrator == Integrator::SemiImplicitEuler) {
+		PX4_INFO("Integrator: semi-implicit Euler");
+
+	} else {
+		PX4_INFO("Integrator: forward Euler");
+	}
+
+	PX4_INFO("IMU samples per step: %d", _imu_fifo_samples);
 	PX4_INFO("vehicle landed: %d", _grounded);
 	PX4_INFO("inertial position NED (m)");
 	_p_I.print();
@@ -694,7 +841,7 @@ in order to incorporate the state estimator in the loop.
 ### Implementation
 The simulator implements the equations of motion using matrix algebra.
 Quaternion representation is used for the attitude.
-Forward Euler is used for integration.
+Forward Euler, semi-implicit Euler or Runge-Kutta 4 is used for integration (SIH_INTEG).
 Most of the variables are declared global in the .hpp file to avoid stack overflow.
 
 
@@ -65,6 +65,7 @@
 #include <drivers/drv_hrt.h>        // to get the real time
 #include <lib/drivers/accelerometer/PX4Accelerometer.hpp>
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
+#include <lib/mathlib/math/GaussianNoise.hpp>
 #include <lib/perf/perf_counter.h>
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
@@ -82,6 +83,10 @@
 #include <sys/time.h>
 #endif
 
+#ifndef FRIEND_TEST // for gtest
+#define FRIEND_TEST(a, b)
+#endif
+
 using namespace time_literals;
 
 class Sih : public ModuleBase<Sih>, public ModuleParams
@@ -108,12 +113,11 @@ public:
 	/** @see ModuleBase::run() */
 	void run() override;
 
-	static float generate_wgn();    // generate white Gaussian noise sample
-
-	// generate white Gaussian noise sample as a 3D vector with specified std
-	static matrix::Vector3f noiseGauss3f(float stdx, float stdy, float stdz);
-
 private:
+	FRIEND_TEST(SihTest, freeFall);
+	FRIEND_TEST(SihTest, constantTorque);
+	FRIEND_TEST(SihTest, rk4KeepsInitialForces);
+
 	void parameters_updated();
 
 	// simulated sensors
@@ -154,8 +158,37 @@ private:
 	// apply the equations of motion of a rigid body and integrate one step
 	void equations_of_motion(const float dt);
 
+	struct RigidBodyState {
+		matrix::Vector3f p_I;	// inertial position [m]
+		matrix::Vector3f v_I;	// inertial velocity [m/s]
+		matrix::Quatf q;	// attitude
+		matrix::Vector3f w_B;	// body rates in body frame [rad/s]
+	};
+
+	struct RigidBodyDerivative {
+		matrix::Vector3f p_I_dot;	// position differential
+		matrix::Vector3f v_I_dot;	// velocity differential
+		matrix::Vector3f w_B;		// body rates, the attitude differential is 0.5 * q * w_B
+		matrix::Vector3f w_B_dot;	// body rates differential
+	};
+
+	// generate the forces and torques at the given state and evaluate the equations of motion
+	RigidBodyDerivative compute_derivative(const RigidBodyState &state);
+
+	// advance the state along the differential by a time step h
+	static RigidBodyState propagate(const RigidBodyState &state, const RigidBodyDerivative &derivative, const float h);
+
+	// integrate one step with the classic Runge-Kutta 4 method, the attitude with the exponential map
+	void rk4_update(const float dt);
+
 	// reconstruct the noisy sensor signals
-	void reconstruct_sensors_signals(const hrt_abstime &time_now_us);
+	void reconstruct_sensors_signals(const hrt_abstime &time_now_us, const float dt);
+
+	// synthesize a burst of IMU samples interpolated over the last time step
+	void send_imu_fifo(const hrt_abstime &time_now_us, const float dt, const matrix::Vector3f &specific_force);
+
+	// generate white Gaussian noise samples as a 3D vector with specified std
+	static matrix::Vector3f noiseGauss3f(math::GaussianNoise<> &noise, float stdx, float stdy, float stdz);
 	void send_airspeed(const hrt_abstime &time_now_us);
 	void send_dist_snsr(const hrt_abstime &time_now_us);
 	void publish_ground_truth(const hrt_abstime &time_now_us);
@@ -200,9 +233,28 @@ private:
 	matrix::Vector3f    _w_B_dot{};       // body rates differential
 	float       _u[NB_MOTORS] {};         // thruster signals
 
+	// independent deterministic noise streams
+	math::GaussianNoise<> _imu_noise;
+	math::GaussianNoise<> _airspeed_noise;
+
+	// IMU FIFO bursts
+	static constexpr int IMU_FIFO_SAMPLES_MAX = 32;			// sensor_accel_fifo_s and sensor_gyro_fifo_s size
+	static constexpr float ACCEL_FIFO_SCALE = CONSTANTS_ONE_G / 2048.f;	// 16 g range
+	static constexpr float GYRO_FIFO_SCALE = math::radians(2000.f) / 32768.f; // 2000 dps range
+	int                 _imu_fifo_samples{1};
+	sensor_accel_fifo_s _accel_fifo{};
+	sensor_gyro_fifo_s  _gyro_fifo{};
+	float               _accel_noise[3][IMU_FIFO_SAMPLES_MAX] {};
+	float               _gyro_noise[3][IMU_FIFO_SAMPLES_MAX] {};
+	matrix::Vector3f    _specific_force_prev{0.f, 0.f, -CONSTANTS_ONE_G}; // accelerometer signal of the previous step
+	matrix::Vector3f    _w_B_prev{};      // gyroscope signal of the previous step
+
 	enum class VehicleType {MC, FW, TS};
 	VehicleType _vehicle = VehicleType::MC;
 
+	enum class Integrator {Euler, SemiImplicitEuler, RK4};
+	Integrator _integrator = Integrator::Euler;
+
 	// aerodynamic segments for the fixedwing
 	AeroSeg _wing_l = AeroSeg(SPAN / 2.0f, MAC, -4.0f, matrix::Vector3f(0.0f, -SPAN / 4.0f, 0.0f), 3.0f,
 				  SPAN / MAC, MAC / 3.0f);
@@ -280,6 +332,9 @@ private:
 		(ParamFloat<px4::params::SIH_DISTSNSR_MAX>) _sih_distance_snsr_max,
 		(ParamFloat<px4::params::SIH_DISTSNSR_OVR>) _sih_distance_snsr_override,
 		(ParamFloat<px4::params::SIH_T_TAU>) _sih_thrust_tau,
-		(ParamInt<px4::params::SIH_VEHICLE_TYPE>) _sih_vtype
+		(ParamInt<px4::params::SIH_VEHICLE_TYPE>) _sih_vtype,
+		(ParamInt<px4::params::SIH_INTEG>) _sih_integ,
+		(ParamInt<px4::params::SIH_NOISE_SEED>) _sih_noise_seed,
+		(ParamInt<px4::params::SIH_IMU_FIFO>) _sih_imu_fifo
 	)
 };
@@ -338,3 +338,44 @@ PARAM_DEFINE_FLOAT(SIH_T_TAU, 0.05f);
  * @group Simulation In Hardware
  */
 PARAM_DEFINE_INT32(SIH_VEHICLE_TYPE, 0);
+
+/**
+ * Integration method
+ *
+ * Numerical integration of the equations of motion in flight.
+ * Semi-implicit Euler and Runge-Kutta 4 stay stable and accurate at larger
+ * time steps (lower IMU_GYRO_RATEMAX) than forward Euler.
+ * Runge-Kutta 4 evaluates the forces and torques four times per step.
+ *
+ * @value 0 Forward Euler
+ * @value 1 Semi-implicit Euler
+ * @value 2 Runge-Kutta 4
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_INTEG, 0);
+
+/**
+ * Noise seed
+ *
+ * Seed of the simulated sensor noise. The noise sequences, and with them
+ * the simulation runs, are reproducible for a given seed.
+ *
+ * @min 0
+ * @reboot_required true
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_NOISE_SEED, 1234);
+
+/**
+ * IMU samples per time step
+ *
+ * Number of accelerometer and gyroscope samples synthesized per simulation
+ * time step. With more than one sample, the IMU publishes FIFO bursts of
+ * samples interpolated over the step, like a high rate IMU driver.
+ * The noise of the integrated IMU data is the same for any setting.
+ *
+ * @min 1
+ * @max 32
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_IMU_FIFO, 1);
@@ -147,13 +147,34 @@ int TemperatureCompensation::initialize_parameter_handles(ParameterHandles &para
 
 int TemperatureCompensation::parameters_update()
 {
-	ParameterHandles parameter_handles;
-	int ret = initialize_parameter_handles(parameter_handles);
+	ParameterHandles &parameter_handles = _parameter_handles;
+	int ret = PX4_OK;
 
-	if (ret != 0) {
-		return ret;
+	// the parameter handles (param_find() of ~150 names) only need to be initialized once,
+	// and again if a sensor type gets enabled
+	int32_t gyro_tc_enable = 0;
+	int32_t accel_tc_enable = 0;
+	int32_t baro_tc_enable = 0;
+	param_get(param_find("TC_G_ENABLE"), &gyro_tc_enable);
+	param_get(param_find("TC_A_ENABLE"), &accel_tc_enable);
+	param_get(param_find("TC_B_ENABLE"), &baro_tc_enable);
+
+	const uint8_t enable_mask = (gyro_tc_enable == 1) | ((accel_tc_enable == 1) << 1) | ((baro_tc_enable == 1) << 2);
+
+	if (!_parameter_handles_initialized || (enable_mask != _parameter_handles_enable_mask)) {
+		ret = initialize_parameter_handles(parameter_handles);
+
+		if (ret != 0) {
+			return ret;
+		}
+
+		_parameter_handles_initialized = true;
+		_parameter_handles_enable_mask = enable_mask;
 	}
 
+	// only force the offsets of a sensor type to be re-evaluated if its parameters actually changed
+	const Parameters parameters_prev = _parameters;
+
 	/* rate gyro calibration parameters */
 	param_get(parameter_handles.gyro_tc_enable, &_parameters.gyro_tc_enable);
 
@@ -237,9 +258,20 @@ int TemperatureCompensation::parameters_update()
 	/* the offsets might have changed, so make sure to report that change later when applying the
 	 * next corrections
 	 */
-	_gyro_data.reset_temperature();
-	_accel_data.reset_temperature();
-	_baro_data.reset_temperature();
+	if ((_parameters.gyro_tc_enable != parameters_prev.gyro_tc_enable)
+	    || (memcmp(_parameters.gyro_cal_data, parameters_prev.gyro_cal_data, sizeof(_parameters.gyro_cal_data)) != 0)) {
+		_gyro_data.reset_temperature();
+	}
+
+	if ((_parameters.accel_tc_enable != parameters_prev.accel_tc_enable)
+	    || (memcmp(_parameters.accel_cal_data, parameters_prev.accel_cal_data, sizeof(_parameters.accel_cal_data)) != 0)) {
+		_accel_data.reset_temperature();
+	}
+
+	if ((_parameters.baro_tc_enable != parameters_prev.baro_tc_enable)
+	    || (memcmp(_parameters.baro_cal_data, parameters_prev.baro_cal_data, sizeof(_parameters.baro_cal_data)) != 0)) {
+		_baro_data.reset_temperature();
+	}
 
 	return ret;
 }
@@ -344,7 +376,11 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 {
 	for (int i = 0; i < sensor_count_max; ++i) {
 		if (device_id == (uint32_t)sensor_cal_data[i].ID) {
-			sensor_data.device_mapping[topic_instance] = i;
+			if (sensor_data.device_mapping[topic_instance] != i) {
+				sensor_data.device_mapping[topic_instance] = i;
+				sensor_data.reset_temperature(topic_instance);
+			}
+
 			return i;
 		}
 	}
@@ -366,11 +402,9 @@ int TemperatureCompensation::update_offsets_gyro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > 0.1f) {
+	// Only re-evaluate the offsets if the temperature delta is large enough to warrant a new publication
+	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > TEMPERATURE_UPDATE_THRESHOLD) {
+		calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
 		_gyro_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
@@ -392,11 +426,9 @@ int TemperatureCompensation::update_offsets_accel(int topic_instance, float temp
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > 0.1f) {
+	// Only re-evaluate the offsets if the temperature delta is large enough to warrant a new publication
+	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > TEMPERATURE_UPDATE_THRESHOLD) {
+		calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
 		_accel_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
@@ -418,11 +450,9 @@ int TemperatureCompensation::update_offsets_baro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
-
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > 0.1f) {
+	// Only re-evaluate the offsets if the temperature delta is large enough to warrant a new publication
+	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > TEMPERATURE_UPDATE_THRESHOLD) {
+		calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
 		_baro_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
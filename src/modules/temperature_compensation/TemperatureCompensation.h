@@ -80,13 +80,15 @@ public:
 
 	/**
 	 * Apply Thermal corrections to gyro (& other) sensor data.
+	 * The offsets are only re-evaluated if the temperature changed by more than TEMPERATURE_UPDATE_THRESHOLD
+	 * since the last evaluation, otherwise the previously returned offsets remain valid.
 	 * @param topic_instance uORB topic instance
 	 * @param sensor_data input sensor data, output sensor data with applied corrections
 	 * @param temperature measured current temperature
 	 * @param offsets returns offsets that were applied (length = 3, except for baro), depending on return value
 	 * @return -1: error: correction enabled, but no sensor mapping set (@see set_sendor_id_gyro)
 	 *         0: no changes (correction not enabled),
-	 *         1: corrections applied but no changes to offsets,
+	 *         1: corrections applied but no changes to offsets (offsets not written),
 	 *         2: corrections applied and offsets updated
 	 */
 	int update_offsets_gyro(int topic_instance, float temperature, float *offsets);
@@ -97,6 +99,8 @@ public:
 	void print_status();
 private:
 
+	static constexpr float TEMPERATURE_UPDATE_THRESHOLD{0.1f}; ///< minimum temperature change to update the offsets (deg C)
+
 	/* Struct containing parameters used by the single axis 5th order temperature compensation algorithm
 
 	Input:
@@ -249,6 +253,10 @@ private:
 
 	Parameters _parameters;
 
+	ParameterHandles _parameter_handles{};
+	bool _parameter_handles_initialized{false};
+	uint8_t _parameter_handles_enable_mask{0}; ///< enabled sensor types when the handles were initialized
+
 
 	struct PerSensorData {
 
@@ -267,6 +275,11 @@ private:
 			}
 		}
 
+		void reset_temperature(int topic_instance)
+		{
+			last_temperature[topic_instance] = -100.0f;
+		}
+
 		uint8_t device_mapping[SENSOR_COUNT_MAX] {}; /// map a topic instance to the parameters index
 		float last_temperature[SENSOR_COUNT_MAX] {};
 	};
@@ -105,25 +105,28 @@ private:
 	 */
 	void parameters_update();
 
-	uORB::Subscription _accel_subs[ACCEL_COUNT_MAX] {
-		{ORB_ID(sensor_accel), 0},
-		{ORB_ID(sensor_accel), 1},
-		{ORB_ID(sensor_accel), 2},
-		{ORB_ID(sensor_accel), 3},
+	// the sensor temperature changes slowly, there's no need to copy every sensor message
+	static constexpr uint32_t SENSOR_POLL_INTERVAL_US{20_ms};
+
+	uORB::SubscriptionInterval _accel_subs[ACCEL_COUNT_MAX] {
+		{ORB_ID(sensor_accel), SENSOR_POLL_INTERVAL_US, 0},
+		{ORB_ID(sensor_accel), SENSOR_POLL_INTERVAL_US, 1},
+		{ORB_ID(sensor_accel), SENSOR_POLL_INTERVAL_US, 2},
+		{ORB_ID(sensor_accel), SENSOR_POLL_INTERVAL_US, 3},
 	};
 
-	uORB::Subscription _gyro_subs[GYRO_COUNT_MAX] {
-		{ORB_ID(sensor_gyro), 0},
-		{ORB_ID(sensor_gyro), 1},
-		{ORB_ID(sensor_gyro), 2},
-		{ORB_ID(sensor_gyro), 3},
+	uORB::SubscriptionInterval _gyro_subs[GYRO_COUNT_MAX] {
+		{ORB_ID(sensor_gyro), SENSOR_POLL_INTERVAL_US, 0},
+		{ORB_ID(sensor_gyro), SENSOR_POLL_INTERVAL_US, 1},
+		{ORB_ID(sensor_gyro), SENSOR_POLL_INTERVAL_US, 2},
+		{ORB_ID(sensor_gyro), SENSOR_POLL_INTERVAL_US, 3},
 	};
 
-	uORB::Subscription _baro_subs[BARO_COUNT_MAX] {
-		{ORB_ID(sensor_baro), 0},
-		{ORB_ID(sensor_baro), 1},
-		{ORB_ID(sensor_baro), 2},
-		{ORB_ID(sensor_baro), 3},
+	uORB::SubscriptionInterval _baro_subs[BARO_COUNT_MAX] {
+		{ORB_ID(sensor_baro), SENSOR_POLL_INTERVAL_US, 0},
+		{ORB_ID(sensor_baro), SENSOR_POLL_INTERVAL_US, 1},
+		{ORB_ID(sensor_baro), SENSOR_POLL_INTERVAL_US, 2},
+		{ORB_ID(sensor_baro), SENSOR_POLL_INTERVAL_US, 3},
 	};
 
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
@@ -0,0 +1,515 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlLatency.cpp
+ *
+ * Gyro to actuator output latency benchmark.
+ */
+
+#include "ControlLatency.hpp"
+
+#include <math.h>
+#include <string.h>
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+
+namespace control_latency
+{
+
+const char *const ControlLatency::_stage_names[NUM_STAGES] = {
+	"vehicle_angular_velocity",
+	"vehicle_torque_setpoint",
+	"actuator_motors",
+	"actuator_outputs",
+};
+
+void LatencyHistogram::reset(uint32_t bin_width_us)
+{
+	*this = LatencyHistogram{};
+	_bin_width_us = (bin_width_us > 0) ? bin_width_us : 1;
+}
+
+void LatencyHistogram::add(uint32_t latency_us)
+{
+	const uint32_t bin = latency_us / _bin_width_us;
+
+	if (bin < NUM_BINS) {
+		_bins[bin]++;
+
+	} else {
+		_overflow++;
+	}
+
+	_count++;
+	_min = math::min(_min, latency_us);
+	_max = math::max(_max, latency_us);
+	_sum += latency_us;
+	_sum_squared += (double)latency_us * latency_us;
+}
+
+float LatencyHistogram::std_dev() const
+{
+	if (_count < 2) {
+		return 0.f;
+	}
+
+	const double mean = _sum / _count;
+	const double variance = (_sum_squared - _count * mean * mean) / (_count - 1);
+
+	return (variance > 0.) ? (float)sqrt(variance) : 0.f;
+}
+
+uint32_t LatencyHistogram::percentile(float p) const
+{
+	const uint32_t target = ceilf(p * _count);
+	uint32_t cumulative = 0;
+
+	for (int i = 0; i < NUM_BINS; i++) {
+		cumulative += _bins[i];
+
+		if (cumulative >= target) {
+			return math::min((i + 1) * _bin_width_us, _max);
+		}
+	}
+
+	return _max;
+}
+
+void LatencyHistogram::print(const char *name) const
+{
+	PX4_INFO_RAW("%s: %" PRIu32 " samples, mean %.1f us, std %.1f us\n", name, _count, (double)mean(), (double)std_dev());
+
+	if (_count == 0) {
+		return;
+	}
+
+	static constexpr int BAR_WIDTH = 50;
+	uint32_t max_bin = _overflow;
+
+	for (int i = 0; i < NUM_BINS; i++) {
+		max_bin = math::max(max_bin, _bins[i]);
+	}
+
+	// skip leading and trailing empty bins
+	int first = 0;
+	int last = NUM_BINS - 1;
+
+	while (first < last && _bins[first] == 0) { first++; }
+
+	while (last > first && _bins[last] == 0) { last--; }
+
+	char bar[BAR_WIDTH + 1];
+
+	for (int i = first; i <= last + 1; i++) {
+		const uint32_t value = (i <= last) ? _bins[i] : _overflow;
+
+		if (i > last && value == 0) {
+			break;
+		}
+
+		const int width = (value * BAR_WIDTH + max_bin - 1) / max_bin;
+		memset(bar, '#', width);
+		bar[width] = '\0';
+
+		if (i <= last) {
+			PX4_INFO_RAW("  %6" PRIu32 " - %6" PRIu32 " us %8" PRIu32 " %s\n", i * _bin_width_us, (i + 1) * _bin_width_us, value, bar);
+
+		} else {
+			PX4_INFO_RAW("  %6" PRIu32 " -    inf us %8" PRIu32 " %s\n", NUM_BINS * _bin_width_us, value, bar);
+		}
+	}
+}
+
+LoadGenerator::LoadGenerator(const px4::wq_config_t &config, uint32_t period_us, uint32_t busy_us) :
+	ScheduledWorkItem("control_latency_load", config),
+	_wq_name(config.name),
+	_period_us(period_us),
+	_busy_us(busy_us)
+{
+}
+
+LoadGenerator::~LoadGenerator()
+{
+	ScheduleClear();
+}
+
+void LoadGenerator::print_status() const
+{
+	PX4_INFO("load: %" PRIu32 " us every %" PRIu32 " us on %s", _busy_us, _period_us, _wq_name);
+}
+
+void LoadGenerator::Run()
+{
+	const hrt_abstime start = hrt_absolute_time();
+
+	while (hrt_elapsed_time(&start) < _busy_us) {
+		// busy wait
+	}
+}
+
+ControlLatency::ControlLatency(uint32_t duration_s, uint32_t bin_width_us, uint8_t outputs_instance) :
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::hp_default),
+	_actuator_outputs_sub(this, ORB_ID(actuator_outputs), outputs_instance),
+	_duration(duration_s * 1_s),
+	_bin_width_us(bin_width_us)
+{
+	reset();
+}
+
+ControlLatency::~ControlLatency()
+{
+	ScheduleClear();
+	_actuator_outputs_sub.unregisterCallback();
+
+	if (_load_generator) {
+		_load_generator->stop();
+		delete _load_generator;
+	}
+}
+
+void ControlLatency::reset()
+{
+	for (auto &latency : _latency) {
+		latency.reset(_bin_width_us);
+	}
+
+	// jitter is typically much smaller than the latency
+	_jitter.reset(math::max(_bin_width_us / 5u, 1u));
+
+	_time_started = 0;
+	_time_finished = 0;
+	_last_timestamp_sample = 0;
+	_last_latency = 0;
+	_missed = 0;
+	_unmatched = 0;
+	_no_sample = 0;
+}
+
+bool ControlLatency::start(LoadGenerator *load_generator)
+{
+	_load_generator = load_generator;
+
+	if (!_actuator_outputs_sub.registerCallback()) {
+		PX4_ERR("callback registration failed");
+		return false;
+	}
+
+	if (_load_generator) {
+		_load_generator->start();
+	}
+
+	// backup schedule to handle the duration and stop requests without outputs being published
+	ScheduleOnInterval(100_ms);
+
+	return true;
+}
+
+void ControlLatency::finish()
+{
+	_time_finished = hrt_absolute_time();
+	_actuator_outputs_sub.unregisterCallback();
+
+	if (_load_generator) {
+		_load_generator->stop();
+	}
+
+	print_status();
+}
+
+void ControlLatency::Run()
+{
+	if (should_exit()) {
+		ScheduleClear();
+		_actuator_outputs_sub.unregisterCallback();
+		exit_and_cleanup();
+		return;
+	}
+
+	if (_time_finished != 0) {
+		return;
+	}
+
+	const unsigned last_generation = _actuator_outputs_sub.get_last_generation();
+	actuator_outputs_s actuator_outputs;
+
+	if (_actuator_outputs_sub.update(&actuator_outputs)) {
+		processSample(actuator_outputs, last_generation);
+	}
+
+	if (_time_started != 0 && _duration > 0 && hrt_elapsed_time(&_time_started) >= _duration) {
+		finish();
+	}
+}
+
+void ControlLatency::processSample(const actuator_outputs_s &actuator_outputs, unsigned last_generation)
+{
+	const hrt_abstime timestamp_sample = actuator_outputs.timestamp_sample;
+
+	if (timestamp_sample == 0 || actuator_outputs.timestamp < timestamp_sample) {
+		_no_sample++;
+		return;
+	}
+
+	if (_time_started == 0) {
+		_time_started = hrt_absolute_time();
+
+	} else if (_actuator_outputs_sub.get_last_generation() != last_generation + 1) {
+		_missed += _actuator_outputs_sub.get_last_generation() - last_generation - 1;
+	}
+
+	// outputs can be published multiple times for the same gyro sample (e.g. servo updates)
+	if (timestamp_sample == _last_timestamp_sample) {
+		return;
+	}
+
+	const uint32_t latency = actuator_outputs.timestamp - timestamp_sample;
+
+	if (_latency[STAGE_OUTPUT].count() > 0) {
+		_jitter.add((latency > _last_latency) ? latency - _last_latency : _last_latency - latency);
+	}
+
+	_latency[STAGE_OUTPUT].add(latency);
+	_last_latency = latency;
+	_last_timestamp_sample = timestamp_sample;
+
+	// intermediate stages, matched by the gyro sample timestamp that is passed through all of them
+	vehicle_angular_velocity_s vehicle_angular_velocity;
+	vehicle_torque_setpoint_s vehicle_torque_setpoint;
+	actuator_motors_s actuator_motors;
+
+	if (_vehicle_angular_velocity_sub.copy(&vehicle_angular_velocity)
+	    && _vehicle_torque_setpoint_sub.copy(&vehicle_torque_setpoint)
+	    && _actuator_motors_sub.copy(&actuator_motors)
+	    && (vehicle_angular_velocity.timestamp_sample == timestamp_sample)
+	    && (vehicle_torque_setpoint.timestamp_sample == timestamp_sample)
+	    && (actuator_motors.timestamp_sample == timestamp_sample)) {
+
+		_latency[STAGE_ANGULAR_VELOCITY].add(vehicle_angular_velocity.timestamp - timestamp_sample);
+		_latency[STAGE_RATE_CONTROL].add(vehicle_torque_setpoint.timestamp - timestamp_sample);
+		_latency[STAGE_ALLOCATION].add(actuator_motors.timestamp - timestamp_sample);
+
+	} else {
+		_unmatched++;
+	}
+}
+
+int ControlLatency::print_status()
+{
+	if (_time_started == 0) {
+		PX4_INFO("waiting for actuator_outputs with gyro sample timestamp");
+		return 0;
+	}
+
+	const hrt_abstime end = (_time_finished != 0) ? _time_finished : hrt_absolute_time();
+	PX4_INFO("%s after %.1f s", (_time_finished != 0) ? "finished" : "running", (double)((end - _time_started) * 1e-6f));
+
+	if (_load_generator) {
+		_load_generator->print_status();
+	}
+
+	PX4_INFO("missed: %" PRIu32 ", unmatched: %" PRIu32 ", no sample timestamp: %" PRIu32, _missed, _unmatched, _no_sample);
+
+	PX4_INFO_RAW("\nlatency since gyro sample [us]\n");
+	PX4_INFO_RAW("%-26s %8s %8s %8s %8s %8s %8s\n", "published", "samples", "mean", "std", "min", "p99", "max");
+
+	for (int i = 0; i < NUM_STAGES; i++) {
+		const LatencyHistogram &latency = _latency[i];
+		PX4_INFO_RAW("%-26s %8" PRIu32 " %8.1f %8.1f %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n", _stage_names[i],
+			     latency.count(), (double)latency.mean(), (double)latency.std_dev(),
+			     (latency.count() > 0) ? latency.min() : 0, latency.percentile(0.99f), latency.max());
+	}
+
+	PX4_INFO_RAW("\n");
+	_latency[STAGE_OUTPUT].print("gyro to output latency");
+	PX4_INFO_RAW("\n");
+	_jitter.print("latency jitter (change between consecutive samples)");
+
+	return 0;
+}
+
+int ControlLatency::task_spawn(int argc, char *argv[])
+{
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	PX4_ERR("not supported with lockstep, use a build without lockstep (e.g. px4_sitl_nolockstep)");
+	return PX4_ERROR;
+#endif // ENABLE_LOCKSTEP_SCHEDULER
+
+	int32_t duration_s = 10;
+	int32_t bin_width_us = 50;
+	int32_t outputs_instance = 0;
+	int32_t load_percent = 0;
+	const char *load_wq = "rate_ctrl";
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "d:b:i:l:q:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			duration_s = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'b':
+			bin_width_us = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'i':
+			outputs_instance = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'l':
+			load_percent = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'q':
+			load_wq = myoptarg;
+			break;
+
+		default:
+			print_usage("unrecognized flag");
+			return PX4_ERROR;
+		}
+	}
+
+	if (duration_s < 0 || bin_width_us <= 0 || outputs_instance < 0 || outputs_instance >= ORB_MULTI_MAX_INSTANCES
+	    || load_percent < 0 || load_percent > 95) {
+		print_usage("invalid argument");
+		return PX4_ERROR;
+	}
+
+	LoadGenerator *load_generator = nullptr;
+
+	if (load_percent > 0) {
+		static constexpr uint32_t LOAD_PERIOD_US = 1000;
+		const px4::wq_config_t *config = nullptr;
+
+		if (strcmp(load_wq, "rate_ctrl") == 0) {
+			config = &px4::wq_configurations::rate_ctrl;
+
+		} else if (strcmp(load_wq, "hp_default") == 0) {
+			config = &px4::wq_configurations::hp_default;
+
+		} else if (strcmp(load_wq, "nav_and_controllers") == 0) {
+			config = &px4::wq_configurations::nav_and_controllers;
+
+		} else if (strcmp(load_wq, "lp_default") == 0) {
+			config = &px4::wq_configurations::lp_default;
+
+		} else {
+			print_usage("unknown work queue");
+			return PX4_ERROR;
+		}
+
+		load_generator = new LoadGenerator(*config, LOAD_PERIOD_US, LOAD_PERIOD_US * load_percent / 100);
+
+		if (load_generator == nullptr) {
+			PX4_ERR("alloc failed");
+			return PX4_ERROR;
+		}
+	}
+
+	ControlLatency *instance = new ControlLatency(duration_s, bin_width_us, outputs_instance);
+
+	if (instance == nullptr) {
+		PX4_ERR("alloc failed");
+		delete load_generator;
+		return PX4_ERROR;
+	}
+
+	_object.store(instance);
+	_task_id = task_id_is_work_queue;
+
+	if (instance->start(load_generator)) {
+		return PX4_OK;
+	}
+
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
+}
+
+int ControlLatency::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
+
+int ControlLatency::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Measures the end-to-end latency of the control pipeline from the gyro sample to the actuator output
+(sensor_gyro -> vehicle_angular_velocity -> mc_rate_control -> control_allocator -> output driver).
+
+The gyro sample timestamp (timestamp_sample) is passed through all topics of the pipeline into
+actuator_outputs. For every published output the latency since the gyro sample is recorded per stage,
+together with a histogram of the end-to-end latency and its jitter (change between consecutive samples).
+
+Optionally a synthetic CPU load is generated on a work queue (busy work item running every 1 ms).
+
+The benchmark requires a real-time clock, i.e. a build without lockstep scheduler. It can be run headless
+in SITL with SIH, see Tools/simulation/control_latency_bench.sh.
+
+### Examples
+Measure for 30 s with 40% load on the rate controller work queue:
+$ control_latency start -d 30 -l 40 -q rate_ctrl
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("control_latency", "system");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_INT('d', 10, 0, 3600, "Duration in s (0 = until stopped)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('b', 50, 1, 10000, "Histogram bin width in us", true);
+	PRINT_MODULE_USAGE_PARAM_INT('i', 0, 0, ORB_MULTI_MAX_INSTANCES - 1, "actuator_outputs instance", true);
+	PRINT_MODULE_USAGE_PARAM_INT('l', 0, 0, 95, "Synthetic CPU load in percent", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('q', "rate_ctrl", "rate_ctrl|hp_default|nav_and_controllers|lp_default",
+					"Work queue for the synthetic load", true);
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+} // namespace control_latency
+
+extern "C" __EXPORT int control_latency_main(int argc, char *argv[])
+{
+	return control_latency::ControlLatency::main(argc, argv);
+}
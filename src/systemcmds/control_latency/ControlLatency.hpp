@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ControlLatency.hpp
+ *
+ * Gyro to actuator output latency benchmark.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/mathlib.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/actuator_motors.h>
+#include <uORB/topics/actuator_outputs.h>
+#include <uORB/topics/vehicle_angular_velocity.h>
+#include <uORB/topics/vehicle_torque_setpoint.h>
+
+using namespace time_literals;
+
+namespace control_latency
+{
+
+/**
+ * Latency histogram with fixed bin width and running statistics.
+ */
+class LatencyHistogram
+{
+public:
+	static constexpr int NUM_BINS = 32;
+
+	void reset(uint32_t bin_width_us);
+	void add(uint32_t latency_us);
+
+	uint32_t count() const { return _count; }
+	float mean() const { return (_count > 0) ? (float)(_sum / _count) : 0.f; }
+	float std_dev() const;
+	uint32_t min() const { return _min; }
+	uint32_t max() const { return _max; }
+
+	/**
+	 * Percentile (upper bin edge) in us, or max() if it falls into the overflow bin
+	 * @param p percentile in [0, 1]
+	 */
+	uint32_t percentile(float p) const;
+
+	void print(const char *name) const;
+
+private:
+	uint32_t _bins[NUM_BINS] {};
+	uint32_t _overflow{0};
+	uint32_t _bin_width_us{50};
+
+	uint32_t _count{0};
+	uint32_t _min{UINT32_MAX};
+	uint32_t _max{0};
+	double _sum{0.};
+	double _sum_squared{0.};
+};
+
+/**
+ * Busy work item producing a given CPU load on a work queue.
+ */
+class LoadGenerator : public px4::ScheduledWorkItem
+{
+public:
+	LoadGenerator(const px4::wq_config_t &config, uint32_t period_us, uint32_t busy_us);
+	~LoadGenerator() override;
+
+	void start() { ScheduleOnInterval(_period_us); }
+	void stop() { ScheduleClear(); }
+
+	void print_status() const;
+
+private:
+	void Run() override;
+
+	const char *const _wq_name;
+	const uint32_t _period_us;
+	const uint32_t _busy_us;
+};
+
+class ControlLatency : public ModuleBase<ControlLatency>, public px4::ScheduledWorkItem
+{
+public:
+	ControlLatency(uint32_t duration_s, uint32_t bin_width_us, uint8_t outputs_instance);
+	~ControlLatency() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	bool start(LoadGenerator *load_generator);
+
+private:
+	void Run() override;
+
+	void reset();
+	void finish();
+	void processSample(const actuator_outputs_s &actuator_outputs, unsigned last_generation);
+
+	enum Stage {
+		STAGE_ANGULAR_VELOCITY = 0, ///< vehicle_angular_velocity (sensors filtering)
+		STAGE_RATE_CONTROL,         ///< vehicle_torque_setpoint (rate controller)
+		STAGE_ALLOCATION,           ///< actuator_motors (control allocator)
+		STAGE_OUTPUT,               ///< actuator_outputs (output driver, end-to-end)
+		NUM_STAGES
+	};
+
+	static const char *const _stage_names[NUM_STAGES];
+
+	uORB::SubscriptionCallbackWorkItem _actuator_outputs_sub;
+
+	uORB::Subscription _vehicle_angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
+	uORB::Subscription _vehicle_torque_setpoint_sub{ORB_ID(vehicle_torque_setpoint)};
+	uORB::Subscription _actuator_motors_sub{ORB_ID(actuator_motors)};
+
+	LatencyHistogram _latency[NUM_STAGES] {};
+	LatencyHistogram _jitter{}; ///< absolute end-to-end latency change between consecutive samples
+
+	LoadGenerator *_load_generator{nullptr};
+
+	const hrt_abstime _duration;
+	const uint32_t _bin_width_us;
+
+	hrt_abstime _time_started{0};
+	hrt_abstime _time_finished{0};
+	hrt_abstime _last_timestamp_sample{0};
+	uint32_t _last_latency{0};
+
+	uint32_t _missed{0};     ///< actuator_outputs publications not processed
+	uint32_t _unmatched{0};  ///< samples where an intermediate topic was already overwritten
+	uint32_t _no_sample{0};  ///< actuator_outputs without gyro sample timestamp
+};
+
+} // namespace control_latency
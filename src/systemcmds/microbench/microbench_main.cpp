@@ -42,6 +42,11 @@
 __BEGIN_DECLS
 
 extern int test_microbench_atomic(int argc, char *argv[]);
+extern int test_microbench_calibration(int argc, char *argv[]);
+#if defined(CONFIG_MODULES_CONTROL_ALLOCATOR)
+extern int test_microbench_control_allocation(int argc, char *argv[]);
+#endif // CONFIG_MODULES_CONTROL_ALLOCATOR
+extern int test_microbench_filter(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
@@ -64,6 +69,11 @@ const struct {
 	{"all",		microbench_all,		OPT_NOALLTEST},
 
 	{"microbench_atomic",	test_microbench_atomic,	0},
+	{"microbench_calibration",	test_microbench_calibration,	0},
+#if defined(CONFIG_MODULES_CONTROL_ALLOCATOR)
+	{"microbench_control_allocation",	test_microbench_control_allocation,	0},
+#endif // CONFIG_MODULES_CONTROL_ALLOCATOR
+	{"microbench_filter",	test_microbench_filter,	0},
 	{"microbench_hrt",	test_microbench_hrt,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
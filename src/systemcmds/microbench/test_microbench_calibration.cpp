@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_calibration.cpp
+ * Tests for the microbench calibration solvers.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/sensor_calibration/lm_fit.hpp>
+#include <lib/sensor_calibration/SphereFit.hpp>
+#include <lib/sensor_calibration/mag_calibration_test_data.h>
+
+namespace MicroBenchCalibration
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+// recorded mag calibration data set
+static constexpr unsigned N_SAMPLES = sizeof(mag_data1_x) / sizeof(mag_data1_x[0]);
+
+class MicroBenchCalibration : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_mag_fit();
+
+	void reset();
+
+	void accumulate();
+	void fitDefault();
+	void fitLinearInitialGuess();
+
+	calibration::SphereFit _sphere_fit{};
+	sphere_params _sphere{};
+
+	float _x[N_SAMPLES] {};
+	float _y[N_SAMPLES] {};
+	float _z[N_SAMPLES] {};
+};
+
+bool MicroBenchCalibration::run_tests()
+{
+	ut_run_test(time_mag_fit);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchCalibration::reset()
+{
+	_sphere_fit.reset();
+	_sphere = sphere_params{};
+}
+
+void MicroBenchCalibration::accumulate()
+{
+	// cost per sample while the data is being collected
+	for (unsigned k = 0; k < N_SAMPLES; k++) {
+		_sphere_fit.addSample(matrix::Vector3f{mag_data1_x[k], mag_data1_y[k], mag_data1_z[k]});
+	}
+}
+
+void MicroBenchCalibration::fitDefault()
+{
+	// previous procedure: sphere and ellipsoid fit starting from the default parameters
+	lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, _sphere, false);
+	lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, _sphere, true);
+}
+
+void MicroBenchCalibration::fitLinearInitialGuess()
+{
+	// the linear fit is accumulated while collecting the samples, only the solution is needed at the end
+	accumulate();
+
+	_sphere_fit.solve(_sphere.offset, _sphere.radius);
+
+	lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, _sphere, false, 2);
+	lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, _sphere, true, 2);
+
+	// reject the outliers against the final model and refit the inliers
+	const unsigned count = lm_mag_fit_reject_outliers(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, _sphere,
+			       _x, _y, _z);
+
+	lm_mag_fit(_x, _y, _z, count, _sphere, false, 2);
+	lm_mag_fit(_x, _y, _z, count, _sphere, true, 2);
+}
+
+bool MicroBenchCalibration::time_mag_fit()
+{
+	PERF("SphereFit accumulate 231 samples", accumulate(), 100);
+	PERF("mag fit 231 samples (default initial guess)", fitDefault(), 10);
+	PERF("mag fit 231 samples (linear initial guess, outlier refit)", fitLinearInitialGuess(), 10);
+
+	return true;
+}
+
+ut_declare_test_c(test_microbench_calibration, MicroBenchCalibration)
+
+} // namespace MicroBenchCalibration
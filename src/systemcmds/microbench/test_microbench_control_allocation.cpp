@@ -0,0 +1,303 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_control_allocation.cpp
+ * Tests for the microbench control allocation methods.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <ControlAllocationActiveSet.hpp>
+#include <ControlAllocationPseudoInverse.hpp>
+#include <ControlAllocationSequentialDesaturation.hpp>
+
+namespace MicroBenchControlAllocation
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+using ActuatorVector = ControlAllocation::ActuatorVector;
+
+static constexpr int NUM_SETPOINTS = 200;
+
+class MicroBenchControlAllocation : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_quad();
+	bool time_hybrid();
+	bool time_tilt_update();
+
+	void reset() {}
+
+	void configure(int num_actuators);
+	void allocate(ControlAllocation &method, bool clip);
+	void tilt(float angle);
+	void tiltUpdate();
+	void tiltUpdateFull();
+	float allocationError(ControlAllocation &method, bool clip);
+
+	ControlAllocationPseudoInverse _pseudo_inverse{};
+	ControlAllocationSequentialDesaturation _sequential_desaturation{};
+	ControlAllocationActiveSet _active_set{};
+
+	matrix::Vector<float, 6> _control_sp[NUM_SETPOINTS];
+	int _setpoint_index{0};
+
+	matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> _tilt_effectiveness;
+	matrix::Matrix<float, ControlAllocation::NUM_ACTUATORS, ControlAllocation::NUM_AXES> _mix;
+	float _tilt_angle{0.f};
+};
+
+bool MicroBenchControlAllocation::run_tests()
+{
+	ut_run_test(time_quad);
+	ut_run_test(time_hybrid);
+	ut_run_test(time_tilt_update);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchControlAllocation::configure(int num_actuators)
+{
+	matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> effectiveness;
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+
+	srand(1234);
+
+	if (num_actuators == 4) {
+		// quad X
+		static constexpr float roll[4] {-0.707f, 0.707f, 0.707f, -0.707f};
+		static constexpr float pitch[4] {0.707f, -0.707f, 0.707f, -0.707f};
+		static constexpr float yaw[4] {0.05f, 0.05f, -0.05f, -0.05f};
+
+		for (int i = 0; i < 4; i++) {
+			effectiveness(0, i) = 6.5f * roll[i];
+			effectiveness(1, i) = 6.5f * pitch[i];
+			effectiveness(2, i) = 6.5f * yaw[i];
+			effectiveness(5, i) = -6.5f;
+			actuator_max(i) = 1.f;
+		}
+
+	} else {
+		// hybrid: motors first, then control surfaces
+		for (int i = 0; i < num_actuators; i++) {
+			const bool motor = i < 8;
+
+			for (int j = 0; j < 6; j++) {
+				effectiveness(j, i) = 2.f * rand() / (float)RAND_MAX - 1.f;
+			}
+
+			if (motor) {
+				effectiveness(5, i) = -5.f - 2.f * rand() / (float)RAND_MAX;
+			}
+
+			actuator_min(i) = motor ? 0.f : -1.f;
+			actuator_max(i) = 1.f;
+		}
+	}
+
+	ControlAllocation *methods[] {&_pseudo_inverse, &_sequential_desaturation, &_active_set};
+
+	for (ControlAllocation *method : methods) {
+		method->setNormalizeRPY(true);
+		method->setActuatorMin(actuator_min);
+		method->setActuatorMax(actuator_max);
+		method->setEffectivenessMatrix(effectiveness, ActuatorVector{}, ActuatorVector{}, num_actuators, true);
+		method->updateParameters();
+	}
+
+	// slowly varying setpoints, with saturation in most of them
+	for (int k = 0; k < NUM_SETPOINTS; k++) {
+		const float t = k * 0.05f;
+		_control_sp[k](0) = 0.6f * sinf(3.f * t);
+		_control_sp[k](1) = 0.5f * cosf(2.f * t);
+		_control_sp[k](2) = 0.3f * sinf(t);
+		_control_sp[k](5) = -0.5f - 0.45f * sinf(0.5f * t);
+	}
+
+	_setpoint_index = 0;
+}
+
+void MicroBenchControlAllocation::allocate(ControlAllocation &method, bool clip)
+{
+	method.setControlSetpoint(_control_sp[_setpoint_index]);
+	method.allocate();
+
+	if (clip) {
+		method.clipActuatorSetpoint();
+	}
+
+	_setpoint_index = (_setpoint_index + 1) % NUM_SETPOINTS;
+}
+
+float MicroBenchControlAllocation::allocationError(ControlAllocation &method, bool clip)
+{
+	// mean weighted control error (roll/pitch prioritized) over all setpoints
+	float error_sum = 0.f;
+	_setpoint_index = 0;
+
+	for (int k = 0; k < NUM_SETPOINTS; k++) {
+		allocate(method, clip);
+		const matrix::Vector<float, 6> error = _control_sp[k] - method.getAllocatedControl();
+		error_sum += 10.f * (fabsf(error(0)) + fabsf(error(1))) + fabsf(error(2)) + 3.f * fabsf(error(5));
+	}
+
+	return error_sum / NUM_SETPOINTS;
+}
+
+bool MicroBenchControlAllocation::time_quad()
+{
+	configure(4);
+
+	PERF("quad pseudo-inverse", allocate(_pseudo_inverse, true), 1000);
+	PERF("quad sequential desaturation", allocate(_sequential_desaturation, true), 1000);
+	PERF("quad active set", allocate(_active_set, false), 1000);
+
+	PX4_INFO("quad mean weighted control error: pseudo-inverse %.4f, sequential desaturation %.4f, active set %.4f",
+		 (double)allocationError(_pseudo_inverse, true), (double)allocationError(_sequential_desaturation, true),
+		 (double)allocationError(_active_set, false));
+
+	return true;
+}
+
+bool MicroBenchControlAllocation::time_hybrid()
+{
+	configure(12);
+
+	PERF("12 actuators pseudo-inverse", allocate(_pseudo_inverse, true), 1000);
+	PERF("12 actuators sequential desaturation", allocate(_sequential_desaturation, true), 1000);
+	PERF("12 actuators active set", allocate(_active_set, false), 1000);
+
+	PX4_INFO("12 actuators mean weighted control error: pseudo-inverse %.4f, sequential desaturation %.4f, active set %.4f",
+		 (double)allocationError(_pseudo_inverse, true), (double)allocationError(_sequential_desaturation, true),
+		 (double)allocationError(_active_set, false));
+
+	return true;
+}
+
+void MicroBenchControlAllocation::tilt(float angle)
+{
+	// 4 tilting rotors of a tiltrotor VTOL
+	for (int i = 0; i < 4; i++) {
+		_tilt_effectiveness(3, i) = sinf(angle);
+		_tilt_effectiveness(5, i) = -cosf(angle);
+	}
+}
+
+void MicroBenchControlAllocation::tiltUpdate()
+{
+	_tilt_angle += 0.01f;
+	tilt(_tilt_angle);
+	_pseudo_inverse.setEffectivenessMatrix(_tilt_effectiveness, ActuatorVector{}, ActuatorVector{}, 8, false);
+	allocate(_pseudo_inverse, true);
+}
+
+void MicroBenchControlAllocation::tiltUpdateFull()
+{
+	// full pseudo-inverse recompute at every update
+	_tilt_angle += 0.01f;
+	tilt(_tilt_angle);
+	matrix::geninv(_tilt_effectiveness, _mix);
+}
+
+bool MicroBenchControlAllocation::time_tilt_update()
+{
+	configure(8);
+
+	// 4 tilting rotors and 4 control surfaces
+	_tilt_effectiveness.setZero();
+
+	for (int i = 0; i < 8; i++) {
+		for (int j = 0; j < 3; j++) {
+			_tilt_effectiveness(j, i) = 2.f * rand() / (float)RAND_MAX - 1.f;
+		}
+	}
+
+	PERF("tilt update pseudo-inverse + allocate", tiltUpdate(), 1000);
+	PERF("tilt update full geninv", tiltUpdateFull(), 1000);
+
+	return true;
+}
+
+ut_declare_test_c(test_microbench_control_allocation, MicroBenchControlAllocation)
+
+} // namespace MicroBenchControlAllocation
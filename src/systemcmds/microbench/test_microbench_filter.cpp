@@ -0,0 +1,308 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2023 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_filter.cpp
+ * Tests for the microbench gyro filter chain and spectrum estimation.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/mathlib/math/filter/BiquadCascade.hpp>
+#include <lib/mathlib/math/filter/SlidingDFT.hpp>
+#include <lib/mathlib/math/test/gyro_test_data.h>
+#include <lib/mathlib/math/RealFFT.hpp>
+
+namespace MicroBenchFilter
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+// gyro filter chain of VehicleAngularVelocity at 8 kHz: 8 ESCs with 3 RPM harmonics, 3 FFT peaks, 2 notches and low-pass
+static constexpr float SAMPLE_FREQ = 8000.f;
+static constexpr int NUM_ESCS = 8;
+static constexpr int NUM_HARMONICS = 3;
+static constexpr int NUM_FFT_PEAKS = 3;
+static constexpr int NUM_NOTCH = NUM_ESCS * NUM_HARMONICS + NUM_FFT_PEAKS + 2;
+static constexpr int NUM_SAMPLES = 32; // FIFO batch
+
+class MicroBenchFilter : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_gyro_filter_chain();
+	bool time_sliding_dft();
+	bool time_real_fft();
+
+	void reset();
+
+	void applyIndividual(int num_notch);
+	void applyCascade(int num_notch);
+	void updateSlidingDFT();
+	void updateSlidingDFTRecorded();
+
+	math::LowPassFilter2p<float> _lpf[3] {};
+	math::NotchFilter<float> _notch[NUM_NOTCH][3] {};
+
+	math::BiquadCascade _cascade{};
+
+	math::SlidingDFT _sliding_dft[3] {};
+
+	static constexpr int FFT_LENGTH_MAX = 1024;
+	math::RealFFT _real_fft{};
+	float _fft_input[FFT_LENGTH_MAX] {};
+	float _fft_output[FFT_LENGTH_MAX + 2] {};
+
+	float _data[3][NUM_SAMPLES] {};
+
+	int _recorded_index{0};
+};
+
+bool MicroBenchFilter::run_tests()
+{
+	ut_run_test(time_gyro_filter_chain);
+	ut_run_test(time_sliding_dft);
+	ut_run_test(time_real_fft);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchFilter::reset()
+{
+	srand(time(nullptr));
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int n = 0; n < NUM_SAMPLES; n++) {
+			_data[axis][n] = random(-1.f, 1.f);
+		}
+	}
+}
+
+void MicroBenchFilter::applyIndividual(int num_notch)
+{
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < num_notch; i++) {
+			_notch[i][axis].applyArray(_data[axis], NUM_SAMPLES);
+		}
+
+		_lpf[axis].applyArray(_data[axis], NUM_SAMPLES);
+	}
+}
+
+void MicroBenchFilter::applyCascade(int num_notch)
+{
+	_cascade.clear();
+
+	for (int i = 0; i < num_notch; i++) {
+		math::NotchFilter<float> *nf[3] {&_notch[i][0], &_notch[i][1], &_notch[i][2]};
+		_cascade.addStage(nf);
+	}
+
+	_cascade.addStage(_lpf);
+
+	float *data[3] {_data[0], _data[1], _data[2]};
+	_cascade.apply(data, NUM_SAMPLES);
+	_cascade.store();
+}
+
+void MicroBenchFilter::updateSlidingDFT()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		_sliding_dft[axis].update(_data[axis], NUM_SAMPLES);
+	}
+}
+
+void MicroBenchFilter::updateSlidingDFTRecorded()
+{
+	// next FIFO batch of the recording, including the peak search input every 1/16 window like gyro_fft
+	static constexpr int NUM_RECORDED = sizeof(gyro_data_x) / sizeof(gyro_data_x[0]);
+	const float *gyro_data[3] {gyro_data_x, gyro_data_y, gyro_data_z};
+	const int hop = _sliding_dft[0].length() / 16;
+
+	for (int n = 0; n < NUM_SAMPLES; n++) {
+		for (int axis = 0; axis < 3; axis++) {
+			_sliding_dft[axis].update(gyro_data[axis][_recorded_index]);
+
+			if ((_recorded_index % hop) == 0) {
+				_sliding_dft[axis].windowedSpectrum(_fft_output);
+			}
+		}
+
+		_recorded_index = (_recorded_index + 1) % NUM_RECORDED;
+	}
+}
+
+bool MicroBenchFilter::time_sliding_dft()
+{
+	// gyro_fft sliding DFT mode, cost per FIFO batch (constant, unlike the block FFT)
+	struct {
+		const char *name;
+		int length;
+		float min_hz;
+		float max_hz;
+	} configs[] {
+		{"sliding DFT 3 axes x 32 samples, N=512, 30-150 Hz", 512, 30.f, 150.f},
+		{"sliding DFT 3 axes x 32 samples, N=1024, 30-150 Hz", 1024, 30.f, 150.f},
+		{"sliding DFT 3 axes x 32 samples, N=512, 30-500 Hz", 512, 30.f, 500.f},
+	};
+
+	for (auto &config : configs) {
+		const float resolution_hz = SAMPLE_FREQ / config.length;
+		const int bin_first = (int)ceilf(config.min_hz / resolution_hz) - 1;
+		const int bin_last = (int)floorf(config.max_hz / resolution_hz) + 1;
+
+		for (auto &sliding_dft : _sliding_dft) {
+			sliding_dft.init(config.length, bin_first, bin_last);
+		}
+
+		PERF(config.name, updateSlidingDFT(), 100);
+	}
+
+	// recorded gyro data (250 Hz), IMU_GYRO_FFT_LEN=256, 30-120 Hz
+	const float resolution_hz = GYRO_DATA_SAMPLE_FREQ / 256;
+
+	for (auto &sliding_dft : _sliding_dft) {
+		sliding_dft.init(256, (int)ceilf(30.f / resolution_hz) - 1, (int)floorf(120.f / resolution_hz) + 1);
+	}
+
+	_recorded_index = 0;
+	PERF("sliding DFT 3 axes x 32 samples, recorded gyro, N=256, 30-120 Hz", updateSlidingDFTRecorded(), 100);
+
+	return true;
+}
+
+bool MicroBenchFilter::time_real_fft()
+{
+	// gyro_fft float backend, one FFT (per axis) of IMU_GYRO_FFT_LEN samples
+	for (int n = 0; n < FFT_LENGTH_MAX; n++) {
+		_fft_input[n] = random(-1000.f, 1000.f);
+	}
+
+	_real_fft.init(256);
+	PERF("real FFT float N=256", _real_fft.forward(_fft_input, _fft_output), 100);
+
+	for (int n = 0; n < 256; n++) {
+		_fft_input[n] = gyro_data_x[n];
+	}
+
+	PERF("real FFT float N=256, recorded gyro", _real_fft.forward(_fft_input, _fft_output), 100);
+
+	for (int n = 0; n < FFT_LENGTH_MAX; n++) {
+		_fft_input[n] = random(-1000.f, 1000.f);
+	}
+
+	_real_fft.init(512);
+	PERF("real FFT float N=512", _real_fft.forward(_fft_input, _fft_output), 100);
+
+	_real_fft.init(1024);
+	PERF("real FFT float N=1024", _real_fft.forward(_fft_input, _fft_output), 100);
+
+	return true;
+}
+
+bool MicroBenchFilter::time_gyro_filter_chain()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		_lpf[axis].set_cutoff_frequency(SAMPLE_FREQ, 80.f);
+
+		for (int i = 0; i < NUM_NOTCH; i++) {
+			_notch[i][axis].setParameters(SAMPLE_FREQ, 100.f + 20.f * i, 20.f);
+		}
+	}
+
+	_cascade.allocate(NUM_NOTCH + 1);
+
+	PERF("gyro filter 3 axes x 32 samples, low-pass + 2 notch (individual)", applyIndividual(2), 100);
+	PERF("gyro filter 3 axes x 32 samples, low-pass + 2 notch (cascade)", applyCascade(2), 100);
+
+	PERF("gyro filter 3 axes x 32 samples, low-pass + 29 notch (individual)", applyIndividual(NUM_NOTCH), 100);
+	PERF("gyro filter 3 axes x 32 samples, low-pass + 29 notch (cascade)", applyCascade(NUM_NOTCH), 100);
+
+	return true;
+}
+
+ut_declare_test_c(test_microbench_filter, MicroBenchFilter)
+
+} // namespace MicroBenchFilter
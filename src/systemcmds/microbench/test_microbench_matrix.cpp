@@ -99,6 +99,7 @@ private:
 	bool time_matrix_quaternion();
 	bool time_matrix_dcm();
 	bool time_matrix_pseduo_inverse();
+	bool time_matrix_covariance_update();
 
 	void reset();
 
@@ -108,6 +109,9 @@ private:
 	matrix::Matrix<float, 16, 6> A16;
 	matrix::Matrix<float, 6, 16> B16;
 	matrix::Matrix<float, 6, 16> B16_4;
+	matrix::SquareMatrix<float, 24> P24;
+	matrix::Vector<float, 24> K24;
+	matrix::Vector<float, 24> K24_sparse;
 };
 
 bool MicroBenchMatrix::run_tests()
@@ -116,6 +120,7 @@ bool MicroBenchMatrix::run_tests()
 	ut_run_test(time_matrix_quaternion);
 	ut_run_test(time_matrix_dcm);
 	ut_run_test(time_matrix_pseduo_inverse);
+	ut_run_test(time_matrix_covariance_update);
 
 	return (_tests_failed == 0);
 }
@@ -145,6 +150,33 @@ void MicroBenchMatrix::reset()
 			B16_4(j, i) = random(-10.0, 10.0);
 		}
 	}
+
+	for (size_t i = 0; i < 24; i++) {
+		for (size_t j = i; j < 24; j++) {
+			P24(i, j) = (i == j) ? random(1.0, 10.0) : random(-0.1, 0.1);
+			P24(j, i) = P24(i, j);
+		}
+
+		K24(i) = random(-1.0, 1.0);
+
+		// quaternion, velocity and position only (all bias, mag and wind states inhibited)
+		K24_sparse(i) = (i < 10) ? K24(i) : 0.f;
+	}
+}
+
+// reference: dense covariance correction P -= K * S * K^T as used by the EKF
+static void covariance_update_dense(matrix::SquareMatrix<float, 24> &P, const matrix::Vector<float, 24> &K, float S)
+{
+	const matrix::Vector<float, 24> KS = K * S;
+	matrix::SquareMatrix<float, 24> KHP;
+
+	for (unsigned row = 0; row < 24; row++) {
+		for (unsigned col = 0; col < 24; col++) {
+			KHP(row, col) = KS(row) * K(col);
+		}
+	}
+
+	P -= KHP;
 }
 
 bool MicroBenchMatrix::time_matrix_euler()
@@ -175,6 +207,15 @@ bool MicroBenchMatrix::time_matrix_pseduo_inverse()
 	return true;
 }
 
+bool MicroBenchMatrix::time_matrix_covariance_update()
+{
+	PERF("matrix 24x24 covariance update dense (all states)", covariance_update_dense(P24, K24, 0.5f), 100);
+	PERF("matrix 24x24 covariance update symmetric (all states)", P24.symmetricRankOneUpdate(K24, -0.5f), 100);
+	PERF("matrix 24x24 covariance update dense (10 states)", covariance_update_dense(P24, K24_sparse, 0.5f), 100);
+	PERF("matrix 24x24 covariance update symmetric (10 states)", P24.symmetricRankOneUpdate(K24_sparse, -0.5f), 100);
+	return true;
+}
+
 ut_declare_test_c(test_microbench_matrix, MicroBenchMatrix)
 
 } // namespace MicroBenchMatrix